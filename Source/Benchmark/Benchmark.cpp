@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    Benchmark.cpp
+    Created: 14 Oct 2026 6:22:40pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+// Every module the suites measure, seen together here so that two of them
+// declaring the same name fail to compile instead of breaking the one
+// definition rule across the suites' translation units.
+#include "../Modules/BiLinearCascade.h"
+#include "../Modules/Biquads.h"
+#include "../Modules/EnvelopeFollower.h"
+#include "../Modules/PeakCascade.h"
+#include "../Modules/SVF.h"
+
+namespace Benchmark
+{
+    void Report::add(const Result& result)
+    {
+        results.add(result);
+    }
+
+    juce::String Report::toCsv() const
+    {
+        juce::String csv("module,filterType,transformType,precision,blockSize,numChannels,nsPerSample,errorDecibels\n");
+
+        for (const auto& r : results)
+            csv << r.module << "," << r.filterType << "," << r.transformType << "," << r.precision << ","
+                << r.blockSize << "," << r.numChannels << "," << juce::String(r.nsPerSample, 4) << ","
+                << (r.errorDecibels.has_value() ? juce::String(*r.errorDecibels, 2) : juce::String()) << "\n";
+
+        return csv;
+    }
+
+    juce::String Report::toJson() const
+    {
+        juce::String json("[\n");
+
+        for (int i = 0; i < results.size(); ++i)
+        {
+            const auto& r = results.getReference(i);
+
+            json << "  { \"module\": \"" << r.module
+                 << "\", \"filterType\": \"" << r.filterType
+                 << "\", \"transformType\": \"" << r.transformType
+                 << "\", \"precision\": \"" << r.precision
+                 << "\", \"blockSize\": " << r.blockSize
+                 << ", \"numChannels\": " << r.numChannels
+                 << ", \"nsPerSample\": " << juce::String(r.nsPerSample, 4)
+                 << ", \"errorDecibels\": " << (r.errorDecibels.has_value() ? juce::String(*r.errorDecibels, 2) : juce::String("null"))
+                 << (i + 1 < results.size() ? " },\n" : " }\n");
+        }
+
+        return json << "]\n";
+    }
+}
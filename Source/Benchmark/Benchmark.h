@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: 14 Oct 2026 6:22:40pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef BENCHMARK_H_INCLUDED
+#define BENCHMARK_H_INCLUDED
+
+#include <functional>
+#include <optional>
+#include <JuceHeader.h>
+
+namespace Benchmark
+{
+    //==========================================================================
+    /** One measured configuration. nsPerSample is per sample per channel.
+    Suites that measure accuracy also give the RMS error of the output in
+    dBFS. */
+    struct Result
+    {
+        juce::String module, filterType, transformType, precision;
+        int blockSize = 0, numChannels = 0;
+        double nsPerSample = 0.0;
+        std::optional<double> errorDecibels {};
+    };
+
+    /** The grid of configurations every module is measured over. */
+    struct Settings
+    {
+        juce::Array<int> blockSizes { 16, 64, 256, 1024, 4096 };
+        juce::Array<int> channelCounts { 1, 2, 4, 8, 16, 32 };
+        juce::int64 samplesPerRun = 1 << 20;
+        double sampleRate = 48000.0;
+    };
+
+    //==========================================================================
+    /** Collects results and writes them out as CSV or JSON. */
+    class Report
+    {
+    public:
+        void add(const Result& result);
+
+        juce::String toCsv() const;
+        juce::String toJson() const;
+
+    private:
+        juce::Array<Result> results;
+    };
+
+    //==========================================================================
+    /** Returns "float" or "double". */
+    template <typename SampleType>
+    juce::String getPrecisionName()
+    {
+        return std::is_same<SampleType, double>::value ? "double" : "float";
+    }
+
+    /** Prepares the filter for the given block size and channel count, then
+    times it over Settings::samplesPerRun samples of noise. The input is kept
+    apart from the output so that repeated blocks never feed back into each
+    other. Returns nanoseconds per sample per channel. */
+    template <typename SampleType, typename Filter>
+    double measure(Filter& filter, const Settings& settings, int blockSize, int numChannels)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        juce::dsp::ProcessSpec spec { settings.sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+        filter.prepare(spec);
+
+        juce::AudioBuffer<SampleType> input(numChannels, blockSize), output(numChannels, blockSize);
+        juce::Random random(0x5eed);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(channel, i, static_cast<SampleType>(random.nextDouble() - 0.5));
+
+        const juce::dsp::AudioBlock<const SampleType> inputBlock(input);
+        juce::dsp::AudioBlock<SampleType> outputBlock(output);
+        juce::dsp::ProcessContextNonReplacing<SampleType> context(inputBlock, outputBlock);
+
+        const auto numBlocks = juce::jmax(static_cast<juce::int64>(1), settings.samplesPerRun / blockSize);
+
+        for (juce::int64 i = 0; i < numBlocks / 8 + 1; ++i)
+            filter.process(context);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (juce::int64 i = 0; i < numBlocks; ++i)
+            filter.process(context);
+
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        return seconds * 1.0e9 / (static_cast<double>(numBlocks) * blockSize * numChannels);
+    }
+
+    /** Runs its own copy of a filter over each channel as a mono block, so
+    every channel takes the scalar path. Measured next to the filter itself,
+    it shows what the SIMD lanes gain at each channel count. */
+    template <typename SampleType, typename Filter>
+    struct PerChannel
+    {
+        explicit PerChannel(std::function<void(Filter&)> setUpFilter) : setUp(std::move(setUpFilter)) {}
+
+        void prepare(juce::dsp::ProcessSpec& spec)
+        {
+            auto monoSpec = spec;
+            monoSpec.numChannels = 1;
+
+            filters.clear();
+
+            for (juce::uint32 channel = 0; channel < spec.numChannels; ++channel)
+            {
+                filters.push_back(std::make_unique<Filter>());
+                setUp(*filters.back());
+                filters.back()->prepare(monoSpec);
+            }
+        }
+
+        template <typename ProcessContext>
+        void process(const ProcessContext& context) noexcept
+        {
+            for (size_t channel = 0; channel < filters.size(); ++channel)
+            {
+                const auto inputBlock = context.getInputBlock().getSingleChannelBlock(channel);
+                auto outputBlock = context.getOutputBlock().getSingleChannelBlock(channel);
+
+                filters[channel]->process(juce::dsp::ProcessContextNonReplacing<SampleType>(inputBlock, outputBlock));
+            }
+        }
+
+        std::function<void(Filter&)> setUp;
+        std::vector<std::unique_ptr<Filter>> filters;
+    };
+
+    //==========================================================================
+    /** Per-module suites, one translation unit each. */
+    void runBiLinearFilters(const Settings& settings, Report& report);
+    void runBiquads(const Settings& settings, Report& report);
+    void runStateVariableTPTFilter(const Settings& settings, Report& report);
+    void runPeakCascade(const Settings& settings, Report& report);
+    void runDynamicShelves(const Settings& settings, Report& report);
+    void runPrecision(const Settings& settings, Report& report);
+}
+
+#endif //BENCHMARK_H_INCLUDED
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    BiLinearFiltersBenchmark.cpp
+    Created: 14 Oct 2026 6:22:40pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../Modules/BiLinearCascade.h"
+
+namespace
+{
+    const std::array<std::pair<FilterType, const char*>, 6> filterTypes
+    { {
+        { FilterType::lowPass, "lowPass" },
+        { FilterType::highPass, "highPass" },
+        { FilterType::lowShelf, "lowShelf" },
+        { FilterType::lowShelfC, "lowShelfC" },
+        { FilterType::highShelf, "highShelf" },
+        { FilterType::highShelfC, "highShelfC" }
+    } };
+
+    const std::array<std::pair<TransformationType, const char*>, 4> transformTypes
+    { {
+        { TransformationType::directFormI, "directFormI" },
+        { TransformationType::directFormII, "directFormII" },
+        { TransformationType::directFormItransposed, "directFormItransposed" },
+        { TransformationType::directFormIItransposed, "directFormIItransposed" }
+    } };
+
+    //==========================================================================
+    /** Sets up four bands as a typical mix setting, so no stage is neutral. */
+    template <typename SampleType>
+    void setUpBands(BiLinearFilters<SampleType>& hp, BiLinearFilters<SampleType>& ls, BiLinearFilters<SampleType>& hs, BiLinearFilters<SampleType>& lp)
+    {
+        hp.setFilterType(FilterType::highPass);
+        ls.setFilterType(FilterType::lowShelf);
+        hs.setFilterType(FilterType::highShelf);
+        lp.setFilterType(FilterType::lowPass);
+
+        hp.setFrequency(static_cast<SampleType>(40.0));
+        ls.setFrequency(static_cast<SampleType>(200.0));
+        ls.setGain(static_cast<SampleType>(3.0));
+        hs.setFrequency(static_cast<SampleType>(5000.0));
+        hs.setGain(static_cast<SampleType>(-3.0));
+        lp.setFrequency(static_cast<SampleType>(16000.0));
+    }
+
+    /** Output gain and wet proportion used by both four-band chains. */
+    constexpr double chainGain = 0.5, chainMix = 0.5;
+
+    /** The plugin's four-band cascade, prepared the same way ProcessWrapper does. */
+    template <typename SampleType>
+    struct Cascade
+    {
+        Cascade()
+        {
+            setUpBands(hp, ls, hs, lp);
+
+            cascade.setOutputGain(static_cast<SampleType>(chainGain));
+            cascade.setWetMixProportion(static_cast<SampleType>(chainMix));
+        }
+
+        void prepare(juce::dsp::ProcessSpec& spec)
+        {
+            for (auto* stage : { &hp, &ls, &hs, &lp })
+                stage->prepare(spec);
+
+            cascade.prepare(spec);
+        }
+
+        template <typename ProcessContext>
+        void process(const ProcessContext& context) noexcept { cascade.process(context); }
+
+        BiLinearFilters<SampleType> hp, ls, hs, lp;
+        BiLinearCascade<SampleType> cascade { { &hp, &ls, &hs, &lp } };
+    };
+
+    /** The chain the cascade replaced: the same four bands run one after
+    another, then a juce::dsp::Gain and a juce::dsp::DryWetMixer, each a
+    separate pass over the block. */
+    template <typename SampleType>
+    struct Sequential
+    {
+        Sequential()
+        {
+            setUpBands(hp, ls, hs, lp);
+
+            gain.setGainLinear(static_cast<SampleType>(chainGain));
+            gain.setRampDurationSeconds(0.05);
+            mixer.setWetMixProportion(static_cast<SampleType>(chainMix));
+        }
+
+        void prepare(juce::dsp::ProcessSpec& spec)
+        {
+            for (auto* stage : { &hp, &ls, &hs, &lp })
+                stage->prepare(spec);
+
+            gain.prepare(spec);
+            mixer.prepare(spec);
+        }
+
+        template <typename ProcessContext>
+        void process(const ProcessContext& context) noexcept
+        {
+            auto& outputBlock = context.getOutputBlock();
+
+            mixer.pushDrySamples(context.getInputBlock());
+
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(context.getInputBlock());
+
+            juce::dsp::ProcessContextReplacing<SampleType> replacing(outputBlock);
+
+            for (auto* stage : { &hp, &ls, &hs, &lp })
+                stage->process(replacing);
+
+            gain.process(replacing);
+            mixer.mixWetSamples(outputBlock);
+        }
+
+        BiLinearFilters<SampleType> hp, ls, hs, lp;
+        juce::dsp::Gain<SampleType> gain;
+        juce::dsp::DryWetMixer<SampleType> mixer;
+    };
+
+    //==========================================================================
+    template <typename SampleType>
+    void run(const Benchmark::Settings& settings, Benchmark::Report& report)
+    {
+        for (const auto& transform : transformTypes)
+        {
+            for (auto blockSize : settings.blockSizes)
+            {
+                for (auto numChannels : settings.channelCounts)
+                {
+                    for (const auto& type : filterTypes)
+                    {
+                        auto setUp = [&type, &transform](BiLinearFilters<SampleType>& filter)
+                        {
+                            filter.setFilterType(type.first);
+                            filter.setTransformType(transform.first);
+                            filter.setFrequency(static_cast<SampleType>(1000.0));
+                            filter.setGain(static_cast<SampleType>(6.0));
+                        };
+
+                        BiLinearFilters<SampleType> filter;
+                        setUp(filter);
+
+                        report.add({ "BiLinearFilters", type.second, transform.second, Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                     Benchmark::measure<SampleType>(filter, settings, blockSize, numChannels) });
+
+                        // The same channels one at a time, through the scalar path.
+                        if (numChannels > 1)
+                        {
+                            Benchmark::PerChannel<SampleType, BiLinearFilters<SampleType>> perChannel(setUp);
+
+                            report.add({ "BiLinearFiltersScalar", type.second, transform.second, Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                         Benchmark::measure<SampleType>(perChannel, settings, blockSize, numChannels) });
+                        }
+                    }
+
+                    // The same bands, gain and mix, fused and then one pass
+                    // at a time, so the two rows compare directly.
+                    Cascade<SampleType> cascade;
+                    cascade.cascade.setTransformType(transform.first);
+
+                    report.add({ "BiLinearCascade", "fourBand", transform.second, Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                 Benchmark::measure<SampleType>(cascade, settings, blockSize, numChannels) });
+
+                    if (numChannels > 1)
+                    {
+                        Benchmark::PerChannel<SampleType, Cascade<SampleType>> perChannel([&transform](Cascade<SampleType>& c) { c.cascade.setTransformType(transform.first); });
+
+                        report.add({ "BiLinearCascadeScalar", "fourBand", transform.second, Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                     Benchmark::measure<SampleType>(perChannel, settings, blockSize, numChannels) });
+                    }
+
+                    Sequential<SampleType> sequential;
+
+                    for (auto* stage : { &sequential.hp, &sequential.ls, &sequential.hs, &sequential.lp })
+                        stage->setTransformType(transform.first);
+
+                    report.add({ "SequentialChain", "fourBand", transform.second, Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                 Benchmark::measure<SampleType>(sequential, settings, blockSize, numChannels) });
+                }
+            }
+        }
+    }
+}
+
+void Benchmark::runBiLinearFilters(const Settings& settings, Report& report)
+{
+    run<float>(settings, report);
+    run<double>(settings, report);
+}
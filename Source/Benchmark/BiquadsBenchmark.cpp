@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    BiquadsBenchmark.cpp
+    Created: 14 Oct 2026 6:22:40pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../Modules/Biquads.h"
+
+namespace
+{
+    const std::array<std::pair<BiquadType, const char*>, 15> filterTypes
+    { {
+        { BiquadType::lowPass2, "lowPass2" },
+        { BiquadType::lowPass1, "lowPass1" },
+        { BiquadType::highPass2, "highPass2" },
+        { BiquadType::highPass1, "highPass1" },
+        { BiquadType::bandPass, "bandPass" },
+        { BiquadType::bandPassQ, "bandPassQ" },
+        { BiquadType::lowShelf2, "lowShelf2" },
+        { BiquadType::lowShelf1, "lowShelf1" },
+        { BiquadType::lowShelf1C, "lowShelf1C" },
+        { BiquadType::highShelf2, "highShelf2" },
+        { BiquadType::highShelf1, "highShelf1" },
+        { BiquadType::highShelf1C, "highShelf1C" },
+        { BiquadType::peak, "peak" },
+        { BiquadType::notch, "notch" },
+        { BiquadType::allPass, "allPass" }
+    } };
+
+    const std::array<std::pair<TransformationType, const char*>, 4> transformTypes
+    { {
+        { TransformationType::directFormI, "directFormI" },
+        { TransformationType::directFormII, "directFormII" },
+        { TransformationType::directFormItransposed, "directFormItransposed" },
+        { TransformationType::directFormIItransposed, "directFormIItransposed" }
+    } };
+
+    //==========================================================================
+    template <typename SampleType>
+    void run(const Benchmark::Settings& settings, Benchmark::Report& report)
+    {
+        for (const auto& transform : transformTypes)
+        {
+            for (auto blockSize : settings.blockSizes)
+            {
+                for (auto numChannels : settings.channelCounts)
+                {
+                    for (const auto& type : filterTypes)
+                    {
+                        auto setUp = [&type, &transform](Biquads<SampleType>& filter)
+                        {
+                            filter.setFilterType(type.first);
+                            filter.setTransformType(transform.first);
+                            filter.setFrequency(static_cast<SampleType>(1000.0));
+                            filter.setResonance(static_cast<SampleType>(0.5));
+                            filter.setGain(static_cast<SampleType>(6.0));
+                        };
+
+                        Biquads<SampleType> filter;
+                        setUp(filter);
+
+                        report.add({ "Biquads", type.second, transform.second, Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                     Benchmark::measure<SampleType>(filter, settings, blockSize, numChannels) });
+
+                        // The same channels one at a time, through the scalar path.
+                        if (numChannels > 1)
+                        {
+                            Benchmark::PerChannel<SampleType, Biquads<SampleType>> perChannel(setUp);
+
+                            report.add({ "BiquadsScalar", type.second, transform.second, Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                         Benchmark::measure<SampleType>(perChannel, settings, blockSize, numChannels) });
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Benchmark::runBiquads(const Settings& settings, Report& report)
+{
+    run<float>(settings, report);
+    run<double>(settings, report);
+}
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    DynamicShelvesBenchmark.cpp
+    Created: 14 Oct 2026 11:48:20pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../Modules/BiLinearCascade.h"
+#include "../Modules/EnvelopeFollower.h"
+
+namespace
+{
+    //==========================================================================
+    /** A BiLinearCascade running a low and a high shelf, with the pass bands
+    bypassed, as the plugin runs them. When dynamic, both shelves follow
+    their own band through an EnvelopeFollower, ticking every interval
+    samples as the plugin's channel groups do, with the gain either held or
+    ramped linearly to the next tick. */
+    template <typename SampleType>
+    struct Shelves
+    {
+        Shelves(bool shouldBeDynamic, int newInterval, bool shouldInterpolate)
+            : isDynamic(shouldBeDynamic), interval(newInterval), isLinear(shouldInterpolate)
+        {
+            hpFilter.setFilterType(FilterType::highPass);
+            lsFilter.setFilterType(FilterType::lowShelf);
+            hsFilter.setFilterType(FilterType::highShelf);
+            lpFilter.setFilterType(FilterType::lowPass);
+
+            lsFilter.setFrequency(static_cast<SampleType>(200.0));
+            hsFilter.setFrequency(static_cast<SampleType>(5000.0));
+            lsFilter.setGain(static_cast<SampleType>(3.0));
+            hsFilter.setGain(static_cast<SampleType>(3.0));
+
+            cascade.setStageBypassed(0, true);
+            cascade.setStageBypassed(3, true);
+
+            lsFollower.setFilterType(FilterType::lowPass);
+            hsFollower.setFilterType(FilterType::highPass);
+            lsFollower.setFrequency(static_cast<SampleType>(200.0));
+            hsFollower.setFrequency(static_cast<SampleType>(5000.0));
+
+            for (auto* follower : { &lsFollower, &hsFollower })
+            {
+                follower->setAttack(static_cast<SampleType>(0.001));
+                follower->setRelease(static_cast<SampleType>(0.01));
+                follower->setInterval(interval);
+            }
+
+            cascade.setStageModulated(1, isDynamic);
+            cascade.setStageModulated(2, isDynamic);
+        }
+
+        void prepare(juce::dsp::ProcessSpec& spec)
+        {
+            for (auto* filter : { &hpFilter, &lsFilter, &hsFilter, &lpFilter })
+                filter->prepare(spec);
+
+            if (isDynamic)
+            {
+                const auto rampSeconds = isLinear ? static_cast<double>(interval) / spec.sampleRate : 0.0;
+
+                lsFilter.setRampDurationSeconds(rampSeconds);
+                hsFilter.setRampDurationSeconds(rampSeconds);
+            }
+
+            cascade.prepare(spec);
+            lsFollower.prepare(spec);
+            hsFollower.prepare(spec);
+        }
+
+        template <typename ProcessContext>
+        void process(const ProcessContext& context) noexcept
+        {
+            auto& outputBlock = context.getOutputBlock();
+
+            outputBlock.copyFrom(context.getInputBlock());
+
+            if (! isDynamic)
+            {
+                cascade.process(juce::dsp::ProcessContextReplacing<SampleType>(outputBlock));
+                return;
+            }
+
+            // The noise sits near -10 dBFS, so a -20 dB threshold keeps the
+            // gains moving on every tick.
+            const auto numSamples = outputBlock.getNumSamples();
+
+            for (size_t start = 0; start < numSamples;)
+            {
+                const auto span = juce::jmin(static_cast<size_t>(lsFollower.getSamplesToNextTick()), numSamples - start);
+                auto spanBlock = outputBlock.getSubBlock(start, span);
+
+                if (lsFollower.process(spanBlock))
+                    lsFilter.setGain(static_cast<SampleType>(3.0) + juce::jmax(static_cast<SampleType>(-12.0), static_cast<SampleType>(-20.0) - lsFollower.getLevelDecibels()));
+
+                if (hsFollower.process(spanBlock))
+                    hsFilter.setGain(static_cast<SampleType>(3.0) + juce::jmax(static_cast<SampleType>(-12.0), static_cast<SampleType>(-20.0) - hsFollower.getLevelDecibels()));
+
+                cascade.process(juce::dsp::ProcessContextReplacing<SampleType>(spanBlock));
+                start += span;
+            }
+        }
+
+        BiLinearFilters<SampleType> hpFilter, lsFilter, hsFilter, lpFilter;
+        BiLinearCascade<SampleType> cascade { { &hpFilter, &lsFilter, &hsFilter, &lpFilter } };
+        EnvelopeFollower<SampleType> lsFollower, hsFollower;
+
+        bool isDynamic = false;
+        int interval = 32;
+        bool isLinear = true;
+    };
+
+    //==========================================================================
+    template <typename SampleType>
+    void run(const Benchmark::Settings& settings, Benchmark::Report& report)
+    {
+        for (auto blockSize : settings.blockSizes)
+        {
+            for (auto numChannels : settings.channelCounts)
+            {
+                {
+                    Shelves<SampleType> shelves(false, 32, false);
+
+                    report.add({ "DynamicShelves", "Static", "directFormIItransposed", Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                 Benchmark::measure<SampleType>(shelves, settings, blockSize, numChannels) });
+                }
+
+                for (auto interval : { 8, 16, 32, 64 })
+                {
+                    for (auto isLinear : { false, true })
+                    {
+                        Shelves<SampleType> shelves(true, interval, isLinear);
+
+                        report.add({ "DynamicShelves", (isLinear ? "Linear" : "Hold") + juce::String(interval), "directFormIItransposed", Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                     Benchmark::measure<SampleType>(shelves, settings, blockSize, numChannels) });
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Benchmark::runDynamicShelves(const Settings& settings, Report& report)
+{
+    run<float>(settings, report);
+    run<double>(settings, report);
+}
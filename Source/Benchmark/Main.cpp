@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 14 Oct 2026 6:22:40pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+    Filter benchmarks for BiLinearEQ.
+
+    Usage:
+        BiLinearEQ-Benchmark [--format csv|json] [--output <file>] [--quick]
+                             [--module BiLinearFilters|Biquads|StateVariableTPTFilter|PeakCascade|DynamicShelves|Precision]
+
+  ==============================================================================
+*/
+
+#include <iostream>
+#include <JuceHeader.h>
+#include "Benchmark.h"
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.removeOptionIfFound("--help|-h"))
+    {
+        std::cout << "Usage: BiLinearEQ-Benchmark [--format csv|json] [--output <file>] [--quick]" << std::endl
+                  << "                            [--module BiLinearFilters|Biquads|StateVariableTPTFilter|PeakCascade|DynamicShelves|Precision]" << std::endl;
+        return 0;
+    }
+
+    const auto format = args.removeValueForOption("--format|-f");
+    const auto outputPath = args.removeValueForOption("--output|-o");
+    const auto module = args.removeValueForOption("--module|-m");
+
+    Benchmark::Settings settings;
+
+    if (args.removeOptionIfFound("--quick|-q"))
+        settings.samplesPerRun = 1 << 16;
+
+    if (format.isNotEmpty() && format != "csv" && format != "json")
+    {
+        std::cerr << "Unknown --format " << format << std::endl;
+        return 1;
+    }
+
+    //==========================================================================
+    Benchmark::Report report;
+
+    if (module.isEmpty() || module == "BiLinearFilters")
+        Benchmark::runBiLinearFilters(settings, report);
+
+    if (module.isEmpty() || module == "Biquads")
+        Benchmark::runBiquads(settings, report);
+
+    if (module.isEmpty() || module == "StateVariableTPTFilter")
+        Benchmark::runStateVariableTPTFilter(settings, report);
+
+    if (module.isEmpty() || module == "PeakCascade")
+        Benchmark::runPeakCascade(settings, report);
+
+    if (module.isEmpty() || module == "DynamicShelves")
+        Benchmark::runDynamicShelves(settings, report);
+
+    if (module.isEmpty() || module == "Precision")
+        Benchmark::runPrecision(settings, report);
+
+    const auto text = format == "json" ? report.toJson() : report.toCsv();
+
+    if (outputPath.isEmpty())
+    {
+        std::cout << text;
+        return 0;
+    }
+
+    const auto outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+
+    if (! outputFile.replaceWithText(text))
+    {
+        std::cerr << "Could not write " << outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
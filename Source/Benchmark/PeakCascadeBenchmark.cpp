@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    PeakCascadeBenchmark.cpp
+    Created: 14 Oct 2026 11:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../Modules/PeakCascade.h"
+
+namespace
+{
+    //==========================================================================
+    /** A PeakCascade with its first numBands bands at +6 dB, an octave apart
+    from 100 Hz. The cascade only processes in place, so the input is copied
+    to the output first. */
+    template <typename SampleType>
+    struct Peaks
+    {
+        Peaks(size_t numBands)
+        {
+            for (size_t band = 0; band < PeakCascade<SampleType>::maxBands; ++band)
+                peaks.setBand(band, static_cast<SampleType>(100 << band), static_cast<SampleType>(6.0), static_cast<SampleType>(1.0));
+
+            peaks.setNumBands(numBands);
+        }
+
+        void prepare(juce::dsp::ProcessSpec& spec) { peaks.prepare(spec); }
+
+        template <typename ProcessContext>
+        void process(const ProcessContext& context) noexcept
+        {
+            auto& outputBlock = context.getOutputBlock();
+
+            outputBlock.copyFrom(context.getInputBlock());
+            peaks.process(juce::dsp::ProcessContextReplacing<SampleType>(outputBlock));
+        }
+
+        PeakCascade<SampleType> peaks;
+    };
+
+    //==========================================================================
+    template <typename SampleType>
+    void run(const Benchmark::Settings& settings, Benchmark::Report& report)
+    {
+        for (auto blockSize : settings.blockSizes)
+        {
+            for (auto numChannels : settings.channelCounts)
+            {
+                for (size_t numBands = 0; numBands <= PeakCascade<SampleType>::maxBands; ++numBands)
+                {
+                    Peaks<SampleType> peaks(numBands);
+
+                    report.add({ "PeakCascade", juce::String(static_cast<int>(numBands)) + "Band", "directFormIItransposed", Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                 Benchmark::measure<SampleType>(peaks, settings, blockSize, numChannels) });
+                }
+            }
+        }
+    }
+}
+
+void Benchmark::runPeakCascade(const Settings& settings, Report& report)
+{
+    run<float>(settings, report);
+    run<double>(settings, report);
+}
@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    PrecisionBenchmark.cpp
+    Created: 14 Oct 2026 11:58:04pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../Modules/BiLinearCascade.h"
+
+namespace
+{
+    //==========================================================================
+    /** The plugin's four-band cascade where precision matters most: a high
+    pass and a +12 dB low shelf at 20 Hz, whose poles sit closest to 1,
+    ahead of a high shelf and a low pass. The stages and cascade run in
+    StateType, whatever the buffers hold. */
+    template <typename StateType>
+    struct Chain
+    {
+        Chain()
+        {
+            hp.setFilterType(FilterType::highPass);
+            ls.setFilterType(FilterType::lowShelf);
+            hs.setFilterType(FilterType::highShelf);
+            lp.setFilterType(FilterType::lowPass);
+
+            hp.setFrequency(static_cast<StateType>(20.0));
+            ls.setFrequency(static_cast<StateType>(20.0));
+            ls.setGain(static_cast<StateType>(12.0));
+            hs.setFrequency(static_cast<StateType>(8000.0));
+            hs.setGain(static_cast<StateType>(-6.0));
+            lp.setFrequency(static_cast<StateType>(20000.0));
+        }
+
+        void prepare(juce::dsp::ProcessSpec& spec)
+        {
+            for (auto* stage : { &hp, &ls, &hs, &lp })
+                stage->prepare(spec);
+
+            cascade.prepare(spec);
+        }
+
+        template <typename ProcessContext>
+        void process(const ProcessContext& context) noexcept { cascade.process(context); }
+
+        BiLinearFilters<StateType> hp, ls, hs, lp;
+        BiLinearCascade<StateType> cascade { { &hp, &ls, &hs, &lp } };
+    };
+
+    //==========================================================================
+    /** Runs Settings::samplesPerRun samples of stereo noise through the
+    chain, and returns the RMS difference from the same stages run in long
+    double as dBFS. The reference takes the double designs, so the float
+    chain's error includes its coarser coefficients; where long double is
+    no wider than double, the double chain measures as exact. */
+    template <typename SampleType, typename StateType>
+    double measureError(const Benchmark::Settings& settings)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        constexpr int blockSize = 512, numChannels = 2;
+        juce::dsp::ProcessSpec spec { settings.sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+
+        Chain<StateType> chain;
+        Chain<double> designs;
+        chain.prepare(spec);
+        designs.prepare(spec);
+
+        std::array<long double, BiLinearCascade<double>::numStages> b0, b1, a1;
+        std::array<std::array<long double, BiLinearCascade<double>::numStages>, numChannels> z {};
+        size_t stage = 0;
+
+        for (auto* filter : { &designs.hp, &designs.ls, &designs.hs, &designs.lp })
+        {
+            b0[stage] = filter->getb0(), b1[stage] = filter->getb1(), a1[stage] = filter->geta1();
+            ++stage;
+        }
+
+        juce::AudioBuffer<SampleType> input(numChannels, blockSize), output(numChannels, blockSize);
+        juce::Random random(0x5eed);
+        long double errorSquared = 0.0;
+
+        const auto numBlocks = juce::jmax(static_cast<juce::int64>(1), settings.samplesPerRun / blockSize);
+
+        for (juce::int64 block = 0; block < numBlocks; ++block)
+        {
+            // Float samples, so every mode starts from the same input.
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    input.setSample(channel, i, static_cast<SampleType>(static_cast<float>(random.nextDouble() - 0.5)));
+
+            const juce::dsp::AudioBlock<const SampleType> inputBlock(input);
+            juce::dsp::AudioBlock<SampleType> outputBlock(output);
+            chain.process(juce::dsp::ProcessContextNonReplacing<SampleType>(inputBlock, outputBlock));
+
+            for (size_t channel = 0; channel < static_cast<size_t>(numChannels); ++channel)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    auto Yn = static_cast<long double>(input.getSample(static_cast<int>(channel), i));
+
+                    for (size_t k = 0; k < b0.size(); ++k)
+                    {
+                        const auto Xn = Yn;
+
+                        Yn = (Xn * b0[k]) + z[channel][k];
+                        z[channel][k] = (Xn * b1[k]) + (Yn * a1[k]);
+                    }
+
+                    const auto error = static_cast<long double>(output.getSample(static_cast<int>(channel), i)) - Yn;
+                    errorSquared += error * error;
+                }
+            }
+        }
+
+        const auto meanSquare = static_cast<double>(errorSquared / static_cast<long double>(numBlocks * blockSize * numChannels));
+
+        return meanSquare > 0.0 ? 10.0 * std::log10(meanSquare) : -400.0;
+    }
+
+    //==========================================================================
+    /** Times and measures one mode: buffers in SampleType, stages in StateType. */
+    template <typename SampleType, typename StateType>
+    void run(const juce::String& precision, const Benchmark::Settings& settings, Benchmark::Report& report)
+    {
+        const auto error = measureError<SampleType, StateType>(settings);
+
+        for (auto blockSize : settings.blockSizes)
+        {
+            for (auto numChannels : settings.channelCounts)
+            {
+                Chain<StateType> chain;
+
+                Benchmark::Result result { "Precision", "fourBand", "directFormIItransposed", precision, blockSize, numChannels,
+                                           Benchmark::measure<SampleType>(chain, settings, blockSize, numChannels) };
+                result.errorDecibels = error;
+
+                report.add(result);
+            }
+        }
+    }
+}
+
+void Benchmark::runPrecision(const Settings& settings, Report& report)
+{
+    run<float, float>("float", settings, report);
+    run<float, double>("mixed", settings, report);
+    run<double, double>("double", settings, report);
+}
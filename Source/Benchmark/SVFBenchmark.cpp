@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    SVFBenchmark.cpp
+    Created: 14 Oct 2026 6:22:40pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "../Modules/SVF.h"
+
+namespace
+{
+    using Type = StateVariableTPTFilterType;
+
+    const std::array<std::pair<Type, const char*>, 11> filterTypes
+    { {
+        { Type::LP2, "LP2" },
+        { Type::LP1, "LP1" },
+        { Type::LP2n, "LP2n" },
+        { Type::HP2, "HP2" },
+        { Type::HP1, "HP1" },
+        { Type::HP2n, "HP2n" },
+        { Type::BP2, "BP2" },
+        { Type::BP2n, "BP2n" },
+        { Type::AP2, "AP2" },
+        { Type::N2, "N2" },
+        { Type::P2, "P2" }
+    } };
+
+    //==========================================================================
+    template <typename SampleType>
+    void run(const Benchmark::Settings& settings, Benchmark::Report& report)
+    {
+        for (auto blockSize : settings.blockSizes)
+        {
+            for (auto numChannels : settings.channelCounts)
+            {
+                for (const auto& type : filterTypes)
+                {
+                    StateVariableTPTFilter<SampleType> filter;
+                    filter.setType(type.first);
+                    filter.setCutoffFrequency(static_cast<SampleType>(1000.0));
+                    filter.setResonance(static_cast<SampleType>(0.70710678118654752440084436210485));
+
+                    // The TPT structure has no direct-form topology to choose.
+                    report.add({ "StateVariableTPTFilter", type.second, "tpt", Benchmark::getPrecisionName<SampleType>(), blockSize, numChannels,
+                                 Benchmark::measure<SampleType>(filter, settings, blockSize, numChannels) });
+                }
+            }
+        }
+    }
+}
+
+void Benchmark::runStateVariableTPTFilter(const Settings& settings, Report& report)
+{
+    run<float>(settings, report);
+    run<double>(settings, report);
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 14 Oct 2026 4:05:18pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+
+BatchRenderer::BatchRenderer(const Options& renderOptions) : options(renderOptions)
+{
+    jassert(options.blockSize > 0);
+
+    formatManager.registerBasicFormats();
+}
+
+//==============================================================================
+juce::Result BatchRenderer::render(const juce::File& inputFile)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(inputFile));
+
+    if (reader == nullptr)
+        return juce::Result::fail("Could not read " + inputFile.getFullPathName());
+
+    const auto numChannels = static_cast<int>(reader->numChannels);
+    const auto sampleRate = reader->sampleRate;
+    const auto bitsPerSample = reader->bitsPerSample > 16 ? (reader->bitsPerSample > 24 ? 32 : 24) : 16;
+
+    auto outputFile = options.outputDirectory.getChildFile(inputFile.getFileNameWithoutExtension() + ".wav");
+
+    if (outputFile == inputFile)
+        return juce::Result::fail("Refusing to overwrite " + inputFile.getFullPathName());
+
+    outputFile.deleteFile();
+
+    std::unique_ptr<juce::FileOutputStream> stream(outputFile.createOutputStream());
+
+    if (stream == nullptr)
+        return juce::Result::fail("Could not write " + outputFile.getFullPathName());
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), sampleRate, static_cast<unsigned int>(numChannels), bitsPerSample, reader->metadataValues, 0));
+
+    if (writer == nullptr)
+        return juce::Result::fail("Could not create a WAV writer for " + outputFile.getFullPathName());
+
+    // The writer owns the stream from here on.
+    stream.release();
+
+    //==========================================================================
+    /** Load the state before preparing, so the first block starts on the
+    stored settings rather than ramping towards them. */
+    processor.setProcessingPrecision(options.useDoublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                : juce::AudioProcessor::singlePrecision);
+    processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, options.blockSize);
+    processor.setParameterUpdateInterval(options.parameterUpdateInterval);
+    processor.setStateInformation(options.state.getData(), static_cast<int>(options.state.getSize()));
+    processor.prepareToPlay(sampleRate, options.blockSize);
+
+    // Run on past the end of the input by the reported latency, and drop
+    // that many samples from the start, so the output lines up with the input.
+    const auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+    const auto totalSamples = reader->lengthInSamples + latency;
+    auto samplesToSkip = latency;
+
+    auto result = juce::Result::ok();
+
+    for (juce::int64 position = 0; position < totalSamples; position += options.blockSize)
+    {
+        const auto numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(options.blockSize), totalSamples - position));
+        const auto numToRead = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(numSamples), reader->lengthInSamples - position));
+
+        floatBuffer.setSize(numChannels, numSamples, false, false, true);
+
+        if (numToRead < numSamples)
+            floatBuffer.clear();
+
+        if (numToRead > 0 && ! reader->read(&floatBuffer, 0, numToRead, position, true, true))
+        {
+            result = juce::Result::fail("Could not read " + inputFile.getFullPathName());
+            break;
+        }
+
+        processBlock();
+
+        const auto skip = static_cast<int>(juce::jmin(samplesToSkip, static_cast<juce::int64>(numSamples)));
+        samplesToSkip -= skip;
+
+        if (numSamples > skip && ! writer->writeFromAudioSampleBuffer(floatBuffer, skip, numSamples - skip))
+        {
+            result = juce::Result::fail("Could not write " + outputFile.getFullPathName());
+            break;
+        }
+    }
+
+    processor.releaseResources();
+
+    return result;
+}
+
+//==============================================================================
+void BatchRenderer::processBlock()
+{
+    if (options.useDoublePrecision)
+    {
+        doubleBuffer.makeCopyOf(floatBuffer, true);
+        processor.processBlock(doubleBuffer, midiMessages);
+        floatBuffer.makeCopyOf(doubleBuffer, true);
+    }
+
+    else
+    {
+        processor.processBlock(floatBuffer, midiMessages);
+    }
+
+    midiMessages.clear();
+}
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 14 Oct 2026 4:05:18pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef BATCHRENDERER_H_INCLUDED
+#define BATCHRENDERER_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/**
+    Renders audio files offline through a private BiLinearEQAudioProcessor.
+
+    Each renderer owns its own processor, so one renderer per worker thread
+    is enough to process files in parallel. Files are streamed in blocks of
+    Options::blockSize and written next to each other as WAV files in
+    Options::outputDirectory.
+*/
+
+class BatchRenderer
+{
+public:
+    struct Options
+    {
+        /** Processor state, as written by getStateInformation(). */
+        juce::MemoryBlock state;
+        juce::File outputDirectory;
+        int blockSize = 8192;
+        /** Samples between parameter updates within a block; 0 = per block. */
+        int parameterUpdateInterval = 32;
+        bool useDoublePrecision = false;
+    };
+
+    //==============================================================================
+    /** Constructor. Must be called on the message thread. */
+    BatchRenderer(const Options& renderOptions);
+
+    //==============================================================================
+    /** Renders one file, returning a failed Result describing any problem. */
+    juce::Result render(const juce::File& inputFile);
+
+private:
+    //==============================================================================
+    /** Processes floatBuffer in place at the configured precision. */
+    void processBlock();
+
+    //==============================================================================
+    const Options& options;
+
+    BiLinearEQAudioProcessor processor;
+    juce::AudioFormatManager formatManager;
+
+    juce::AudioBuffer<float> floatBuffer;
+    juce::AudioBuffer<double> doubleBuffer;
+    juce::MidiBuffer midiMessages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchRenderer)
+};
+
+#endif //BATCHRENDERER_H_INCLUDED
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 14 Oct 2026 4:05:18pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+    Offline batch renderer and headless processor check for BiLinearEQ.
+
+    Usage:
+        BiLinearEQ-CLI --state <preset> --output <folder> [--double]
+                       [--block <samples>] [--interval <samples>]
+                       [--threads <count>] <files...>
+
+        BiLinearEQ-CLI --check [--double] [--block <samples>]
+                       [--interval <samples>] [--blocks <count>]
+                       [--seed <number>] [--max-load <fraction>]
+
+  ==============================================================================
+*/
+
+#include <iostream>
+#include <JuceHeader.h>
+#include "BatchRenderer.h"
+#include "ProcessorCheck.h"
+
+//==============================================================================
+/** Pulls files from a shared list and renders them with its own processor. */
+class RenderThread : public juce::Thread
+{
+public:
+    RenderThread(const BatchRenderer::Options& options, const juce::Array<juce::File>& filesToRender,
+                 std::atomic<int>& nextFileIndex, std::atomic<int>& failureCount, juce::CriticalSection& logLock)
+        : juce::Thread("BiLinearEQ render"),
+          renderer(options),
+          files(filesToRender),
+          nextFile(nextFileIndex),
+          failures(failureCount),
+          lock(logLock)
+    {
+    }
+
+    void run() override
+    {
+        for (auto index = nextFile++; index < files.size() && ! threadShouldExit(); index = nextFile++)
+        {
+            const auto file = files[index];
+            const auto result = renderer.render(file);
+
+            const juce::ScopedLock sl(lock);
+
+            if (result.wasOk())
+            {
+                std::cout << "Rendered " << file.getFullPathName() << std::endl;
+            }
+
+            else
+            {
+                ++failures;
+                std::cerr << result.getErrorMessage() << std::endl;
+            }
+        }
+    }
+
+private:
+    BatchRenderer renderer;
+    const juce::Array<juce::File>& files;
+    std::atomic<int>& nextFile;
+    std::atomic<int>& failures;
+    juce::CriticalSection& lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderThread)
+};
+
+//==============================================================================
+static void printUsage()
+{
+    std::cout << "Usage: BiLinearEQ-CLI --state <preset> --output <folder> [--double]" << std::endl
+              << "                      [--block <samples>] [--interval <samples>]" << std::endl
+              << "                      [--threads <count>] <files...>" << std::endl
+              << std::endl
+              << "  --state    Preset saved by the plugin, as XML or binary plugin state." << std::endl
+              << "  --output   Folder the rendered WAV files are written to." << std::endl
+              << "  --double   Process in double precision." << std::endl
+              << "  --block    Samples per processing block (default 8192)." << std::endl
+              << "  --interval Samples between parameter updates, 0 for once per block (default 32)." << std::endl
+              << "  --threads  Number of files rendered in parallel (default: all cores)." << std::endl
+              << std::endl
+              << "       BiLinearEQ-CLI --check [--double] [--block <samples>]" << std::endl
+              << "                      [--interval <samples>] [--blocks <count>]" << std::endl
+              << "                      [--seed <number>] [--max-load <fraction>]" << std::endl
+              << std::endl
+              << "  --check    Run the processor through random automation and layouts, and" << std::endl
+              << "             against the reference response; exits with 1 on any failure." << std::endl
+              << "  --block    Largest block, in samples (default 512)." << std::endl
+              << "  --blocks   Blocks per layout (default 2000)." << std::endl
+              << "  --seed     Seed for the random automation (default 1)." << std::endl
+              << "  --max-load Fail if a block takes longer than this fraction of its duration." << std::endl;
+}
+
+/** Runs the ProcessorCheck and prints its report. */
+static int runCheck(juce::ArgumentList& args)
+{
+    ProcessorCheck::Options options;
+
+    const auto blockSize = args.removeValueForOption("--block|-b");
+    const auto interval = args.removeValueForOption("--interval|-i");
+    const auto blocks = args.removeValueForOption("--blocks");
+    const auto seed = args.removeValueForOption("--seed");
+    const auto maxLoad = args.removeValueForOption("--max-load");
+
+    options.useDoublePrecision = args.removeOptionIfFound("--double|-d");
+    options.blockSize = blockSize.isNotEmpty() ? blockSize.getIntValue() : options.blockSize;
+    options.parameterUpdateInterval = interval.isNotEmpty() ? interval.getIntValue() : options.parameterUpdateInterval;
+    options.blocksPerLayout = blocks.isNotEmpty() ? blocks.getIntValue() : options.blocksPerLayout;
+    options.seed = seed.isNotEmpty() ? seed.getLargeIntValue() : options.seed;
+    options.maxLoad = maxLoad.isNotEmpty() ? maxLoad.getDoubleValue() : options.maxLoad;
+
+    if (options.blockSize <= 0)
+    {
+        std::cerr << "--block must be a positive number of samples" << std::endl;
+        return 1;
+    }
+
+    ProcessorCheck check(options);
+    ProcessorCheck::Report report;
+
+    const auto result = check.run(report);
+
+    std::cout << "Blocks:           " << report.numBlocks << std::endl
+              << "Worst block:      " << report.worstBlockMicroseconds << " us, "
+              << report.worstLoad * 100.0 << "% of its duration" << std::endl
+              << "Mean load:        " << report.meanLoad * 100.0 << "%" << std::endl
+              << "Allocations:      " << report.numAllocations << " in " << report.numAllocatingBlocks << " blocks" << std::endl
+              << "Response error:   " << report.worstErrorDecibels << " dB" << std::endl;
+
+    if (result.failed())
+    {
+        std::cerr << result.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Passed" << std::endl;
+    return 0;
+}
+
+/** Reads a preset as plugin state. XML presets are wrapped the way older
+versions' getStateInformation() did, which setStateInformation() still
+reads; anything else, e.g. the binary state, is passed on as-is. */
+static bool loadState(const juce::File& file, juce::MemoryBlock& state)
+{
+    if (auto xml = juce::parseXML(file))
+    {
+        juce::AudioProcessor::copyXmlToBinary(*xml, state);
+        return true;
+    }
+
+    return file.loadFileAsData(state) && state.getSize() > 0;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.size() == 0 || args.removeOptionIfFound("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    if (args.removeOptionIfFound("--check|-c"))
+        return runCheck(args);
+
+    BatchRenderer::Options options;
+
+    const auto stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.removeValueForOption("--state|-s"));
+    const auto outputPath = args.removeValueForOption("--output|-o");
+    const auto blockSize = args.removeValueForOption("--block|-b");
+    const auto interval = args.removeValueForOption("--interval|-i");
+    const auto threads = args.removeValueForOption("--threads|-t");
+
+    options.useDoublePrecision = args.removeOptionIfFound("--double|-d");
+    options.blockSize = blockSize.isNotEmpty() ? blockSize.getIntValue() : options.blockSize;
+    options.parameterUpdateInterval = interval.isNotEmpty() ? interval.getIntValue() : options.parameterUpdateInterval;
+
+    if (! stateFile.existsAsFile() || ! loadState(stateFile, options.state))
+    {
+        std::cerr << "Could not load the preset given with --state" << std::endl;
+        return 1;
+    }
+
+    if (outputPath.isEmpty())
+    {
+        std::cerr << "No output folder given with --output" << std::endl;
+        return 1;
+    }
+
+    options.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+
+    if (options.outputDirectory.createDirectory().failed())
+    {
+        std::cerr << "Could not create " << options.outputDirectory.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if (options.blockSize <= 0)
+    {
+        std::cerr << "--block must be a positive number of samples" << std::endl;
+        return 1;
+    }
+
+    juce::Array<juce::File> files;
+
+    for (const auto& arg : args.arguments)
+        files.add(arg.resolveAsFile());
+
+    if (files.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    //==========================================================================
+    const auto numThreads = juce::jlimit(1, files.size(), threads.isNotEmpty() ? threads.getIntValue() : juce::SystemStats::getNumCpus());
+
+    std::atomic<int> nextFile { 0 }, failures { 0 };
+    juce::CriticalSection logLock;
+    juce::OwnedArray<RenderThread> workers;
+
+    for (int i = 0; i < numThreads; ++i)
+        workers.add(new RenderThread(options, files, nextFile, failures, logLock));
+
+    for (auto* worker : workers)
+        worker->startThread();
+
+    for (auto* worker : workers)
+        worker->waitForThreadToExit(-1);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,574 @@
+/*
+  ==============================================================================
+
+    ProcessorCheck.cpp
+    Created: 15 Oct 2026 12:42:51am
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "ProcessorCheck.h"
+#include "../ChainResponse.h"
+
+namespace
+{
+    /** Set around every processBlock() call, so only the audio thread's own
+    allocations are counted. */
+    thread_local bool isCountingAllocations = false;
+    std::atomic<juce::int64> allocationCount { 0 };
+
+    void countAllocation() noexcept
+    {
+        if (isCountingAllocations)
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+   #if JUCE_LINUX
+    /** glibc's malloc family is interposed below, and operator new goes
+    through it, so new needn't count as well. */
+    constexpr bool isMallocCounted = true;
+   #else
+    constexpr bool isMallocCounted = false;
+   #endif
+
+    void* allocateAligned(std::size_t size, std::size_t alignment) noexcept
+    {
+       #if JUCE_WINDOWS
+        return _aligned_malloc(size > 0 ? size : 1, alignment);
+       #else
+        void* memory = nullptr;
+        return posix_memalign(&memory, juce::jmax(alignment, sizeof(void*)), size > 0 ? size : 1) == 0 ? memory : nullptr;
+       #endif
+    }
+
+    void freeAligned(void* memory) noexcept
+    {
+       #if JUCE_WINDOWS
+        _aligned_free(memory);
+       #else
+        std::free(memory);
+       #endif
+    }
+
+    //==============================================================================
+    enum class FirstOrderType { highPass, lowShelf, highShelf, lowPass };
+
+    /** The original bilinear first-order bands, written out from their own
+    formulas rather than through FirstOrderDesign, at z1 = e^-jw. */
+    std::complex<double> getFirstOrderResponse(FirstOrderType type, double frequency, double gainDecibels, double sampleRate, std::complex<double> z1)
+    {
+        const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const auto gain = std::pow(10.0, gainDecibels / 20.0);
+        const auto pole = (1.0 - omega) / (1.0 + omega);
+        const auto denominator = 1.0 - (pole * z1);
+
+        switch (type)
+        {
+        case FirstOrderType::highPass:
+            return ((1.0 / (1.0 + omega)) * (1.0 - z1)) / denominator;
+
+        case FirstOrderType::lowShelf:
+        {
+            const auto k = (gain - 1.0) * omega / (1.0 + omega);
+            return ((1.0 + k) + ((k - pole) * z1)) / denominator;
+        }
+
+        case FirstOrderType::highShelf:
+        {
+            const auto k = (gain - 1.0) / (1.0 + omega);
+            return ((1.0 + k) - ((pole + k) * z1)) / denominator;
+        }
+
+        case FirstOrderType::lowPass:
+        default:
+            return ((omega / (1.0 + omega)) * (1.0 + z1)) / denominator;
+        }
+    }
+
+    /** The cookbook peaking EQ, with A = 10^(dB / 40), at z1 = e^-jw. */
+    std::complex<double> getPeakResponse(double frequency, double gainDecibels, double q, double sampleRate, std::complex<double> z1)
+    {
+        const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const auto alpha = std::sin(omega) / (2.0 * q);
+        const auto a = std::pow(10.0, gainDecibels / 40.0);
+        const auto cos2 = 2.0 * std::cos(omega);
+        const auto z2 = z1 * z1;
+
+        return ((1.0 + (alpha * a)) - (cos2 * z1) + ((1.0 - (alpha * a)) * z2))
+             / ((1.0 + (alpha / a)) - (cos2 * z1) + ((1.0 - (alpha / a)) * z2));
+    }
+}
+
+//==============================================================================
+#if JUCE_LINUX
+/** Replaced through glibc's own entry points, so juce::HeapBlock and
+anything else calling malloc on the audio thread is counted too. */
+extern "C"
+{
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t numElements, std::size_t size);
+    void* __libc_realloc(void* memory, std::size_t size);
+    void __libc_free(void* memory);
+
+    void* malloc(std::size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t numElements, std::size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_calloc(numElements, size);
+    }
+
+    void* realloc(void* memory, std::size_t size) noexcept
+    {
+        countAllocation();
+        return __libc_realloc(memory, size);
+    }
+
+    void free(void* memory) noexcept
+    {
+        __libc_free(memory);
+    }
+}
+#endif
+
+//==============================================================================
+/** Replaced for the whole program, so that the check can count them; the
+array and nothrow forms come through here too. */
+void* operator new(std::size_t size)
+{
+    if (! isMallocCounted)
+        countAllocation();
+
+    if (auto* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+/** The over-aligned forms, for alignas members and SIMD types. */
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    countAllocation();
+
+    if (auto* memory = allocateAligned(size, static_cast<std::size_t>(alignment)))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    freeAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(memory);
+}
+
+//==============================================================================
+ProcessorCheck::ProcessorCheck(const Options& checkOptions) : options(checkOptions), random(checkOptions.seed)
+{
+    jassert(options.blockSize > 0);
+
+    processor.setParameterUpdateInterval(options.parameterUpdateInterval);
+}
+
+//==============================================================================
+juce::Result ProcessorCheck::run(Report& report)
+{
+    report = Report();
+
+    processor.setProcessingPrecision(options.useDoublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                : juce::AudioProcessor::singlePrecision);
+
+    auto result = options.useDoublePrecision ? runStress<double>(report) : runStress<float>(report);
+
+    if (result.wasOk())
+        result = options.useDoublePrecision ? runResponses<double>(report) : runResponses<float>(report);
+
+    processor.releaseResources();
+
+    return result;
+}
+
+//==============================================================================
+template <typename SampleType>
+juce::Result ProcessorCheck::runStress(Report& report)
+{
+    const std::array<double, 6> sampleRates { { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 } };
+
+    // Past 32 channels too, where anything sized on the stack for a usual
+    // layout would spill onto the heap.
+    const std::array<juce::AudioChannelSet, 4> mainLayouts { { juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo(),
+                                                               juce::AudioChannelSet::discreteChannels(40), juce::AudioChannelSet::discreteChannels(64) } };
+    const std::array<juce::AudioChannelSet, 3> sidechainLayouts { { juce::AudioChannelSet::disabled(), juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo() } };
+
+    const auto& parameters = processor.getParameters();
+    juce::AudioBuffer<SampleType> buffer;
+    double totalLoad = 0.0;
+
+    for (int layout = 0; layout < options.numLayouts; ++layout)
+    {
+        const auto sampleRate = sampleRates[static_cast<size_t>(random.nextInt(static_cast<int>(sampleRates.size())))];
+        const auto& mainLayout = mainLayouts[static_cast<size_t>(random.nextInt(static_cast<int>(mainLayouts.size())))];
+        const auto& sidechainLayout = sidechainLayouts[static_cast<size_t>(random.nextInt(static_cast<int>(sidechainLayouts.size())))];
+
+        if (! prepare(mainLayout, sidechainLayout, sampleRate))
+            return juce::Result::fail("The processor refused the layout " + mainLayout.getDescription() + " with a " + sidechainLayout.getDescription() + " sidechain");
+
+        const auto numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        buffer.setSize(numChannels, options.blockSize);
+
+        for (int block = 0; block < options.blocksPerLayout; ++block)
+        {
+            // Bypass is switched on its own, less often, so the filters are
+            // heard most of the time; each time it goes on, an impulse has to
+            // come out at the latency reported.
+            if (random.nextInt(8) == 0)
+            {
+                const auto numChanges = 1 + random.nextInt(4);
+
+                for (int i = 0; i < numChanges; ++i)
+                {
+                    auto* parameter = parameters[random.nextInt(parameters.size())];
+
+                    if (parameter != processor.getBypassParameter())
+                        setParameter(*parameter, random.nextFloat());
+                }
+            }
+
+            if (random.nextInt(256) == 0)
+            {
+                auto* bypass = processor.getBypassParameter();
+                const auto engages = bypass->getValue() < 0.5f;
+
+                setParameter(*bypass, engages ? 1.0f : 0.0f);
+
+                if (engages)
+                {
+                    const auto result = checkBypassLatency<SampleType>(numChannels, sampleRate);
+
+                    if (result.failed())
+                        return juce::Result::fail(result.getErrorMessage() + " at " + juce::String(sampleRate) + " Hz, " + mainLayout.getDescription());
+                }
+            }
+
+            const auto numSamples = 1 + random.nextInt(options.blockSize);
+            buffer.setSize(numChannels, numSamples, false, false, true);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample(channel, i, static_cast<SampleType>(random.nextFloat() - 0.5f));
+
+            const auto allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            isCountingAllocations = true;
+            processor.processBlock(buffer, midiMessages);
+            isCountingAllocations = false;
+
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+            const auto allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            const auto load = seconds / (static_cast<double>(numSamples) / sampleRate);
+
+            midiMessages.clear();
+
+            // There is no message loop here, so the message thread's side of
+            // a block, e.g. preparing linear phase, is done between blocks.
+            processor.handlePendingUpdates();
+
+            ++report.numBlocks;
+            report.numAllocations += allocations;
+            report.numAllocatingBlocks += allocations > 0 ? 1 : 0;
+            report.worstLoad = juce::jmax(report.worstLoad, load);
+            report.worstBlockMicroseconds = juce::jmax(report.worstBlockMicroseconds, seconds * 1.0e6);
+            totalLoad += load;
+            report.meanLoad = totalLoad / static_cast<double>(report.numBlocks);
+
+            for (int channel = 0; channel < processor.getTotalNumOutputChannels(); ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    if (! std::isfinite(static_cast<double>(buffer.getSample(channel, i))))
+                        return juce::Result::fail("Non-finite output in block " + juce::String(report.numBlocks)
+                                                  + " at " + juce::String(sampleRate) + " Hz, " + mainLayout.getDescription());
+        }
+    }
+
+    if (report.numAllocations > 0)
+        return juce::Result::fail(juce::String(report.numAllocations) + " allocations on the audio thread in "
+                                  + juce::String(report.numAllocatingBlocks) + " of " + juce::String(report.numBlocks) + " blocks");
+
+    if (options.maxLoad > 0.0 && report.worstLoad > options.maxLoad)
+        return juce::Result::fail("The slowest block took " + juce::String(report.worstLoad * 100.0, 1) + "% of its duration");
+
+    return juce::Result::ok();
+}
+
+template <typename SampleType>
+juce::Result ProcessorCheck::checkBypassLatency(int numChannels, double sampleRate)
+{
+    const auto numInputs = processor.getMainBusNumInputChannels();
+    const auto numOutputs = processor.getMainBusNumOutputChannels();
+    juce::AudioBuffer<SampleType> buffer(numChannels, options.blockSize);
+    juce::AudioBuffer<double> output;
+
+    // Runs numSamples of noise, or of silence with an impulse at the start,
+    // through the processor, keeping the main outputs if given somewhere to.
+    const auto render = [this, &buffer, numChannels, numInputs](int numSamples, bool isNoise, juce::AudioBuffer<double>* destination)
+    {
+        for (int position = 0; position < numSamples; position += options.blockSize)
+        {
+            const auto numToDo = juce::jmin(options.blockSize, numSamples - position);
+
+            buffer.setSize(numChannels, numToDo, false, false, true);
+            buffer.clear();
+
+            if (isNoise)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                    for (int i = 0; i < numToDo; ++i)
+                        buffer.setSample(channel, i, static_cast<SampleType>(random.nextFloat() - 0.5f));
+            }
+
+            else if (destination != nullptr && position == 0)
+            {
+                for (int channel = 0; channel < numInputs; ++channel)
+                    buffer.setSample(channel, 0, static_cast<SampleType>(1.0));
+            }
+
+            processor.processBlock(buffer, midiMessages);
+            midiMessages.clear();
+            processor.handlePendingUpdates();
+
+            if (destination != nullptr)
+                for (int channel = 0; channel < destination->getNumChannels(); ++channel)
+                    for (int i = 0; i < numToDo; ++i)
+                        destination->setSample(channel, position + i, static_cast<double>(buffer.getSample(channel, i)));
+        }
+    };
+
+    // The wet mix ramps out, and in linear phase the designer needs real
+    // time to deliver the bypassed kernel before the convolver crossfades to
+    // it, so the processor settles on noise first, then on silence.
+    constexpr int tailSamples = 8192;
+
+    render(options.blockSize, true, nullptr);
+    juce::Thread::sleep(50);
+    render(juce::roundToInt(sampleRate * 0.25), true, nullptr);
+
+    const auto latency = processor.getLatencySamples();
+    const auto length = latency + tailSamples;
+
+    render(length, false, nullptr);
+
+    output.setSize(numOutputs, length);
+    render(length, false, &output);
+
+    // The delay is read from the phase at a frequency low enough not to wrap
+    // across the whole capture, which is also where the oversamplers take
+    // their latency from.
+    const auto omega = juce::MathConstants<double>::halfPi / static_cast<double>(length);
+
+    for (int channel = 0; channel < numOutputs; ++channel)
+    {
+        auto sum = std::complex<double>(0.0, 0.0);
+
+        for (int i = 0; i < length; ++i)
+            sum += output.getSample(channel, i) * std::polar(1.0, -omega * static_cast<double>(i));
+
+        const auto delay = -std::arg(sum) / omega;
+
+        if (std::abs(delay - static_cast<double>(latency)) > 0.5)
+            return juce::Result::fail("An impulse under bypass came out after " + juce::String(delay, 2)
+                                      + " samples on channel " + juce::String(channel + 1) + ", with " + juce::String(latency) + " reported");
+    }
+
+    return juce::Result::ok();
+}
+
+template <typename SampleType>
+juce::Result ProcessorCheck::runResponses(Report& report)
+{
+    // Long enough for a Q of 10 at 20 Hz to ring down to -100 dB at 48 kHz.
+    constexpr int fftOrder = 17, fftSize = 1 << fftOrder, numBins = (fftSize / 2) + 1;
+    constexpr double sampleRate = 48000.0;
+
+    juce::dsp::FFT fft(fftOrder);
+    std::vector<float> transform(static_cast<size_t>(2 * fftSize)), reference(static_cast<size_t>(numBins));
+    juce::AudioBuffer<SampleType> buffer;
+    ChainResponse response;
+
+    juce::StringArray bandIDs { "hpFrequencyID", "lsFrequencyID", "lsGainID", "hsFrequencyID", "hsGainID", "lpFrequencyID",
+                                "hpBypassID", "lsBypassID", "hsBypassID", "lpBypassID",
+                                "hpOrderID", "lsOrderID", "hsOrderID", "lpOrderID",
+                                "designID", "mixID", "peaksID" };
+
+    for (int i = 1; i <= 8; ++i)
+        for (auto suffix : { "FrequencyID", "GainID", "QID" })
+            bandIDs.add("peak" + juce::String(i) + suffix);
+
+    auto& apvts = processor.getAPVTS();
+
+    for (int trial = 0; trial < options.numResponses; ++trial)
+    {
+        // Every other trial holds the bands to first order and the original
+        // bilinear design, which the check works out for itself; the rest
+        // take any order and design, and are held to ChainResponse.
+        const auto isClosedForm = (trial % 2) == 0;
+
+        // Everything else at its default: minimum phase, no oversampling,
+        // dynamics or scenes, and the same bands on both channels.
+        for (auto* parameter : processor.getParameters())
+            setParameter(*parameter, parameter->getDefaultValue());
+
+        for (const auto& paramID : bandIDs)
+            if (auto* parameter = apvts.getParameter(paramID))
+                setParameter(*parameter, random.nextFloat());
+
+        if (isClosedForm)
+            for (auto paramID : { "hpOrderID", "lsOrderID", "hsOrderID", "lpOrderID", "designID" })
+                setParameter(*apvts.getParameter(paramID), 0.0f);
+
+        // The full output range would bury most curves below the floor.
+        if (auto* output = apvts.getParameter("outputID"))
+            setParameter(*output, output->convertTo0to1(static_cast<float>((random.nextDouble() * 24.0) - 12.0)));
+
+        if (! prepare(juce::AudioChannelSet::stereo(), juce::AudioChannelSet::disabled(), sampleRate))
+            return juce::Result::fail("The processor refused a stereo layout");
+
+        std::fill(transform.begin(), transform.end(), 0.0f);
+        buffer.setSize(2, options.blockSize);
+
+        for (int position = 0; position < fftSize; position += options.blockSize)
+        {
+            const auto numSamples = juce::jmin(options.blockSize, fftSize - position);
+
+            buffer.setSize(2, numSamples, false, false, true);
+            buffer.clear();
+
+            if (position == 0)
+            {
+                buffer.setSample(0, 0, static_cast<SampleType>(1.0));
+                buffer.setSample(1, 0, static_cast<SampleType>(1.0));
+            }
+
+            processor.processBlock(buffer, midiMessages);
+            midiMessages.clear();
+
+            for (int i = 0; i < numSamples; ++i)
+                transform[static_cast<size_t>(position + i)] = static_cast<float>(buffer.getSample(0, i));
+        }
+
+        fft.performFrequencyOnlyForwardTransform(transform.data(), true);
+
+        if (isClosedForm)
+        {
+            getClosedFormMagnitudes(sampleRate, fftSize, reference);
+        }
+
+        else
+        {
+            response.setValues(processor.getParameterSnapshot().getValues(), sampleRate);
+            response.getMagnitudes({ numBins, false, 0.0, juce::MathConstants<double>::pi }, reference.data());
+        }
+
+        for (int k = 0; k < numBins; ++k)
+        {
+            const auto frequency = static_cast<double>(k) * sampleRate / static_cast<double>(fftSize);
+
+            if (frequency < 20.0 || frequency > 20000.0 || reference[static_cast<size_t>(k)] < 0.001f)
+                continue;
+
+            const auto error = std::abs(juce::Decibels::gainToDecibels(static_cast<double>(transform[static_cast<size_t>(k)]), -200.0)
+                                        - juce::Decibels::gainToDecibels(static_cast<double>(reference[static_cast<size_t>(k)]), -200.0));
+
+            report.worstErrorDecibels = juce::jmax(report.worstErrorDecibels, error);
+
+            if (error > options.maxErrorDecibels)
+                return juce::Result::fail("Response " + juce::String(error, 3) + " dB off the reference at "
+                                          + juce::String(frequency, 1) + " Hz in response " + juce::String(trial + 1));
+        }
+    }
+
+    return juce::Result::ok();
+}
+
+void ProcessorCheck::getClosedFormMagnitudes(double sampleRate, int fftSize, std::vector<float>& magnitudes)
+{
+    auto& apvts = processor.getAPVTS();
+    const auto get = [&apvts](const juce::String& paramID) { return static_cast<double>(apvts.getRawParameterValue(paramID)->load()); };
+    const auto isOn = [&get](const juce::String& paramID) { return get(paramID) >= 0.5; };
+
+    const auto mix = get("mixID") * 0.01;
+    const auto outputGain = juce::Decibels::decibelsToGain(get("outputID"));
+    const auto numPeaks = juce::roundToInt(get("peaksID"));
+
+    for (size_t k = 0; k < magnitudes.size(); ++k)
+    {
+        const auto omega = juce::MathConstants<double>::twoPi * static_cast<double>(k) / static_cast<double>(fftSize);
+        const auto z1 = std::polar(1.0, -omega);
+        auto wet = std::complex<double>(outputGain, 0.0);
+
+        if (! isOn("hpBypassID"))
+            wet *= getFirstOrderResponse(FirstOrderType::highPass, get("hpFrequencyID"), 0.0, sampleRate, z1);
+
+        if (! isOn("lsBypassID"))
+            wet *= getFirstOrderResponse(FirstOrderType::lowShelf, get("lsFrequencyID"), get("lsGainID"), sampleRate, z1);
+
+        if (! isOn("hsBypassID"))
+            wet *= getFirstOrderResponse(FirstOrderType::highShelf, get("hsFrequencyID"), get("hsGainID"), sampleRate, z1);
+
+        if (! isOn("lpBypassID"))
+            wet *= getFirstOrderResponse(FirstOrderType::lowPass, get("lpFrequencyID"), 0.0, sampleRate, z1);
+
+        for (int i = 1; i <= numPeaks; ++i)
+        {
+            const auto prefix = "peak" + juce::String(i);
+            wet *= getPeakResponse(get(prefix + "FrequencyID"), get(prefix + "GainID"), get(prefix + "QID"), sampleRate, z1);
+        }
+
+        magnitudes[k] = static_cast<float>(std::abs((1.0 - mix) + (mix * wet)));
+    }
+}
+
+//==============================================================================
+bool ProcessorCheck::prepare(const juce::AudioChannelSet& mainLayout, const juce::AudioChannelSet& sidechainLayout, double sampleRate)
+{
+    processor.releaseResources();
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(mainLayout);
+    layout.inputBuses.add(sidechainLayout);
+    layout.outputBuses.add(mainLayout);
+
+    if (! processor.setBusesLayout(layout))
+        return false;
+
+    processor.setRateAndBufferSizeDetails(sampleRate, options.blockSize);
+    processor.prepareToPlay(sampleRate, options.blockSize);
+
+    return true;
+}
+
+void ProcessorCheck::setParameter(juce::AudioProcessorParameter& parameter, float newValue)
+{
+    parameter.beginChangeGesture();
+    parameter.setValueNotifyingHost(newValue);
+    parameter.endChangeGesture();
+}
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    ProcessorCheck.h
+    Created: 15 Oct 2026 12:42:51am
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PROCESSORCHECK_H_INCLUDED
+#define PROCESSORCHECK_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/**
+    Drives a private BiLinearEQAudioProcessor the way a host would, and
+    checks what comes out.
+
+    The stress pass re-prepares the processor Options::numLayouts times, each
+    time on a random sample rate from 44.1 to 192 kHz, main layout (mono,
+    stereo, 40 or 64 channels) and sidechain (off, mono or stereo), then runs
+    Options::blocksPerLayout blocks of noise of random length, automating
+    random parameters between them. Every block is timed against its own
+    real-time duration, its output checked for non-finite samples, and every
+    allocation on the calling thread while inside processBlock() counted:
+    operator new, aligned or not, and on Linux malloc, calloc and realloc
+    as well, e.g. by juce::HeapBlock. Bypass is switched now and then; each
+    time it goes on, an impulse has to come out of every main channel at the
+    latency the processor reports.
+
+    The response pass randomises only the bands, the mix and the output
+    gain, renders an impulse, and compares its magnitude between 20 Hz and
+    20 kHz with a reference, wherever that is above -60 dB. Every other
+    trial holds the bands to first order and the bilinear design, and the
+    reference is worked out here from the original closed-form bands and
+    the cookbook peak; the others take any order and design and are held to
+    ChainResponse.
+
+    A failure is any non-finite sample, any counted allocation, a misaligned
+    bypass, a response further than Options::maxErrorDecibels off, or a
+    block slower than Options::maxLoad times real time when that is above
+    zero.
+*/
+
+class ProcessorCheck
+{
+public:
+    struct Options
+    {
+        bool useDoublePrecision = false;
+        /** Largest block, and samples between parameter updates; 0 = per block. */
+        int blockSize = 512, parameterUpdateInterval = 32;
+        int numLayouts = 8, blocksPerLayout = 2000;
+        int numResponses = 16;
+        double maxErrorDecibels = 0.1, maxLoad = 0.0;
+        juce::int64 seed = 1;
+    };
+
+    struct Report
+    {
+        int numBlocks = 0, numAllocatingBlocks = 0;
+        juce::int64 numAllocations = 0;
+
+        /** Longest and mean block time, as a fraction of the block's duration. */
+        double worstLoad = 0.0, meanLoad = 0.0;
+        double worstBlockMicroseconds = 0.0;
+
+        /** Largest magnitude difference from the reference, in dB. */
+        double worstErrorDecibels = 0.0;
+    };
+
+    //==============================================================================
+    /** Constructor. Must be called on the message thread. */
+    ProcessorCheck(const Options& checkOptions);
+
+    //==============================================================================
+    /** Runs both passes on the calling thread, returning a failed Result
+    describing the first problem. The report is filled in either way. */
+    juce::Result run(Report& report);
+
+private:
+    //==============================================================================
+    template <typename SampleType>
+    juce::Result runStress(Report& report);
+
+    template <typename SampleType>
+    juce::Result runResponses(Report& report);
+
+    /** Lets the processor settle with bypass on, then checks where an
+    impulse comes out of each main channel. */
+    template <typename SampleType>
+    juce::Result checkBypassLatency(int numChannels, double sampleRate);
+
+    /** Fills magnitudes, one per bin of an fftSize FFT, from the current
+    parameters with the bands at first order and the bilinear design. */
+    void getClosedFormMagnitudes(double sampleRate, int fftSize, std::vector<float>& magnitudes);
+
+    /** Prepares for a layout the way hosts do: released, re-laid out, then
+    prepared again. */
+    bool prepare(const juce::AudioChannelSet& mainLayout, const juce::AudioChannelSet& sidechainLayout, double sampleRate);
+
+    /** Sets a parameter from its normalised value. */
+    void setParameter(juce::AudioProcessorParameter& parameter, float newValue);
+
+    //==============================================================================
+    const Options& options;
+
+    BiLinearEQAudioProcessor processor;
+    juce::MidiBuffer midiMessages;
+    juce::Random random;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessorCheck)
+};
+
+#endif //PROCESSORCHECK_H_INCLUDED
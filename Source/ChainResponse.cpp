@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    ChainResponse.cpp
+    Created: 14 Oct 2026 9:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "ChainResponse.h"
+
+ChainResponse::ChainResponse()
+{
+    hpFilter.setFilterType(FilterType::highPass);
+    lsFilter.setFilterType(FilterType::lowShelf);
+    hsFilter.setFilterType(FilterType::highShelf);
+    lpFilter.setFilterType(FilterType::lowPass);
+
+    hpBand.setFilterType(BiquadType::highPass2);
+    lsBand.setFilterType(BiquadType::lowShelf2);
+    hsBand.setFilterType(BiquadType::highShelf2);
+    lpBand.setFilterType(BiquadType::lowPass2);
+
+    // Settled responses only, so none of the copies needs to smooth.
+    for (auto* filter : { &hpFilter, &lsFilter, &hsFilter, &lpFilter })
+        filter->setRampDurationSeconds(0.0);
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+    {
+        band->setRampDurationSeconds(0.0);
+        band->setResonance(static_cast<double>(SecondOrderBand<double>::resonance));
+    }
+}
+
+//==============================================================================
+void ChainResponse::setValues(const ParameterSnapshot::Values& newValues, double newFilterRate)
+{
+    values = newValues;
+
+    if (newFilterRate != filterRate)
+    {
+        filterRate = newFilterRate;
+
+        juce::dsp::ProcessSpec spec { filterRate, 1, 1 };
+
+        for (auto* filter : { &hpFilter, &lsFilter, &hsFilter, &lpFilter })
+            filter->prepare(spec);
+
+        for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+            band->prepare(spec);
+    }
+
+    for (auto* filter : { &hpFilter, &lsFilter, &hsFilter, &lpFilter })
+        filter->setDesignType(static_cast<DesignType>(values.design));
+
+    hpFilter.setFrequency(values.hpFrequency);
+    lsFilter.setFrequency(values.lsFrequency);
+    lsFilter.setGain(values.lsGain);
+    hsFilter.setFrequency(values.hsFrequency);
+    hsFilter.setGain(values.hsGain);
+    lpFilter.setFrequency(values.lpFrequency);
+
+    hpBand.setFrequency(values.hpFrequency);
+    lsBand.setFrequency(values.lsFrequency);
+    lsBand.setGain(values.lsGain);
+    hsBand.setFrequency(values.hsFrequency);
+    hsBand.setGain(values.hsGain);
+    lpBand.setFrequency(values.lpFrequency);
+
+    // Snap every smoother to its target and redesign.
+    for (auto* filter : { &hpFilter, &lsFilter, &hsFilter, &lpFilter })
+        filter->reset(0.0);
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+        band->reset(0.0);
+
+    // Peaks at 0 dB are skipped by the audio path, and are identities here.
+    numPeaks = 0;
+
+    for (size_t i = 0; i < static_cast<size_t>(values.numPeaks); ++i)
+    {
+        if (std::abs(static_cast<double>(values.peakGain[i])) <= PeakCascade<double>::identityDecibels)
+            continue;
+
+        auto& peak = peaks[numPeaks];
+        auto& key = keys[4 + numPeaks];
+        ++numPeaks;
+
+        const auto frequency = juce::jmin(static_cast<double>(values.peakFrequency[i]), filterRate / 2.125);
+
+        PeakCascade<double>::design(filterRate, frequency, static_cast<double>(values.peakGain[i]), static_cast<double>(values.peakQ[i]),
+                                    peak[0], peak[1], peak[2], peak[3], peak[4]);
+
+        key = SharedCache::Key();
+        key.sampleRate = filterRate;
+        key.kind = SharedCache::BandKind::peak;
+        key.frequency = frequency;
+        key.gain = static_cast<double>(values.peakGain[i]);
+        key.q = static_cast<double>(values.peakQ[i]);
+    }
+
+    // The pass bands have no gain, so any gain shares their curves.
+    const std::array<bool, 4> bypassed { { values.hpBypass, values.lsBypass, values.hsBypass, values.lpBypass } };
+    const std::array<int, 4> orders { { values.hpOrder, values.lsOrder, values.hsOrder, values.lpOrder } };
+    const std::array<FilterType, 4> filterTypes { { FilterType::highPass, FilterType::lowShelf, FilterType::highShelf, FilterType::lowPass } };
+    const std::array<BiquadType, 4> biquadTypes { { BiquadType::highPass2, BiquadType::lowShelf2, BiquadType::highShelf2, BiquadType::lowPass2 } };
+    const std::array<float, 4> frequencies { { values.hpFrequency, values.lsFrequency, values.hsFrequency, values.lpFrequency } };
+    const std::array<float, 4> gains { { 0.0f, values.lsGain, values.hsGain, 0.0f } };
+
+    for (size_t band = 0; band < 4; ++band)
+    {
+        auto& key = keys[band];
+        key = SharedCache::Key();
+        key.sampleRate = filterRate;
+        key.frequency = static_cast<double>(frequencies[band]);
+        key.gain = static_cast<double>(gains[band]);
+
+        if (orders[band] > 0)
+        {
+            key.kind = SharedCache::BandKind::secondOrder;
+            key.type = static_cast<int>(biquadTypes[band]);
+        }
+        else
+        {
+            key.kind = SharedCache::BandKind::firstOrder;
+            key.type = static_cast<int>(filterTypes[band]);
+            key.design = values.design;
+        }
+
+        inUse[band] = ! (values.bypass || bypassed[band]);
+    }
+
+    for (size_t i = 0; i < PeakCascade<double>::maxBands; ++i)
+        inUse[4 + i] = ! values.bypass && i < numPeaks;
+}
+
+//==============================================================================
+std::complex<double> ChainResponse::getResponse(double omega) const noexcept
+{
+    if (values.bypass)
+        return { 1.0, 0.0 };
+
+    auto response = std::complex<double>(1.0, 0.0);
+
+    for (size_t band = 0; band < numCurves; ++band)
+        if (inUse[band])
+            response *= getBandResponse(band, omega);
+
+    const auto mix = static_cast<double>(values.mix);
+
+    return (1.0 - mix) + ((mix * static_cast<double>(values.outputGain)) * response);
+}
+
+std::complex<double> ChainResponse::getBandResponse(size_t band, double omega) const noexcept
+{
+    switch (band)
+    {
+        case 0: return values.hpOrder > 0 ? hpBand.getResponse(omega) : hpFilter.getResponse(omega);
+        case 1: return values.lsOrder > 0 ? lsBand.getResponse(omega) : lsFilter.getResponse(omega);
+        case 2: return values.hsOrder > 0 ? hsBand.getResponse(omega) : hsFilter.getResponse(omega);
+        case 3: return values.lpOrder > 0 ? lpBand.getResponse(omega) : lpFilter.getResponse(omega);
+        default: break;
+    }
+
+    const auto& peak = peaks[band - 4];
+    const auto z1 = std::polar(1.0, -omega);
+    const auto z2 = z1 * z1;
+
+    return (peak[0] + (peak[1] * z1) + (peak[2] * z2)) / (1.0 - (peak[3] * z1) - (peak[4] * z2));
+}
+
+double ChainResponse::getMagnitudeForFrequency(double frequency) const noexcept
+{
+    jassert(filterRate > 0.0);
+
+    return getMagnitude(juce::MathConstants<double>::twoPi * frequency / filterRate);
+}
+
+void ChainResponse::getMagnitudes(const SharedCache::Grid& grid, float* magnitudes)
+{
+    jassert(filterRate > 0.0 && grid.numPoints > 0);
+
+    const auto numPoints = static_cast<size_t>(grid.numPoints);
+
+    product.assign(numPoints, { 1.0f, 0.0f });
+
+    for (size_t band = 0; band < numCurves; ++band)
+    {
+        // Bands that are no longer heard let their curves go.
+        if (! inUse[band])
+        {
+            curves[band].reset();
+            continue;
+        }
+
+        auto key = keys[band];
+        key.grid = grid;
+
+        if (! curves[band].matches(key))
+            curves[band] = cache->getCurve(key, [this, band](double omega) { return getBandResponse(band, omega); });
+
+        const auto& curve = curves[band].getCurve();
+
+        for (size_t k = 0; k < numPoints; ++k)
+            product[k] *= curve[k];
+    }
+
+    if (values.bypass)
+    {
+        std::fill_n(magnitudes, numPoints, 1.0f);
+        return;
+    }
+
+    const auto mix = values.mix;
+    const auto wet = mix * values.outputGain;
+
+    for (size_t k = 0; k < numPoints; ++k)
+        magnitudes[k] = std::abs((1.0f - mix) + (wet * product[k]));
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ChainResponse.h
+    Created: 14 Oct 2026 9:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef CHAINRESPONSE_H_INCLUDED
+#define CHAINRESPONSE_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "ParameterSnapshot.h"
+#include "Modules/BiLinearFilters.h"
+#include "Modules/Biquads.h"
+#include "Modules/SecondOrderBand.h"
+#include "Modules/PeakCascade.h"
+#include "SharedCache.h"
+
+/**
+    Frequency response of the whole minimum-phase chain for a set of
+    parameter values.
+
+    Keeps its own double-precision copy of every band, designed from the
+    values exactly as the audio path designs its own, and evaluates each
+    band's b and a coefficients on the unit circle. Nothing here is shared
+    with the audio thread, so it can be used from any one thread at a time.
+
+    Whole grids are taken band by band from the SharedCache, so a band left
+    alone since the last grid, or designed the same way by another
+    instance, costs a multiply per point instead of an evaluation.
+*/
+
+class ChainResponse
+{
+public:
+    //==============================================================================
+    /** Constructor. */
+    ChainResponse();
+
+    //==============================================================================
+    /** Designs every band for the values at the given filter rate, i.e. the
+    host rate times the oversampling factor. */
+    void setValues(const ParameterSnapshot::Values& newValues, double newFilterRate);
+
+    /** Returns the complex response at omega radians per sample of the filter
+    rate, including every band at its chosen order, the dry/wet mix and the
+    output gain. */
+    std::complex<double> getResponse(double omega) const noexcept;
+
+    /** Returns the magnitude of getResponse(). */
+    double getMagnitude(double omega) const noexcept { return std::abs(getResponse(omega)); }
+
+    /** Returns the magnitude at a frequency in Hz. */
+    double getMagnitudeForFrequency(double frequency) const noexcept;
+
+    /** Writes the magnitude at every point of the grid, whose angular
+    frequencies are per sample of the filter rate. The curves of the bands in
+    use are held until they change. */
+    void getMagnitudes(const SharedCache::Grid& grid, float* magnitudes);
+
+    /** Returns the filter rate given to the last setValues(). */
+    double getFilterRate() const noexcept { return filterRate; }
+
+private:
+    //==============================================================================
+    /** The four first- or second-order bands, then the peaks in use. */
+    static constexpr size_t numCurves = 4 + PeakCascade<double>::maxBands;
+
+    /** Returns one band's response; see keys for the order. */
+    std::complex<double> getBandResponse(size_t band, double omega) const noexcept;
+
+    //==============================================================================
+    ParameterSnapshot::Values values;
+    double filterRate = 0.0;
+
+    BiLinearFilters<double> hpFilter, lsFilter, hsFilter, lpFilter;
+    Biquads<double> hpBand, lsBand, hsBand, lpBand;
+
+    /** b0, b1, b2, a1 and a2 of each peak band in use, a's negated. */
+    std::array<std::array<double, 5>, PeakCascade<double>::maxBands> peaks;
+    size_t numPeaks = 0;
+
+    /** What each band's curve is designed from, less the grid, and whether
+    the band is heard. */
+    std::array<SharedCache::Key, numCurves> keys;
+    std::array<bool, numCurves> inUse {};
+
+    /** The cache is held for as long as the curves taken from it. */
+    juce::SharedResourcePointer<SharedCache> cache;
+    std::array<SharedCache::Handle, numCurves> curves;
+    std::vector<std::complex<float>> product;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChainResponse)
+};
+
+#endif //CHAINRESPONSE_H_INCLUDED
@@ -146,17 +146,45 @@ AutoComponent::AutoComponent(juce::AudioProcessor& p, APVTS& apvts, Lambda& onVa
         }
     }
 
+    //==========================================================================
+    /** Apply local Look and Feel. */
+
+    for (auto* s : sliders)
+        s->slider.setLookAndFeel (lookAndfeel.getObject());
+
+    for (auto* b : boxes)
+        b->box.setLookAndFeel (lookAndfeel.getObject());
+
+    for (auto* b : buttons)
+        b->button.setLookAndFeel (lookAndfeel.getObject());
+
     setSize (getWidth(), getHeight());
 }
 
 //==============================================================================
 
 void AutoComponent::paint (juce::Graphics& g)
+{
+    //==========================================================================
+    /** The names only move when the layout does, so they are drawn once
+    in resized() and only copied here. */
+
+    g.drawImage (nameLayer, getLocalBounds().toFloat());
+}
+
+void AutoComponent::renderNames()
 {
     //==========================================================================
     /** Paint Slider/Box name. */
 
-    auto paintName = [this, &g] (juce::Component& comp, juce::String name)
+    const auto scale = juce::Component::getApproximateScaleFactorForComponent (this);
+
+    nameLayer = juce::Image (juce::Image::ARGB, juce::jmax (1, juce::roundToInt (getWidth() * scale)), juce::jmax (1, juce::roundToInt (getHeight() * scale)), true);
+
+    juce::Graphics g (nameLayer);
+    g.addTransform (juce::AffineTransform::scale (scale));
+
+    auto paintName = [&g] (juce::Component& comp, juce::String name)
     {
         const int height = 20;
         juce::Rectangle<int> nameBox (comp.getX(), comp.getY() - 30, comp.getWidth(), height);
@@ -170,23 +198,6 @@ void AutoComponent::paint (juce::Graphics& g)
 
     for (auto* b : boxes)
         paintName (b->box, b->box.getName());
-
-    //==========================================================================
-    /** Apply local Look and Feel. */
-
-    auto applyLookAndFeel = [this, &g] (juce::Component& comp)
-    {
-        comp.setLookAndFeel(&lookAndfeel);
-    };
-
-    for (auto* s : sliders)
-        applyLookAndFeel (s->slider);
-
-    for (auto* b : boxes)
-        applyLookAndFeel (b->box);
-
-    for (auto* b : buttons)
-        applyLookAndFeel(b->button);
 }
 
 //==============================================================================
@@ -207,21 +218,43 @@ void AutoComponent::resized()
     auto absCentreX = getWidth() / 3;
     auto absCentreY = getHeight() / 3;
 
+    //==========================================================================
+    /** Sliders wrap onto further rows once a row is full; the boxes follow
+    the last row, and wrap the same way. */
+
+    const int rowHeight = 110;
+    int y = juce::jmin (absCentreY, 70);
+
     for (auto* s : sliders)
     {
+        if (! first && x + 75 > width)
+        {
+            x = 20;
+            y += rowHeight;
+            first = true;
+        }
+
         int offset = first ? 0 : 10;
-        s->slider.setBounds (x - offset, absCentreY, 85, 80);
+        s->slider.setBounds (x - offset, y, 85, 80);
         x = s->slider.getRight();
         first = false;
     }
 
     x = 30;
+    y += 140;
     first = true;
 
     for (auto* b : boxes)
     {
+        if (! first && x + 75 > width)
+        {
+            x = 30;
+            y += 50;
+            first = true;
+        }
+
         int offset = first ? 0 : -5;
-        b->box.setBounds (x - offset, absCentreY + 140, 70, 20);
+        b->box.setBounds (x - offset, y, 70, 20);
         x = b->box.getRight();
         first = false;
     }
@@ -232,9 +265,11 @@ void AutoComponent::resized()
     for (auto* b : buttons)
     {
         int offset = first ? 0 : -5;
-        b->button.setBounds (x - offset, absCentreY - 70, 70, 20);
+        b->button.setBounds (x - offset, juce::jmin (absCentreY, 70) - 70, 70, 20);
         x = b->button.getRight();
         first = false;
     }
+
+    renderNames();
 }
 //==============================================================================
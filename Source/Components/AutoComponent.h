@@ -11,7 +11,7 @@
 #ifndef AUTOCOMPONENT_H_INCLUDED
 #define AUTOCOMPONENT_H_INCLUDED
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 /*
   ==============================================================================
@@ -89,11 +89,17 @@ private:
     //==========================================================================
     /** Instantiate members. */
     //Lambda& lambda;
-    AutoComponentLookAndFeel lookAndfeel;
+
+    /** One look and feel for every editor open in the process. */
+    juce::SharedResourcePointer<AutoComponentLookAndFeel> lookAndfeel;
     juce::OwnedArray<SliderWithAttachment> sliders;
     juce::OwnedArray<BoxWithAttachment> boxes;
     juce::OwnedArray<ButtonWithAttachment> buttons;
 
+    /** Names above each slider and box, drawn at the current layout. */
+    juce::Image nameLayer;
+    void renderNames();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutoComponent)
 };
 
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.cpp
+    Created: 14 Oct 2026 9:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "SpectrumDisplay.h"
+
+SpectrumDisplay::SpectrumDisplay(SpectrumAnalyser& a, ParameterSnapshot& s, SceneBank& b) : analyser(a), snapshot(s), sceneBank(b)
+{
+    setOpaque(true);
+}
+
+//==============================================================================
+void SpectrumDisplay::update()
+{
+    auto needsRepaint = false;
+
+    if (analyser.process())
+    {
+        updateSpectrumPath();
+        needsRepaint = true;
+    }
+
+    // The curve depends only on the parameters, the scenes, the rate the
+    // filters run at and the size, so it is left alone until one of them
+    // moves.
+    const auto version = snapshot.getVersion();
+    const auto sceneVersion = sceneBank.getVersion();
+    const auto sampleRate = analyser.getSampleRate();
+
+    if (version != curveVersion || sceneVersion != curveSceneVersion || sampleRate != curveRate || curveIsStale)
+    {
+        // With scenes enabled, show where the EQ is gliding to.
+        const auto live = snapshot.getValues();
+        const auto values = live.scenes ? sceneBank.getMorphed(live) : live;
+
+        curveVersion = version;
+        curveSceneVersion = sceneVersion;
+        curveRate = sampleRate;
+        curveIsStale = false;
+
+        const auto oversampling = ParameterSnapshot::Values::limitOversampling(values.oversampling, sampleRate);
+
+        updateCurve(values, sampleRate * static_cast<double>(1 << oversampling));
+        needsRepaint = true;
+    }
+
+    if (needsRepaint)
+        repaint();
+}
+
+void SpectrumDisplay::updateCurve(const ParameterSnapshot::Values& values, double filterRate)
+{
+    response.setValues(values, filterRate);
+
+    const auto height = static_cast<float>(getHeight());
+    const auto width = getWidth();
+
+    // One point per column, spaced as getFrequencyForX() spaces them.
+    const auto toOmega = juce::MathConstants<double>::twoPi / filterRate;
+    const SharedCache::Grid grid { width + 1, true, minimumFrequency * toOmega, maximumFrequency * toOmega };
+
+    curveMagnitudes.resize(static_cast<size_t>(width + 1));
+    response.getMagnitudes(grid, curveMagnitudes.data());
+
+    curvePath.clear();
+    curvePath.preallocateSpace(3 * (width + 1));
+
+    for (int x = 0; x <= width; ++x)
+    {
+        const auto magnitude = curveMagnitudes[static_cast<size_t>(x)];
+        const auto level = juce::jlimit(-curveRange, curveRange, juce::Decibels::gainToDecibels(magnitude, -curveRange));
+        const auto y = juce::jmap(level, curveRange, -curveRange, 0.0f, height);
+
+        if (x == 0)
+            curvePath.startNewSubPath(0.0f, y);
+        else
+            curvePath.lineTo(static_cast<float>(x), y);
+    }
+}
+
+void SpectrumDisplay::updateSpectrumPath()
+{
+    const auto& levels = analyser.getLevels();
+    const auto height = static_cast<float>(getHeight());
+    const auto width = static_cast<float>(getWidth());
+
+    spectrumPath.clear();
+    spectrumPath.startNewSubPath(0.0f, height);
+
+    // Bins below the display are skipped; above a few hundred Hz there are
+    // more bins than pixels, so the path is thinned to one point per pixel.
+    auto lastX = -1.0f;
+
+    for (int bin = 1; bin < SpectrumAnalyser::numBins; ++bin)
+    {
+        const auto frequency = analyser.getBinFrequency(bin);
+
+        if (frequency < minimumFrequency)
+            continue;
+
+        if (frequency > maximumFrequency)
+            break;
+
+        const auto x = getXForFrequency(frequency);
+
+        if (x - lastX < 1.0f)
+            continue;
+
+        const auto level = levels[static_cast<size_t>(bin)];
+        const auto y = juce::jmap(level, 0.0f, SpectrumAnalyser::minimumLevel, 0.0f, height);
+
+        spectrumPath.lineTo(x, y);
+        lastX = x;
+    }
+
+    spectrumPath.lineTo(width, height);
+    spectrumPath.closeSubPath();
+}
+
+//==============================================================================
+void SpectrumDisplay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    const auto height = static_cast<float>(getHeight());
+    const auto width = static_cast<float>(getWidth());
+
+    // Decades, and the 0 dB line of the curve.
+    g.setColour(juce::Colours::darkgrey);
+
+    for (auto frequency : { 100.0, 1000.0, 10000.0 })
+        g.drawVerticalLine(juce::roundToInt(getXForFrequency(frequency)), 0.0f, height);
+
+    g.drawHorizontalLine(getHeight() / 2, 0.0f, width);
+
+    g.setColour(juce::Colours::lightslategrey.withAlpha(0.6f));
+    g.fillPath(spectrumPath);
+
+    g.setColour(juce::Colours::hotpink);
+    g.strokePath(curvePath, juce::PathStrokeType(2.0f));
+
+    g.setColour(juce::Colours::lightgrey);
+    g.drawRect(getLocalBounds(), 1);
+}
+
+void SpectrumDisplay::resized()
+{
+    curveIsStale = true;
+    updateSpectrumPath();
+}
+
+//==============================================================================
+float SpectrumDisplay::getXForFrequency(double frequency) const noexcept
+{
+    const auto proportion = std::log(frequency / minimumFrequency) / std::log(maximumFrequency / minimumFrequency);
+
+    return static_cast<float>(proportion * static_cast<double>(getWidth()));
+}
+
+double SpectrumDisplay::getFrequencyForX(float x) const noexcept
+{
+    const auto proportion = static_cast<double>(x) / static_cast<double>(juce::jmax(1, getWidth()));
+
+    return minimumFrequency * std::pow(maximumFrequency / minimumFrequency, proportion);
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    SpectrumDisplay.h
+    Created: 14 Oct 2026 9:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SPECTRUMDISPLAY_H_INCLUDED
+#define SPECTRUMDISPLAY_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "../SpectrumAnalyser.h"
+#include "../ParameterSnapshot.h"
+#include "../ChainResponse.h"
+#include "../SceneBank.h"
+
+/**
+    Draws the analysed output spectrum with the EQ curve on top.
+
+    The curve is evaluated once per pixel column from the bands'
+    coefficients and cached; it is only evaluated again when the parameters,
+    the scenes, the sample rate or the size change, so an open editor costs next to
+    nothing while the controls are left alone. Even then, only the bands
+    that moved are evaluated; the rest come from the SharedCache, along with
+    any band another open editor already shows.
+*/
+
+class SpectrumDisplay : public juce::Component
+{
+public:
+    //==========================================================================
+    /** Constructor. */
+    SpectrumDisplay(SpectrumAnalyser& a, ParameterSnapshot& s, SceneBank& b);
+
+    //==========================================================================
+    /** Picks up new spectra and parameter changes; call from the editor's
+    timer. Repaints only if something changed. */
+    void update();
+
+    //==========================================================================
+    /** Component methods. */
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    /** Frequency range shown, and the range of the EQ curve around 0 dB. */
+    static constexpr double minimumFrequency = 20.0, maximumFrequency = 20000.0;
+    static constexpr float curveRange = 24.0f;
+
+private:
+    //==========================================================================
+    /** Returns the x position of a frequency, and the frequency at an x. */
+    float getXForFrequency(double frequency) const noexcept;
+    double getFrequencyForX(float x) const noexcept;
+
+    /** Evaluates the curve once per column for the latest parameters. */
+    void updateCurve(const ParameterSnapshot::Values& values, double filterRate);
+
+    /** Rebuilds the spectrum path from the analyser's levels. */
+    void updateSpectrumPath();
+
+    //==========================================================================
+    SpectrumAnalyser& analyser;
+    ParameterSnapshot& snapshot;
+    SceneBank& sceneBank;
+    ChainResponse response;
+
+    /** What the cached curve was evaluated for. */
+    juce::uint32 curveVersion { 0 }, curveSceneVersion { 0 };
+    double curveRate { 0.0 };
+    bool curveIsStale { true };
+
+    /** The curve's magnitude at each column. */
+    std::vector<float> curveMagnitudes;
+
+    juce::Path spectrumPath, curvePath;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumDisplay)
+};
+
+#endif //SPECTRUMDISPLAY_H_INCLUDED
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    LinearPhaseDesigner.cpp
+    Created: 14 Oct 2026 8:40:12pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseDesigner.h"
+
+template <typename SampleType>
+LinearPhaseDesigner<SampleType>::LinearPhaseDesigner(PartitionedConvolver<SampleType>& c) : juce::Thread("Linear Phase Designer"), convolver(c)
+{
+}
+
+template <typename SampleType>
+LinearPhaseDesigner<SampleType>::~LinearPhaseDesigner()
+{
+    stopDesigning();
+}
+
+//==============================================================================
+template <typename SampleType>
+void LinearPhaseDesigner<SampleType>::prepare(int maxKernelLength)
+{
+    stopDesigning();
+
+    // The grid is twice the kernel length, and the real-only FFT works in
+    // place on an array twice its own size.
+    spectrum.assign(static_cast<size_t>(4 * maxKernelLength), 0.0f);
+    kernel.assign(static_cast<size_t>(maxKernelLength), 0.0f);
+    magnitudes.assign(static_cast<size_t>(maxKernelLength + 1), 0.0f);
+    window.reserve(static_cast<size_t>(maxKernelLength));
+}
+
+template <typename SampleType>
+void LinearPhaseDesigner<SampleType>::startDesigning()
+{
+    startThread();
+}
+
+template <typename SampleType>
+void LinearPhaseDesigner<SampleType>::stopDesigning()
+{
+    stopThread(1000);
+}
+
+//==============================================================================
+template <typename SampleType>
+void LinearPhaseDesigner<SampleType>::run()
+{
+    while (! threadShouldExit())
+    {
+        if (requests.hasFresh())
+            design(requests.acquire());
+
+        // A notify() from a publish or a stop while designing is kept, so
+        // nothing published in the meantime is missed.
+        wait(-1);
+    }
+}
+
+template <typename SampleType>
+void LinearPhaseDesigner<SampleType>::design(const Request& request)
+{
+    const auto length = request.length;
+    const auto gridSize = 2 * length;
+
+    jassert(length > 0 && (length & (length - 1)) == 0);
+    jassert(static_cast<size_t>(2 * gridSize) <= spectrum.size());
+
+    if (fft == nullptr || fft->getSize() != gridSize)
+    {
+        int order = 0;
+
+        while ((1 << order) < gridSize)
+            ++order;
+
+        fft = std::make_unique<juce::dsp::FFT>(order);
+    }
+
+    // A periodic Blackman window of the kernel length is zero at n = 0 and
+    // symmetric about length / 2, where the impulse is centred.
+    if (window.size() != static_cast<size_t>(length))
+    {
+        window.resize(static_cast<size_t>(length));
+
+        for (int n = 0; n < length; ++n)
+        {
+            const auto phase = juce::MathConstants<double>::twoPi * static_cast<double>(n) / static_cast<double>(length);
+            window[static_cast<size_t>(n)] = static_cast<float>(0.42 - (0.5 * std::cos(phase)) + (0.08 * std::cos(2.0 * phase)));
+        }
+    }
+
+    response.setValues(request.values, request.filterRate);
+
+    // Zero-phase magnitude on the grid, in the layout the inverse expects.
+    const auto binToOmega = (juce::MathConstants<double>::twoPi / static_cast<double>(gridSize)) * (request.sampleRate / request.filterRate);
+
+    const SharedCache::Grid grid { length + 1, false, 0.0, static_cast<double>(length) * binToOmega };
+
+    response.getMagnitudes(grid, magnitudes.data());
+
+    for (int k = 0; k <= length; ++k)
+    {
+        spectrum[static_cast<size_t>(2 * k)] = magnitudes[static_cast<size_t>(k)];
+        spectrum[static_cast<size_t>((2 * k) + 1)] = 0.0f;
+    }
+
+    fft->performRealOnlyInverseTransform(spectrum.data());
+
+    // The zero-phase response is centred on 0 and wraps around the grid;
+    // move its centre to length / 2 and window it down to the kernel.
+    for (int n = 0; n < length; ++n)
+    {
+        const auto source = ((n - (length / 2)) + gridSize) % gridSize;
+        kernel[static_cast<size_t>(n)] = spectrum[static_cast<size_t>(source)] * window[static_cast<size_t>(n)];
+    }
+
+    convolver.setKernel(kernel.data(), length, request.partitionSize, length / 2);
+}
+
+//==============================================================================
+template class LinearPhaseDesigner<float>;
+template class LinearPhaseDesigner<double>;
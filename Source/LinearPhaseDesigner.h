@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    LinearPhaseDesigner.h
+    Created: 14 Oct 2026 8:40:12pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef LINEARPHASEDESIGNER_H_INCLUDED
+#define LINEARPHASEDESIGNER_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "ParameterSnapshot.h"
+#include "ChainResponse.h"
+#include "Modules/PartitionedConvolver.h"
+#include "Modules/TripleBuffer.h"
+
+/**
+    Designs linear-phase FIR kernels for a PartitionedConvolver on a
+    background thread.
+
+    The audio thread fills in a Request whenever the parameters change and
+    publishes it without waiting, waking the designer; it takes the newest
+    one, evaluates the magnitude of the whole minimum-phase chain (every band at
+    its chosen order, the dry/wet mix and the output gain) on a frequency
+    grid twice the kernel length, and turns it into a windowed, symmetric
+    impulse response centred on half the kernel length. The kernel is handed
+    to the convolver, which swaps it in at its next partition. Each band's
+    part of the grid comes from the SharedCache, so only the bands that
+    moved are evaluated again, and instances with the same bands at the same
+    rates and length evaluate them once between them.
+
+    The bands are designed at the rate the minimum-phase path would run them
+    at with the current oversampling factor, so the two modes match in
+    magnitude; the FIR itself always runs at the host rate.
+*/
+
+template <typename SampleType>
+class LinearPhaseDesigner : private juce::Thread
+{
+public:
+    struct Request
+    {
+        ParameterSnapshot::Values values;
+
+        /** Host rate, and the rate the minimum-phase filters run at. */
+        double sampleRate = 44100.0, filterRate = 44100.0;
+
+        /** Kernel length and convolver partition size, both powers of two. */
+        int length = 0, partitionSize = 0;
+    };
+
+    //==============================================================================
+    /** Constructor. */
+    LinearPhaseDesigner(PartitionedConvolver<SampleType>& c);
+
+    /** Destructor. Stops the thread. */
+    ~LinearPhaseDesigner() override;
+
+    //==============================================================================
+    /** Allocates space for kernels up to maxKernelLength. Stops the thread. */
+    void prepare(int maxKernelLength);
+
+    /** Starts or stops designing published requests in the background. The
+    thread sleeps until a request is published. */
+    void startDesigning();
+    void stopDesigning();
+
+    /** Returns true while the background thread is running. */
+    bool isDesigning() const noexcept { return isThreadRunning(); }
+
+    //==============================================================================
+    /** Audio thread only. Returns the request to fill in before publishRequest(). */
+    Request& getRequest() noexcept { return requests.getWriteSlot(); }
+
+    /** Audio thread only. Hands the filled-in request to the designer. */
+    void publishRequest() noexcept
+    {
+        requests.publish();
+        notify();
+    }
+
+    /** Designs a kernel for the request and hands it to the convolver
+    straight away. Only while the thread is stopped. */
+    void design(const Request& request);
+
+private:
+    //==============================================================================
+    void run() override;
+
+    //==============================================================================
+    PartitionedConvolver<SampleType>& convolver;
+    TripleBuffer<Request> requests;
+
+    /** The minimum-phase chain the kernel's magnitude is taken from. */
+    ChainResponse response;
+
+    /** FFT of twice the kernel length, recreated when the length changes. */
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> spectrum, kernel, window, magnitudes;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LinearPhaseDesigner)
+};
+
+#endif //LINEARPHASEDESIGNER_H_INCLUDED
@@ -0,0 +1,379 @@
+/*
+  ==============================================================================
+
+    BiLinearCascade.cpp
+    Created: 14 Oct 2026 10:12:31am
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "BiLinearCascade.h"
+
+template <typename SampleType>
+BiLinearCascade<SampleType>::BiLinearCascade(const Stages& newStages) : stages(newStages)
+{
+    jassert(std::find(stages.begin(), stages.end(), nullptr) == stages.end());
+
+    bypassed.fill(false);
+    skipped.fill(false);
+    modulated.fill(false);
+    fade.fill(static_cast<SampleType>(1.0));
+    tailSamples.fill(0.0);
+
+    loadCoefficients(1);
+    update();
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void BiLinearCascade<SampleType>::setOutputGain(SampleType newGainLinear)
+{
+    gain = newGainLinear;
+    update();
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::setWetMixProportion(SampleType newWetMixProportion)
+{
+    jassert(static_cast<SampleType>(0.0) <= newWetMixProportion && newWetMixProportion <= static_cast<SampleType>(1.0));
+
+    mix = juce::jlimit(static_cast<SampleType>(0.0), static_cast<SampleType>(1.0), newWetMixProportion);
+    update();
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::setTransformType(TransformationType newTransformType)
+{
+    if (transformType != newTransformType)
+    {
+        transformType = newTransformType;
+        numRegisters = getFirstOrderRegisters(transformType);
+        std::fill(state.begin(), state.end(), static_cast<SampleType>(0.0));
+    }
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::setStageBypassed(size_t stage, bool shouldBeBypassed) noexcept
+{
+    jassert(stage < numStages);
+
+    bypassed[stage] = shouldBeBypassed;
+}
+
+template <typename SampleType>
+bool BiLinearCascade<SampleType>::isStageActive(size_t stage) const noexcept
+{
+    jassert(stage < numStages);
+
+    return ! skipped[stage];
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::setStageModulated(size_t stage, bool isModulated) noexcept
+{
+    jassert(stage < numStages);
+
+    modulated[stage] = isModulated;
+}
+
+//==============================================================================
+template <typename SampleType>
+void BiLinearCascade<SampleType>::setRampDurationSeconds(double newDurationSeconds) noexcept
+{
+    if (rampDurationSeconds != newDurationSeconds)
+    {
+        rampDurationSeconds = newDurationSeconds;
+
+        Smoothing::retime(dry, sampleRate, rampDurationSeconds);
+        Smoothing::retime(wet, sampleRate, rampDurationSeconds);
+
+        fadeIncrement = static_cast<SampleType>(1.0 / juce::jmax(1.0, rampDurationSeconds * sampleRate));
+    }
+}
+
+template <typename SampleType>
+double BiLinearCascade<SampleType>::getRampDurationSeconds() const noexcept
+{
+    return rampDurationSeconds;
+}
+
+//==============================================================================
+template <typename SampleType>
+void BiLinearCascade<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    maxChunk = juce::jmax(static_cast<size_t>(spec.maximumBlockSize), static_cast<size_t>(1));
+
+    numStateChannels = static_cast<size_t>(spec.numChannels);
+    numRegisters = getFirstOrderRegisters(transformType);
+    state.resize(numStateChannels * numStages * maxFirstOrderRegisters);
+    dryGains.resize(maxChunk);
+    wetGains.resize(maxChunk);
+
+    reset();
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+
+    // The ring-outs still to run are kept in time rather than in samples.
+    const auto ratio = newSampleRate / sampleRate;
+
+    for (auto& tail : tailSamples)
+        tail *= ratio;
+
+    sampleRate = newSampleRate;
+
+    Smoothing::retime(dry, sampleRate, rampDurationSeconds);
+    Smoothing::retime(wet, sampleRate, rampDurationSeconds);
+
+    fadeIncrement = static_cast<SampleType>(1.0 / juce::jmax(1.0, rampDurationSeconds * sampleRate));
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::reset()
+{
+    std::fill(state.begin(), state.end(), static_cast<SampleType>(0.0));
+
+    dry.reset(sampleRate, rampDurationSeconds);
+    wet.reset(sampleRate, rampDurationSeconds);
+
+    fadeIncrement = static_cast<SampleType>(1.0 / juce::jmax(1.0, rampDurationSeconds * sampleRate));
+
+    // Start on the current settings rather than fading towards them; the
+    // state was just cleared, so neutral stages can be skipped straight away.
+    for (size_t stage = 0; stage < numStages; ++stage)
+    {
+        fade[stage] = getFadeTarget(stage);
+        skipped[stage] = fade[stage] == static_cast<SampleType>(0.0);
+        tailSamples[stage] = 0.0;
+    }
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::snapToZero() noexcept
+{
+    // Only the registers the topology uses.
+    for (size_t i = 0; i < numStateChannels * numStages * numRegisters; ++i)
+        juce::dsp::util::snapToZero(state[i]);
+}
+
+template <typename SampleType>
+bool BiLinearCascade<SampleType>::hasDecayed() const noexcept
+{
+    // The same threshold juce::dsp::util::snapToZero() flushes below.
+    const auto threshold = static_cast<SampleType>(1.0e-8);
+
+    for (size_t i = 0; i < numStateChannels * numStages * numRegisters; ++i)
+        if (state[i] < -threshold || state[i] > threshold)
+            return false;
+
+    return true;
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::skip(int numSamples) noexcept
+{
+    for (auto* stage : stages)
+        stage->advanceSmoothing(numSamples);
+
+    dry.skip(numSamples);
+    wet.skip(numSamples);
+}
+
+template <typename SampleType>
+double BiLinearCascade<SampleType>::getTailSamples() const noexcept
+{
+    // The stages ring out one after another, so their decays add up.
+    double tail = 0.0;
+
+    for (size_t stage = 0; stage < numStages; ++stage)
+        if (! skipped[stage])
+            tail += stages[stage]->getDecaySamples(static_cast<SampleType>(decayLevel));
+
+    return tail;
+}
+
+//==============================================================================
+template <typename SampleType>
+bool BiLinearCascade<SampleType>::isRamping() const noexcept
+{
+    for (size_t stage = 0; stage < numStages; ++stage)
+        if (stages[stage]->isSmoothing() || fade[stage] != getFadeTarget(stage))
+            return true;
+
+    return false;
+}
+
+template <typename SampleType>
+SampleType BiLinearCascade<SampleType>::getFadeTarget(size_t stage) const noexcept
+{
+    const auto& filter = *stages[stage];
+    const auto isNeutral = ! modulated[stage] && ! filter.isSmoothing() && filter.isIdentity(static_cast<SampleType>(identityTolerance));
+
+    return (bypassed[stage] || isNeutral) ? static_cast<SampleType>(0.0) : static_cast<SampleType>(1.0);
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::getFadedCoefficients(size_t stage, SampleType fadeAmount, SampleType& b_0, SampleType& b_1, SampleType& a_1) const noexcept
+{
+    const auto& filter = *stages[stage];
+    const auto one = static_cast<SampleType>(1.0);
+
+    // Only the zero moves, so the blend is as stable as the designed pole.
+    a_1 = filter.geta1();
+    b_0 = one + ((filter.getb0() - one) * fadeAmount);
+    b_1 = (filter.getb1() + a_1) * fadeAmount - a_1;
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::clearStage(size_t stage) noexcept
+{
+    for (size_t channel = 0; channel < numStateChannels; ++channel)
+        for (size_t i = 0; i < numRegisters; ++i)
+            state[(channel * numStages + stage) * numRegisters + i] = static_cast<SampleType>(0.0);
+}
+
+template <typename SampleType>
+bool BiLinearCascade<SampleType>::loadCoefficients(size_t numSamples) noexcept
+{
+    const auto zero = static_cast<SampleType>(0.0);
+    const auto scale = static_cast<SampleType>(1.0) / static_cast<SampleType>(juce::jmax(numSamples, static_cast<size_t>(1)));
+    const auto step = fadeIncrement * static_cast<SampleType>(numSamples);
+    bool ramping = false;
+
+    std::array<bool, numStages> changing {};
+    std::array<SampleType, numStages> endFade {};
+
+    for (size_t stage = 0; stage < numStages; ++stage)
+    {
+        const auto target = getFadeTarget(stage);
+
+        incb0[stage] = incb1[stage] = inca1[stage] = zero;
+
+        if (skipped[stage])
+        {
+            if (target == zero)
+                continue;
+
+            // The state was cleared when the stage was skipped, so it
+            // restarts as an exact identity and fades in from there.
+            skipped[stage] = false;
+        }
+
+        const auto startFade = fade[stage];
+        endFade[stage] = target > startFade ? juce::jmin(target, startFade + step) : juce::jmax(target, startFade - step);
+        changing[stage] = stages[stage]->isSmoothing() || startFade != endFade[stage];
+
+        getFadedCoefficients(stage, startFade, b0[stage], b1[stage], a1[stage]);
+    }
+
+    advanceStages(numSamples);
+
+    numActiveStages = 0;
+
+    for (size_t stage = 0; stage < numStages; ++stage)
+    {
+        if (skipped[stage])
+            continue;
+
+        if (changing[stage])
+        {
+            SampleType endb0, endb1, enda1;
+            getFadedCoefficients(stage, endFade[stage], endb0, endb1, enda1);
+
+            incb0[stage] = (endb0 - b0[stage]) * scale;
+            incb1[stage] = (endb1 - b1[stage]) * scale;
+            inca1[stage] = (enda1 - a1[stage]) * scale;
+
+            fade[stage] = endFade[stage];
+            tailSamples[stage] = stages[stage]->getDecaySamples(static_cast<SampleType>(decayLevel));
+            ramping = true;
+        }
+
+        // Resting at identity: let whatever the pole still holds ring out
+        // before dropping the stage, so skipping it is inaudible.
+        else if (fade[stage] == zero)
+        {
+            tailSamples[stage] -= static_cast<double>(numSamples);
+
+            if (tailSamples[stage] <= 0.0)
+            {
+                skipped[stage] = true;
+                clearStage(stage);
+                continue;
+            }
+        }
+
+        activeStages[numActiveStages++] = stage;
+    }
+
+    return ramping;
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::advanceStages(size_t numSamples) noexcept
+{
+    std::array<bool, numStages> smoothing {};
+    bool anySmoothing = false, sameDesign = true;
+
+    for (size_t stage = 0; stage < numStages; ++stage)
+    {
+        smoothing[stage] = stages[stage]->isSmoothing();
+        anySmoothing = anySmoothing || smoothing[stage];
+        sameDesign = sameDesign && stages[stage]->getDesignType() == stages[0]->getDesignType()
+                              && ! stages[stage]->isChangingDesign();
+    }
+
+    if (! anySmoothing)
+        return;
+
+    // Stages with differing design modes, or crossfading between two,
+    // can't share a batch.
+    if (! sameDesign)
+    {
+        for (auto* stage : stages)
+            stage->advanceSmoothing(static_cast<int>(numSamples));
+
+        return;
+    }
+
+    // Designing every band is cheaper than picking out the smoothing ones,
+    // and keeps the batch free of branches.
+    for (size_t stage = 0; stage < numStages; ++stage)
+    {
+        auto& filter = *stages[stage];
+
+        if (smoothing[stage])
+            filter.skipSmoothing(static_cast<int>(numSamples));
+
+        designer.omega[stage] = filter.getOmega();
+        designer.gainDecibels[stage] = filter.getGainDecibels();
+        designer.setPrototype(stage, filter.getPrototype());
+    }
+
+    designer.design(stages[0]->getDesignType());
+
+    for (size_t stage = 0; stage < numStages; ++stage)
+        if (smoothing[stage])
+            stages[stage]->setCoefficients(designer.b0[stage], designer.b1[stage], designer.a1[stage]);
+}
+
+template <typename SampleType>
+void BiLinearCascade<SampleType>::update()
+{
+    dry.setTargetValue(static_cast<SampleType>(1.0) - mix);
+    wet.setTargetValue(mix * gain);
+}
+
+//==============================================================================
+template class BiLinearCascade<float>;
+template class BiLinearCascade<double>;
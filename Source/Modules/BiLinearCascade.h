@@ -0,0 +1,501 @@
+/*
+  ==============================================================================
+
+    BiLinearCascade.h
+    Created: 14 Oct 2026 10:12:31am
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef BILINEARCASCADE_H_INCLUDED
+#define BILINEARCASCADE_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "BiLinearFilters.h"
+
+/**
+    A fused cascade of BiLinearFilters stages.
+
+    The stages only act as coefficient designers here; the cascade runs every
+    stage, the output gain and the dry/wet mix in one pass per channel, with
+    each stage's unit-delay held in a local for the duration of the channel.
+
+    Stages that are bypassed, or whose coefficients are an identity, are
+    crossfaded out by ramping their zero onto their pole, and are skipped
+    entirely once their remaining impulse response has decayed. They fade in
+    again from silent state when they become active.
+
+    The buffers need not be in the cascade's own precision: a double cascade
+    runs float buffers with its state and coefficients in double, converting
+    each sample as it is loaded and stored.
+*/
+
+template <typename SampleType>
+class BiLinearCascade
+{
+public:
+    static constexpr size_t numStages = 4;
+    using Stages = std::array<BiLinearFilters<SampleType>*, numStages>;
+    //==============================================================================
+    /** Constructor. */
+    BiLinearCascade(const Stages& newStages);
+
+    //==============================================================================
+    /** Sets the linear gain applied to the wet signal. */
+    void setOutputGain(SampleType newGainLinear);
+
+    /** Sets the proportion of wet signal in the output. Range = 0..1 */
+    void setWetMixProportion(SampleType newWetMixProportion);
+
+    /** Sets the BiLinear Transform for every stage to use. See enum for available types. */
+    void setTransformType(TransformationType newTransformType);
+
+    /** Bypasses one stage. The stage is faded out over the ramp duration and
+    then skipped; it keeps following its parameters meanwhile. */
+    void setStageBypassed(size_t stage, bool shouldBeBypassed) noexcept;
+
+    /** Returns true while the stage is part of the processing, including
+    while it fades out or its tail decays. */
+    bool isStageActive(size_t stage) const noexcept;
+
+    /** Keeps a stage in the chain while its coefficients are an identity,
+    so a stage whose gain moves at the control rate is heard at once rather
+    than faded in after every pass through 0 dB. Bypass still fades it out. */
+    void setStageModulated(size_t stage, bool isModulated) noexcept;
+
+    //==============================================================================
+    /** Sets the length of the ramp used for smoothing gain and mix changes. */
+    void setRampDurationSeconds(double newDurationSeconds) noexcept;
+
+    /** Returns the ramp duration in seconds. */
+    double getRampDurationSeconds() const noexcept;
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Moves the cascade's mix, gain and stage fades to a new sample rate
+    without clearing the state; the stages are moved separately. */
+    void setSampleRate(double newSampleRate) noexcept;
+
+    /** Resets the internal state variables of the processor. */
+    void reset();
+
+    /** Ensure that the state variables are rounded to zero if the state
+    variables are denormals. */
+    void snapToZero() noexcept;
+
+    /** Returns true once every unit-delay has decayed to the level that
+    snapToZero() would flush, so silent input will give silent output. */
+    bool hasDecayed() const noexcept;
+
+    /** Advances the stages and the gain ramps by numSamples without processing
+    any audio, as a bypassed block does. */
+    void skip(int numSamples) noexcept;
+
+    /** Returns how many samples the active stages take to ring out to -120 dB
+    after the input stops, from their current pole positions. */
+    double getTailSamples() const noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing
+    context, which may hold float or double samples. */
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        process(context, context.getInputBlock());
+    }
+
+    /** Processes the context as above, but mixes dryBlock back in as the dry
+    signal instead of the context's input, for when the wet path has already
+    been through other processing. */
+    template <typename ProcessContext, typename DryBlock>
+    void process(const ProcessContext& context, const DryBlock& dryBlock) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto len = inputBlock.getNumSamples();
+
+        jassert(inputBlock.getNumChannels() == numChannels);
+        jassert(inputBlock.getNumSamples() == numSamples);
+        jassert(dryBlock.getNumChannels() == numChannels);
+        jassert(dryBlock.getNumSamples() == numSamples);
+        jassert(numChannels <= numStateChannels);
+        juce::ignoreUnused(numChannels, numSamples);
+
+        if (context.isBypassed)
+        {
+            skip(static_cast<int> (len));
+
+            outputBlock.copyFrom(dryBlock);
+            return;
+        }
+
+        switch (transformType)
+        {
+        case TransformationType::directFormI:
+            processBlock<TransformationType::directFormI>(inputBlock, dryBlock, outputBlock);
+            break;
+        case TransformationType::directFormII:
+            processBlock<TransformationType::directFormII>(inputBlock, dryBlock, outputBlock);
+            break;
+        case TransformationType::directFormItransposed:
+            processBlock<TransformationType::directFormItransposed>(inputBlock, dryBlock, outputBlock);
+            break;
+        case TransformationType::directFormIItransposed:
+            processBlock<TransformationType::directFormIItransposed>(inputBlock, dryBlock, outputBlock);
+            break;
+        default:
+            processBlock<TransformationType::directFormIItransposed>(inputBlock, dryBlock, outputBlock);
+        }
+    }
+
+    double sampleRate = 44100.0, rampDurationSeconds = 0.05;
+
+    /** Number of samples between coefficient designs while any stage is smoothing. */
+    static constexpr size_t rampInterval = BiLinearFilters<SampleType>::rampInterval;
+
+private:
+    //==============================================================================
+    /** Returns true if any stage is still interpolating its parameters or
+    fading in or out. */
+    bool isRamping() const noexcept;
+
+    /** Returns 1 if the stage should be heard, or 0 if it is bypassed or its
+    coefficients are an identity. */
+    SampleType getFadeTarget(size_t stage) const noexcept;
+
+    /** Returns the stage's coefficients blended from an identity, with its
+    zero cancelling its pole, towards its designed response. */
+    void getFadedCoefficients(size_t stage, SampleType fadeAmount, SampleType& b_0, SampleType& b_1, SampleType& a_1) const noexcept;
+
+    /** Zeroes the unit-delays of one stage on every channel. */
+    void clearStage(size_t stage) noexcept;
+
+    /** Advances every smoothing stage by numSamples and redesigns them
+    together with a FirstOrderBatch. */
+    void advanceStages(size_t numSamples) noexcept;
+
+    /** Copies the current coefficients of every stage into the cascade. Stages
+    that are still smoothing or fading are advanced by numSamples, and the
+    per-sample increments towards their new coefficients are stored. Also
+    rebuilds the list of active stages. Returns true if any stage is ramping
+    over the next numSamples. */
+    bool loadCoefficients(size_t numSamples) noexcept;
+
+    /** Processes a whole block with a fixed transformation. */
+    template <TransformationType Type, typename InputBlock, typename DryBlock, typename OutputBlock>
+    void processBlock(const InputBlock& inputBlock, const DryBlock& dryBlock, OutputBlock& outputBlock) noexcept
+    {
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto hasSeparateDry = dryBlock.getChannelPointer(0) != inputBlock.getChannelPointer(0);
+
+        for (size_t start = 0; start < numSamples;)
+        {
+            auto chunk = juce::jmin(maxChunk, numSamples - start);
+
+            if (isRamping())
+                chunk = juce::jmin(rampInterval, chunk);
+
+            const auto ramping = loadCoefficients(chunk);
+            const auto smoothing = dry.isSmoothing() || wet.isSmoothing();
+
+            if (numActiveStages == 0 && ! smoothing)
+            {
+                using IOType = typename std::remove_pointer<decltype(outputBlock.getChannelPointer(0))>::type;
+                auto outputChunk = outputBlock.getSubBlock(start, chunk);
+
+                if (hasSeparateDry)
+                    outputChunk.replaceWithProductOf(inputBlock.getSubBlock(start, chunk), static_cast<IOType>(wet.getCurrentValue()))
+                               .addProductOf(dryBlock.getSubBlock(start, chunk), static_cast<IOType>(dry.getCurrentValue()));
+                else
+                    outputChunk.replaceWithProductOf(inputBlock.getSubBlock(start, chunk), static_cast<IOType>(dry.getCurrentValue() + wet.getCurrentValue()));
+
+                start += chunk;
+                continue;
+            }
+
+            if (smoothing)
+            {
+                for (size_t i = 0; i < chunk; ++i)
+                {
+                    dryGains[i] = dry.getNextValue();
+                    wetGains[i] = wet.getNextValue();
+                }
+            }
+
+            if (ramping && smoothing)
+                processChannels<Type, true, true>(inputBlock, dryBlock, outputBlock, start, chunk);
+            else if (ramping)
+                processChannels<Type, true, false>(inputBlock, dryBlock, outputBlock, start, chunk);
+            else if (smoothing)
+                processChannels<Type, false, true>(inputBlock, dryBlock, outputBlock, start, chunk);
+            else
+                processChannels<Type, false, false>(inputBlock, dryBlock, outputBlock, start, chunk);
+
+            start += chunk;
+        }
+    }
+
+    /** Runs one chunk over every channel. With SIMD available, channels are
+    processed in groups of numLanes, one channel per lane; any channels left
+    over run through the scalar path. */
+    template <TransformationType Type, bool isRampingCoefficients, bool isSmoothing, typename InputBlock, typename DryBlock, typename OutputBlock>
+    void processChannels(const InputBlock& inputBlock, const DryBlock& dryBlock, OutputBlock& outputBlock, size_t start, size_t numSamples) noexcept
+    {
+        const auto numChannels = outputBlock.getNumChannels();
+        size_t channel = 0;
+
+#if JUCE_USE_SIMD
+        if (numChannels > 1)
+            for (; channel < numChannels; channel += numLanes)
+                processLanes<Type, isRampingCoefficients, isSmoothing>(inputBlock, dryBlock, outputBlock, channel, start, numSamples);
+#endif
+
+        for (; channel < numChannels; ++channel)
+        {
+            auto* inputSamples = inputBlock.getChannelPointer(channel) + start;
+            auto* drySamples = dryBlock.getChannelPointer(channel) + start;
+            auto* outputSamples = outputBlock.getChannelPointer(channel) + start;
+
+            processChannel<Type, isRampingCoefficients, isSmoothing>(channel, inputSamples, drySamples, outputSamples, numSamples);
+        }
+    }
+
+    /** Runs all stages, gain and mix over one channel. */
+    template <TransformationType Type, bool isRampingCoefficients, bool isSmoothing, typename IOType>
+    void processChannel(size_t channel, const IOType* inputSamples, const IOType* drySamples, IOType* outputSamples, size_t numSamples) noexcept
+    {
+        constexpr auto n = FirstOrderKernel<Type>::numRegisters;
+
+        std::array<std::array<SampleType, n>, numStages> z;
+        auto* channelState = state.data() + (channel * numStages * n);
+
+        for (size_t k = 0; k < numActiveStages; ++k)
+        {
+            const auto stage = activeStages[k];
+
+            std::copy_n(channelState + (stage * n), n, z[stage].begin());
+        }
+
+        auto b_0 = b0, b_1 = b1, a_1 = a1;
+
+        const auto dryGain = dry.getCurrentValue();
+        const auto wetGain = wet.getCurrentValue();
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto Xn = static_cast<SampleType>(drySamples[i]);
+            auto Yn = static_cast<SampleType>(inputSamples[i]);
+
+            for (size_t k = 0; k < numActiveStages; ++k)
+            {
+                const auto stage = activeStages[k];
+
+                Yn = FirstOrderKernel<Type>::processSample(Yn, z[stage].data(), b_0[stage], b_1[stage], a_1[stage]);
+
+                if (isRampingCoefficients)
+                    b_0[stage] += incb0[stage], b_1[stage] += incb1[stage], a_1[stage] += inca1[stage];
+            }
+
+            if (isSmoothing)
+                outputSamples[i] = static_cast<IOType>((Xn * dryGains[i]) + (Yn * wetGains[i]));
+            else
+                outputSamples[i] = static_cast<IOType>((Xn * dryGain) + (Yn * wetGain));
+        }
+
+        for (size_t k = 0; k < numActiveStages; ++k)
+        {
+            const auto stage = activeStages[k];
+
+            std::copy_n(z[stage].begin(), n, channelState + (stage * n));
+        }
+    }
+
+#if JUCE_USE_SIMD
+    //==============================================================================
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = SIMDType::SIMDNumElements;
+
+    /** Samples per lane transposed at a time; the scratch frames stay on the stack. */
+    static constexpr size_t laneFrames = 64;
+
+    /** Runs all stages, gain and mix over up to numLanes channels starting at
+    firstChannel, one channel per SIMD lane. Each piece of the chunk is
+    transposed once into lane-major frames, so the stages run on whole
+    registers rather than gathering every sample; unused lanes run on
+    silence. */
+    template <TransformationType Type, bool isRampingCoefficients, bool isSmoothing, typename InputBlock, typename DryBlock, typename OutputBlock>
+    void processLanes(const InputBlock& inputBlock, const DryBlock& dryBlock, OutputBlock& outputBlock, size_t firstChannel, size_t start, size_t numSamples) noexcept
+    {
+        using IOType = typename std::remove_pointer<decltype(outputBlock.getChannelPointer(0))>::type;
+
+        const auto zero = static_cast<SampleType>(0.0);
+        const auto lanes = juce::jmin(numLanes, outputBlock.getNumChannels() - firstChannel);
+        const auto hasSeparateDry = dryBlock.getChannelPointer(firstChannel) != inputBlock.getChannelPointer(firstChannel);
+
+        alignas(sizeof(SIMDType)) SampleType frames[laneFrames * numLanes];
+        alignas(sizeof(SIMDType)) SampleType dryFrames[laneFrames * numLanes];
+
+        constexpr auto n = FirstOrderKernel<Type>::numRegisters;
+
+        std::array<std::array<SIMDType, n>, numStages> z;
+
+        for (auto& stageRegisters : z)
+            stageRegisters.fill(SIMDType::expand(zero));
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const auto* channelState = state.data() + ((firstChannel + lane) * numStages * n);
+
+            for (size_t k = 0; k < numActiveStages; ++k)
+            {
+                const auto stage = activeStages[k];
+
+                for (size_t r = 0; r < n; ++r)
+                    z[stage][r].set(lane, channelState[(stage * n) + r]);
+            }
+        }
+
+        auto b_0 = b0, b_1 = b1, a_1 = a1;
+
+        const auto dryGain = dry.getCurrentValue();
+        const auto wetGain = wet.getCurrentValue();
+
+        for (size_t done = 0; done < numSamples; done += laneFrames)
+        {
+            const auto numFrames = juce::jmin(laneFrames, numSamples - done);
+
+            if (lanes < numLanes)
+            {
+                std::fill_n(frames, numFrames * numLanes, zero);
+
+                if (hasSeparateDry)
+                    std::fill_n(dryFrames, numFrames * numLanes, zero);
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                const auto* inputSamples = inputBlock.getChannelPointer(firstChannel + lane) + start + done;
+
+                for (size_t i = 0; i < numFrames; ++i)
+                    frames[(i * numLanes) + lane] = static_cast<SampleType>(inputSamples[i]);
+
+                if (hasSeparateDry)
+                {
+                    const auto* drySamples = dryBlock.getChannelPointer(firstChannel + lane) + start + done;
+
+                    for (size_t i = 0; i < numFrames; ++i)
+                        dryFrames[(i * numLanes) + lane] = static_cast<SampleType>(drySamples[i]);
+                }
+            }
+
+            for (size_t i = 0; i < numFrames; ++i)
+            {
+                auto* frame = frames + (i * numLanes);
+                const auto Xn = SIMDType::fromRawArray(hasSeparateDry ? dryFrames + (i * numLanes) : frame);
+                auto Yn = SIMDType::fromRawArray(frame);
+
+                for (size_t k = 0; k < numActiveStages; ++k)
+                {
+                    const auto stage = activeStages[k];
+
+                    Yn = FirstOrderKernel<Type>::processSample(Yn, z[stage].data(), b_0[stage], b_1[stage], a_1[stage]);
+
+                    if (isRampingCoefficients)
+                        b_0[stage] += incb0[stage], b_1[stage] += incb1[stage], a_1[stage] += inca1[stage];
+                }
+
+                if (isSmoothing)
+                    ((Xn * dryGains[done + i]) + (Yn * wetGains[done + i])).copyToRawArray(frame);
+                else
+                    ((Xn * dryGain) + (Yn * wetGain)).copyToRawArray(frame);
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                auto* outputSamples = outputBlock.getChannelPointer(firstChannel + lane) + start + done;
+
+                for (size_t i = 0; i < numFrames; ++i)
+                    outputSamples[i] = static_cast<IOType>(frames[(i * numLanes) + lane]);
+            }
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            auto* channelState = state.data() + ((firstChannel + lane) * numStages * n);
+
+            for (size_t k = 0; k < numActiveStages; ++k)
+            {
+                const auto stage = activeStages[k];
+
+                for (size_t r = 0; r < n; ++r)
+                    channelState[(stage * n) + r] = z[stage][r].get(lane);
+            }
+        }
+    }
+#endif
+
+    /** Recalculates the dry and wet gain targets. */
+    void update();
+
+    //==============================================================================
+    /** Stages providing the coefficients. */
+    Stages stages;
+
+    //==============================================================================
+    /** Coefficients for each stage and their per-sample increments while ramping. */
+    std::array<SampleType, numStages> b0, b1, a1;
+    std::array<SampleType, numStages> incb0, incb1, inca1;
+
+    /** Designs the coefficients of all smoothing stages at once. */
+    FirstOrderBatch<SampleType, numStages> designer;
+
+    //==============================================================================
+    /** Per-stage crossfade towards identity. fade is 1 when the stage is fully
+    heard; once it rests at 0 the stage stays in the chain for tailSamples more
+    samples, and is then skipped. */
+    std::array<SampleType, numStages> fade;
+    std::array<double, numStages> tailSamples;
+    std::array<bool, numStages> bypassed, skipped, modulated;
+    SampleType fadeIncrement = 1.0;
+
+    /** Stages taking part in the current chunk, in processing order. */
+    std::array<size_t, numStages> activeStages;
+    size_t numActiveStages = numStages;
+
+    /** Linear tolerance for treating a stage as an identity (about 0.001 dB),
+    and the level its tail must decay to before it is skipped (-120 dB). */
+    static constexpr double identityTolerance = 1.0e-4, decayLevel = 1.0e-6;
+
+    //==============================================================================
+    /** Unit-delays, interleaved per stage and channel with only as many
+    registers per stage as the current topology uses; room for the largest
+    topology is kept so that switching never allocates. */
+    std::vector<SampleType> state;
+    size_t numStateChannels = 0, numRegisters = 1;
+
+    //==============================================================================
+    /** Per-sample gains used while the dry/wet ramps are running. */
+    std::vector<SampleType> dryGains, wetGains;
+    size_t maxChunk = 0;
+
+    //==============================================================================
+    /** Parameter Smoothers. */
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> dry, wet;
+
+    //==============================================================================
+    /** Initialise the parameters. */
+    SampleType gain = 1.0, mix = 1.0;
+    TransformationType transformType = TransformationType::directFormIItransposed;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BiLinearCascade)
+};
+
+#endif //BILINEARCASCADE_H_INCLUDED
@@ -23,17 +23,29 @@ void BiLinearFilters<SampleType>::setFrequency(SampleType newFreq)
 {
     jassert(static_cast<SampleType>(20.0) <= newFreq && newFreq <= static_cast<SampleType>(20000.0));
 
-    hz = static_cast<SampleType>(juce::jlimit(minFreq, maxFreq, newFreq));
+    const auto newHz = static_cast<SampleType>(juce::jlimit(minFreq, maxFreq, newFreq));
+
+    if (hz == newHz)
+        return;
+
+    hz = newHz;
     frq.setTargetValue(hz);
-    coefficients();
+
+    if (! frq.isSmoothing())
+        coefficients();
 }
 
 template <typename SampleType>
 void BiLinearFilters<SampleType>::setGain(SampleType newGain)
 {
+    if (g == static_cast<SampleType>(newGain))
+        return;
+
     g = static_cast<SampleType>(newGain);
     lev.setTargetValue(g);
-    coefficients();
+
+    if (! lev.isSmoothing())
+        coefficients();
 }
 
 template <typename SampleType>
@@ -53,11 +65,29 @@ void BiLinearFilters<SampleType>::setTransformType(transformationType newTransfo
     if (transformType != newTransformType)
     {
         transformType = newTransformType;
+        numRegisters = getFirstOrderRegisters(transformType);
         reset(static_cast<SampleType>(0.0));
         coefficients();
     }
 }
 
+template <typename SampleType>
+void BiLinearFilters<SampleType>::setDesignType(designType newDesignType)
+{
+    if (designMode != newDesignType)
+    {
+        // Crossfades the coefficients from the old design to the new one
+        // over the ramp, so the switch doesn't step.
+        previousDesign = designMode;
+        designMode = newDesignType;
+
+        designFade.setCurrentAndTargetValue(zero);
+        designFade.setTargetValue(one);
+
+        coefficients();
+    }
+}
+
 //==============================================================================
 template <typename SampleType>
 void BiLinearFilters<SampleType>::setRampDurationSeconds(double newDurationSeconds) noexcept
@@ -65,7 +95,12 @@ void BiLinearFilters<SampleType>::setRampDurationSeconds(double newDurationSecon
     if (rampDurationSeconds != newDurationSeconds)
     {
         rampDurationSeconds = newDurationSeconds;
-        reset(static_cast<SampleType>(0.0));
+
+        // Dynamic shelves change their ramp while running, so the state and
+        // any ramp in progress are kept.
+        Smoothing::retime(frq, sampleRate, rampDurationSeconds);
+        Smoothing::retime(lev, sampleRate, rampDurationSeconds);
+        Smoothing::retime(designFade, sampleRate, rampDurationSeconds);
     }
 }
 
@@ -78,253 +113,238 @@ double BiLinearFilters<SampleType>::getRampDurationSeconds() const noexcept
 template <typename SampleType>
 bool BiLinearFilters<SampleType>::isSmoothing() const noexcept
 {
-    bool compSmoothing = frq.isSmoothing() || lev.isSmoothing();
+    bool compSmoothing = frq.isSmoothing() || lev.isSmoothing() || designFade.isSmoothing();
 
     return compSmoothing;
 }
 
-//==============================================================================
 template <typename SampleType>
-void BiLinearFilters<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+void BiLinearFilters<SampleType>::advanceSmoothing(int numSamples) noexcept
 {
-    jassert(spec.sampleRate > 0);
-    jassert(spec.numChannels > 0);
+    if (! isSmoothing())
+        return;
 
-    sampleRate = spec.sampleRate;
-
-    Wn_1.resize(spec.numChannels);
-    Xn_1.resize(spec.numChannels);
-    Yn_1.resize(spec.numChannels);
-
-    reset(static_cast<SampleType>(0.0));
-
-    minFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(24576.0);
-    maxFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(2.125);
-
-    jassert(static_cast <SampleType>(20.0) >= minFreq && minFreq <= static_cast <SampleType>(20000.0));
-    jassert(static_cast <SampleType>(20.0) <= maxFreq && maxFreq >= static_cast <SampleType>(20000.0));
-
-    setFrequency(hz);
-    setGain(g);
+    frq.skip(numSamples);
+    lev.skip(numSamples);
+    designFade.skip(numSamples);
 
     coefficients();
 }
 
 template <typename SampleType>
-void BiLinearFilters<SampleType>::reset(SampleType initialValue)
+void BiLinearFilters<SampleType>::skipSmoothing(int numSamples) noexcept
 {
-    for (auto v : { &Wn_1, &Xn_1, &Yn_1, })
-        std::fill(v->begin(), v->end(), initialValue);
-
-    frq.reset(sampleRate, rampDurationSeconds);
-    lev.reset(sampleRate, rampDurationSeconds);
-
-    coefficients();
+    frq.skip(numSamples);
+    lev.skip(numSamples);
+    designFade.skip(numSamples);
 }
 
 template <typename SampleType>
-SampleType BiLinearFilters<SampleType>::processSample(int channel, SampleType inputValue)
+void BiLinearFilters<SampleType>::setCoefficients(SampleType newb0, SampleType newb1, SampleType newa1) noexcept
 {
-    jassert(juce::isPositiveAndBelow(channel, Wn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Xn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
-
-    switch (transformType)
-    {
-    case TransformationType::directFormI:
-        inputValue = directFormI(channel, inputValue);
-        break;
-    case TransformationType::directFormII:
-        inputValue = directFormII(channel, inputValue);
-        break;
-    case TransformationType::directFormItransposed:
-        inputValue = directFormITransposed(channel, inputValue);
-        break;
-    case TransformationType::directFormIItransposed:
-        inputValue = directFormIITransposed(channel, inputValue);
-        break;
-    default:
-        inputValue = directFormIITransposed(channel, inputValue);
-    }
-
-    return inputValue;
+    b0 = newb0;
+    b1 = newb1;
+    a0 = one;
+    a1 = newa1;
 }
 
+//==============================================================================
 template <typename SampleType>
-SampleType BiLinearFilters<SampleType>::directFormI(int channel, SampleType inputValue)
+void BiLinearFilters<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Yn1 = Yn_1[(size_t)channel];
-
-    SampleType Xn = inputValue;
-
-    SampleType Yn = ((Xn * b0) + (Xn1 * b1) + (Yn1 * a1));
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
 
-    Xn1 = Xn, Yn1 = Yn;
+    sampleRate = spec.sampleRate;
 
-    return Yn;
-}
+    numChannels = static_cast<size_t>(spec.numChannels);
+    numRegisters = getFirstOrderRegisters(transformType);
+    state.resize(numChannels * maxFirstOrderRegisters);
 
-template <typename SampleType>
-SampleType BiLinearFilters<SampleType>::directFormII(int channel, SampleType inputValue)
-{
-    auto& Wn1 = Wn_1[(size_t)channel];
+    reset(static_cast<SampleType>(0.0));
 
-    SampleType Xn = inputValue;
+    minFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(24576.0);
+    maxFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(2.125);
 
-    SampleType Wn = (Xn + ((Wn1 * a1)));
-    SampleType Yn = ((Wn * b0) + (Wn1 * b1));
+    jassert(static_cast <SampleType>(20.0) >= minFreq && minFreq <= static_cast <SampleType>(20000.0));
+    jassert(static_cast <SampleType>(20.0) <= maxFreq && maxFreq >= static_cast <SampleType>(20000.0));
 
-    Wn1 = Wn;
+    setFrequency(hz);
+    setGain(g);
 
-    return Yn;
+    coefficients();
 }
 
-//template <typename SampleType>
-//SampleType BiLinearFilters<SampleType>::directFormITransposedDecramped???(int channel, SampleType inputValue)
-//{
-//    auto& Wn1 = Wn_1[(size_t)channel];
-//
-//    SampleType Xn = inputValue;
-//
-//    SampleType Wn = (Xn + Wn1);
-//    SampleType Yn = ((Wn * b0) + (Wn * b1));
-//
-//    Wn1 = (Wn * a1);
-//
-//    return Yn;
-//}
-
 template <typename SampleType>
-SampleType BiLinearFilters<SampleType>::directFormITransposed(int channel, SampleType inputValue)
+void BiLinearFilters<SampleType>::setSampleRate(double newSampleRate) noexcept
 {
-    auto& Wn1 = Wn_1[(size_t)channel];
-    auto& Yn1 = Yn_1[(size_t)channel];
+    jassert(newSampleRate > 0);
 
-    SampleType Xn = inputValue;
+    sampleRate = newSampleRate;
 
-    SampleType Wn = (Xn + Wn1);
-    SampleType Yn = ((Wn * b0) + Yn1);
+    minFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(24576.0);
+    maxFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(2.125);
+
+    jassert(static_cast <SampleType>(20.0) >= minFreq && minFreq <= static_cast <SampleType>(20000.0));
+    jassert(static_cast <SampleType>(20.0) <= maxFreq && maxFreq >= static_cast <SampleType>(20000.0));
 
-    Wn1 = (Wn * a1), Yn1 = ((Wn * b1));
+    Smoothing::retime(frq, sampleRate, rampDurationSeconds);
+    Smoothing::retime(lev, sampleRate, rampDurationSeconds);
+    Smoothing::retime(designFade, sampleRate, rampDurationSeconds);
 
-    return Yn;
+    coefficients();
 }
 
 template <typename SampleType>
-SampleType BiLinearFilters<SampleType>::directFormIITransposed(int channel, SampleType inputValue)
+void BiLinearFilters<SampleType>::reset(SampleType initialValue)
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-
-    SampleType Xn = inputValue;
+    std::fill(state.begin(), state.end(), initialValue);
 
-    SampleType Yn = ((Xn * b0) + Xn1);
+    frq.reset(sampleRate, rampDurationSeconds);
+    lev.reset(sampleRate, rampDurationSeconds);
+    designFade.reset(sampleRate, rampDurationSeconds);
 
-    Xn1 = ((Xn * b1) + (Yn * a1));
+    frq.setCurrentAndTargetValue(hz);
+    lev.setCurrentAndTargetValue(g);
+    designFade.setCurrentAndTargetValue(one);
 
-    return Yn;
+    coefficients();
 }
 
 template <typename SampleType>
-void BiLinearFilters<SampleType>::coefficients()
+FirstOrderPrototype<SampleType> BiLinearFilters<SampleType>::getPrototype() const noexcept
 {
-    SampleType omega = static_cast <SampleType>(frq.getNextValue() * ((pi * two) / sampleRate));
-    SampleType cos = static_cast <SampleType>(std::cos(omega));
-    SampleType sin = static_cast <SampleType>(std::sin(omega));
-    SampleType tan = static_cast <SampleType>(sin / cos);
-    SampleType a = static_cast <SampleType>(juce::Decibels::decibelsToGain(static_cast<SampleType>(lev.getNextValue() * static_cast <SampleType>(0.5))));
-
-    juce::ignoreUnused(tan);
-
-    SampleType b_0 = one;
-    SampleType b_1 = zero;
-    SampleType a_0 = one;
-    SampleType a_1 = zero;
+    FirstOrderPrototype<SampleType> prototype;
 
     switch (filtType)
     {
     case filterType::lowPass:
 
-        b_0 = omega / (one + omega);
-        b_1 = omega / (one + omega);
-        a_0 = one;
-        a_1 = minusOne * ((one - omega) / (one + omega));
+        prototype.dc0 = one, prototype.hf0 = zero;
 
         break;
 
 
     case filterType::highPass:
 
-        b_0 = one / (one + omega);
-        b_1 = (one / (one + omega)) * minusOne;
-        a_0 = one;
-        a_1 = ((one - omega) / (one + omega)) * minusOne;
+        prototype.dc0 = zero, prototype.hf0 = one;
 
         break;
 
 
     case filterType::lowShelf:
 
-        b_0 = one + ((omega / (one + omega)) * (minusOne + (a * a)));
-        b_1 = (((omega / (one + omega)) * (minusOne + (a * a))) - ((one - omega) / (one + omega)));
-        a_0 = one;
-        a_1 = minusOne * ((one - omega) / (one + omega));
+        prototype.dc0 = zero, prototype.dcA = one;
 
         break;
 
 
     case filterType::lowShelfC:
 
-        b_0 = one + ((omega / a) / (one + (omega / a)) * (minusOne + (a * a)));
-        b_1 = ((((omega / a) / (one + (omega / a))) * (minusOne + (a * a))) - ((one - (omega / a)) / (one + (omega / a))));
-        a_0 = one;
-        a_1 = minusOne * ((one - (omega / a)) / (one + (omega / a)));
+        prototype.dc0 = zero, prototype.dcA = one;
+        prototype.pole0 = zero, prototype.poleInvA = one;
 
         break;
 
 
     case filterType::highShelf:
 
-        b_0 = one + ((minusOne + (a * a)) / (one + omega));
-        b_1 = minusOne * (((one - omega) / (one + omega)) + ((minusOne + (a * a)) / (one + omega)));
-        a_0 = one;
-        a_1 = minusOne * ((one - omega) / (one + omega));
+        prototype.hf0 = zero, prototype.hfA = one;
 
         break;
 
 
     case filterType::highShelfC:
 
-        b_0 = one + ((minusOne + (a * a)) / (one + (omega * a)));
-        b_1 = minusOne * (((one - (omega * a)) / (one + (omega * a))) + ((minusOne + (a * a)) / (one + (omega * a))));
-        a_0 = one;
-        a_1 = minusOne * ((one - (omega * a)) / (one + (omega * a)));
+        prototype.hf0 = zero, prototype.hfA = one;
+        prototype.pole0 = zero, prototype.poleA = one;
 
         break;
 
 
     default:
 
-        b_0 = one;
-        b_1 = zero;
-        a_0 = one;
-        a_1 = zero;
-
         break;
     }
 
+    return prototype;
+}
+
+template <typename SampleType>
+void BiLinearFilters<SampleType>::coefficients()
+{
+    SampleType omega = getOmega();
+    SampleType a = static_cast <SampleType>(juce::Decibels::decibelsToGain(static_cast<SampleType>(lev.getCurrentValue() * static_cast <SampleType>(0.5))));
+
+    SampleType b_0 = one;
+    SampleType b_1 = zero;
+    SampleType a_0 = one;
+    SampleType a_1 = zero;
+
+    const auto prototype = getPrototype();
+
+    FirstOrderDesign<SampleType>::design(designMode, omega, prototype.getPoleScale(a), prototype.getDCGain(a * a), prototype.getHFGain(a * a), b_0, b_1, a_1);
+
+    if (designFade.isSmoothing())
+    {
+        SampleType p_0 = one, p_1 = zero, q_1 = zero;
+        const SampleType t = designFade.getCurrentValue();
+
+        FirstOrderDesign<SampleType>::design(previousDesign, omega, prototype.getPoleScale(a), prototype.getDCGain(a * a), prototype.getHFGain(a * a), p_0, p_1, q_1);
+
+        b_0 = p_0 + ((b_0 - p_0) * t);
+        b_1 = p_1 + ((b_1 - p_1) * t);
+        a_1 = q_1 + ((a_1 - q_1) * t);
+    }
+
     a0 = static_cast <SampleType>(one / a_0);
     a1 = static_cast <SampleType>((a_1 * a0) * minusOne);
     b0 = static_cast <SampleType>(b_0 * a0);
     b1 = static_cast <SampleType>(b_1 * a0);
 }
 
+template <typename SampleType>
+bool BiLinearFilters<SampleType>::isIdentity(SampleType tolerance) const noexcept
+{
+    // With y[n] = b0.x[n] + b1.x[n-1] + a1.y[n-1], the gain is
+    // (b0 + b1) / (1 - a1) at DC and (b0 - b1) / (1 + a1) at Nyquist.
+    const auto dcDenominator = one - a1;
+    const auto nyquistDenominator = one + a1;
+
+    return std::abs((b0 + b1) - dcDenominator) <= tolerance * std::abs(dcDenominator)
+        && std::abs((b0 - b1) - nyquistDenominator) <= tolerance * std::abs(nyquistDenominator);
+}
+
+template <typename SampleType>
+double BiLinearFilters<SampleType>::getDecaySamples(SampleType decayLevel) const noexcept
+{
+    // An unstable or integrating pole never decays; report a generous upper bound.
+    const auto maxDecaySamples = sampleRate * 10.0;
+    const auto pole = std::abs(static_cast<double>(a1));
+
+    if (pole >= 1.0)
+        return maxDecaySamples;
+
+    if (pole <= std::numeric_limits<double>::epsilon())
+        return 1.0;
+
+    return juce::jmin(maxDecaySamples, std::ceil(std::log(static_cast<double>(decayLevel)) / std::log(pole)));
+}
+
+template <typename SampleType>
+std::complex<double> BiLinearFilters<SampleType>::getResponse(double omega) const noexcept
+{
+    const auto z1 = std::polar(1.0, -omega);
+
+    return (static_cast<double>(b0) + (static_cast<double>(b1) * z1)) / (1.0 - (static_cast<double>(a1) * z1));
+}
+
 template <typename SampleType>
 void BiLinearFilters<SampleType>::snapToZero() noexcept
 {
-    for (auto v : { &Wn_1, &Xn_1, &Yn_1 })
-        for (auto& element : *v)
-            juce::dsp::util::snapToZero(element);
+    // Only the registers the topology uses.
+    for (size_t i = 0; i < numChannels * numRegisters; ++i)
+        juce::dsp::util::snapToZero(state[i]);
 }
 
 template class BiLinearFilters<float>;
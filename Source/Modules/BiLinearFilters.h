@@ -14,7 +14,10 @@
 #ifndef BILINEARFILTERS_H_INCLUDED
 #define BILINEARFILTERS_H_INCLUDED
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
+#include "Transformations.h"
+#include "CoefficientDesign.h"
+#include "Smoothing.h"
 
 enum class FilterType
 {
@@ -26,14 +29,6 @@ enum class FilterType
     highShelfC = 5,
 };
 
-enum class TransformationType
-{
-    directFormI = 0,
-    directFormII = 1,
-    directFormItransposed = 2,
-    directFormIItransposed = 3
-};
-
 /**
     A handy 2-pole Biquad multi-mode equalizer.
 */
@@ -44,6 +39,7 @@ class BiLinearFilters
 public:
     using filterType = FilterType;
     using transformationType = TransformationType;
+    using designType = DesignType;
     //==============================================================================
     /** Constructor. */
     BiLinearFilters();
@@ -61,8 +57,14 @@ public:
     /** Sets the BiLinear Transform for the filter to use. See enum for available types. */
     void setTransformType(transformationType newTransformType);
 
+    /** Sets how the analog prototype is mapped to coefficients. The state is
+    kept and the coefficients crossfade from the old mode over the ramp, so
+    the mode can be changed while processing. See CoefficientDesign.h. */
+    void setDesignType(designType newDesignType);
+
     //==============================================================================
-    /** Sets the length of the ramp used for smoothing parameter changes. */
+    /** Sets the length of the ramp used for smoothing parameter changes. A
+    ramp in progress carries on over the new length; nothing is reset. */
     void setRampDurationSeconds(double newDurationSeconds) noexcept;
 
     /** Returns the ramp duration in seconds. */
@@ -71,10 +73,23 @@ public:
     /** Returns true if the current value is currently being interpolated. */
     bool isSmoothing() const noexcept;
 
+    /** Advances the parameter smoothers by numSamples and redesigns the
+    coefficients for the end of that span. Does nothing while not smoothing. */
+    void advanceSmoothing(int numSamples) noexcept;
+
+    /** Advances the parameter smoothers by numSamples without redesigning,
+    for callers that design the coefficients themselves, e.g. with a
+    FirstOrderBatch, and pass them back with setCoefficients(). */
+    void skipSmoothing(int numSamples) noexcept;
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare(juce::dsp::ProcessSpec& spec);
 
+    /** Moves the filter to a new sample rate without clearing its state or
+    snapping its ramps, e.g. for a change of oversampling factor. */
+    void setSampleRate(double newSampleRate) noexcept;
+
     /** Resets the internal state variables of the processor. */
     void reset(SampleType initialValue);
 
@@ -90,64 +105,268 @@ public:
     {
         const auto& inputBlock = context.getInputBlock();
         auto& outputBlock = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
+        const auto numBlockChannels = outputBlock.getNumChannels();
         const auto numSamples = outputBlock.getNumSamples();
         const auto len = inputBlock.getNumSamples();
 
-        jassert(inputBlock.getNumChannels() == numChannels);
+        jassert(inputBlock.getNumChannels() == numBlockChannels);
         jassert(inputBlock.getNumSamples() == numSamples);
+        jassert(numBlockChannels <= numChannels);
+        juce::ignoreUnused(numBlockChannels, numSamples);
 
         if (context.isBypassed)
         {
-            frq.skip(static_cast<int> (len));
-            lev.skip(static_cast<int> (len));
+            advanceSmoothing(static_cast<int> (len));
 
             outputBlock.copyFrom(inputBlock);
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
+        switch (transformType)
         {
-            auto* inputSamples = inputBlock.getChannelPointer(channel);
-            auto* outputSamples = outputBlock.getChannelPointer(channel);
+        case TransformationType::directFormI:
+            processBlock<TransformationType::directFormI>(inputBlock, outputBlock);
+            break;
+        case TransformationType::directFormII:
+            processBlock<TransformationType::directFormII>(inputBlock, outputBlock);
+            break;
+        case TransformationType::directFormItransposed:
+            processBlock<TransformationType::directFormItransposed>(inputBlock, outputBlock);
+            break;
+        case TransformationType::directFormIItransposed:
+            processBlock<TransformationType::directFormIItransposed>(inputBlock, outputBlock);
+            break;
+        default:
+            processBlock<TransformationType::directFormIItransposed>(inputBlock, outputBlock);
+        }
+    }
 
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample((int)channel, inputSamples[i]);
+    //==============================================================================
+    /** Processes one sample at a time on a given channel. */
+    SampleType processSample(int channel, SampleType inputValue)
+    {
+        jassert(juce::isPositiveAndBelow(channel, numChannels));
+
+        switch (transformType)
+        {
+        case TransformationType::directFormI:
+            return processSample<TransformationType::directFormI>(channel, inputValue);
+        case TransformationType::directFormII:
+            return processSample<TransformationType::directFormII>(channel, inputValue);
+        case TransformationType::directFormItransposed:
+            return processSample<TransformationType::directFormItransposed>(channel, inputValue);
+        case TransformationType::directFormIItransposed:
+            return processSample<TransformationType::directFormIItransposed>(channel, inputValue);
+        default:
+            return processSample<TransformationType::directFormIItransposed>(channel, inputValue);
         }
+    }
 
-#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
-        snapToZero();
-#endif
+    /** Processes one sample on a given channel with a fixed transformation. */
+    template <TransformationType Type>
+    SampleType processSample(int channel, SampleType inputValue) noexcept
+    {
+        constexpr auto n = FirstOrderKernel<Type>::numRegisters;
+
+        return FirstOrderKernel<Type>::processSample(inputValue, state.data() + (static_cast<size_t>(channel) * n), b0, b1, a1);
     }
 
     //==============================================================================
-    /** Processes one sample at a time on a given channel. */
-    SampleType processSample(int channel, SampleType inputValue);
+    /** Returns the current coefficients, normalised and ready for directFormIItransposed. */
+    SampleType getb0() const noexcept { return static_cast<SampleType>(b0); }
+    SampleType getb1() const noexcept { return static_cast<SampleType>(b1); }
+    SampleType geta0() const noexcept { return static_cast<SampleType>(a0); }
+    SampleType geta1() const noexcept { return static_cast<SampleType>(a1); }
+
+    /** Replaces the current coefficients, normalised as returned above. */
+    void setCoefficients(SampleType newb0, SampleType newb1, SampleType newa1) noexcept;
+
+    /** Returns the current (smoothed) frequency in radians per sample, and
+    the current shelf gain in dB. */
+    SampleType getOmega() const noexcept { return static_cast<SampleType>(frq.getCurrentValue() * ((pi * two) / sampleRate)); }
+    SampleType getGainDecibels() const noexcept { return lev.getCurrentValue(); }
+
+    /** Returns the filter type as weights for FirstOrderDesign and FirstOrderBatch. */
+    FirstOrderPrototype<SampleType> getPrototype() const noexcept;
+
+    /** Returns the current coefficient design mode. */
+    designType getDesignType() const noexcept { return designMode; }
+
+    /** Returns true while the coefficients crossfade after a design switch. */
+    bool isChangingDesign() const noexcept { return designFade.isSmoothing(); }
+
+    /** Returns true if the current coefficients leave the signal unchanged,
+    i.e. the gains at DC and at Nyquist (and, for a first-order section, every
+    gain in between) are within the given linear tolerance of unity. */
+    bool isIdentity(SampleType tolerance) const noexcept;
+
+    /** Returns how many samples the impulse response takes to decay below
+    decayLevel (linear), from the current pole position. */
+    double getDecaySamples(SampleType decayLevel) const noexcept;
+
+    /** Returns the frequency response of the current coefficients at omega
+    radians per sample. */
+    std::complex<double> getResponse(double omega) const noexcept;
 
     double sampleRate = 44100.0, rampDurationSeconds = 0.00005;
 
+    /** Number of samples between coefficient designs while smoothing. The
+    coefficients are linearly interpolated in between. */
+    static constexpr size_t rampInterval = 32;
+
 private:
+    //==============================================================================
+    /** Processes a whole block with a fixed transformation, splitting it into
+    ramps of rampInterval samples while the parameters are smoothing. */
+    template <TransformationType Type, typename InputBlock, typename OutputBlock>
+    void processBlock(const InputBlock& inputBlock, OutputBlock& outputBlock) noexcept
+    {
+        const auto numSamples = outputBlock.getNumSamples();
+
+        for (size_t start = 0; start < numSamples;)
+        {
+            if (! isSmoothing())
+            {
+                processSpan<Type, false>(inputBlock, outputBlock, start, numSamples - start);
+                break;
+            }
+
+            const auto span = juce::jmin(rampInterval, numSamples - start);
+
+            processSpan<Type, true>(inputBlock, outputBlock, start, span);
+            start += span;
+        }
+    }
 
+    /** Processes a span of samples. While ramping, the coefficients move sample
+    by sample towards those designed for the end of the span. */
+    template <TransformationType Type, bool isRamping, typename InputBlock, typename OutputBlock>
+    void processSpan(const InputBlock& inputBlock, OutputBlock& outputBlock, size_t start, size_t span) noexcept
+    {
+        const auto startb0 = b0, startb1 = b1, starta1 = a1;
+        auto incb0 = zero, incb1 = zero, inca1 = zero;
+
+        if (isRamping)
+        {
+            advanceSmoothing(static_cast<int>(span));
+
+            const auto scale = one / static_cast<SampleType>(span);
+            incb0 = (b0 - startb0) * scale;
+            incb1 = (b1 - startb1) * scale;
+            inca1 = (a1 - starta1) * scale;
+        }
+
+        constexpr auto n = FirstOrderKernel<Type>::numRegisters;
+        const auto numBlockChannels = outputBlock.getNumChannels();
+        size_t channel = 0;
+
+#if JUCE_USE_SIMD
+        if (numBlockChannels > 1)
+            for (; channel < numBlockChannels; channel += numLanes)
+                processLanes<Type, isRamping>(inputBlock, outputBlock, channel, start, span, startb0, startb1, starta1, incb0, incb1, inca1);
+#endif
+
+        for (; channel < numBlockChannels; ++channel)
+        {
+            auto* inputSamples = inputBlock.getChannelPointer(channel) + start;
+            auto* outputSamples = outputBlock.getChannelPointer(channel) + start;
+            auto* channelState = state.data() + (channel * n);
+
+            std::array<SampleType, n> z;
+            std::copy_n(channelState, n, z.begin());
+
+            auto b_0 = startb0, b_1 = startb1, a_1 = starta1;
+
+            for (size_t i = 0; i < span; ++i)
+            {
+                outputSamples[i] = FirstOrderKernel<Type>::processSample(inputSamples[i], z.data(), b_0, b_1, a_1);
+
+                if (isRamping)
+                    b_0 += incb0, b_1 += incb1, a_1 += inca1;
+            }
+
+            std::copy_n(z.begin(), n, channelState);
+        }
+    }
+
+#if JUCE_USE_SIMD
     //==============================================================================
-    void coefficients();
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = SIMDType::SIMDNumElements;
+
+    /** Samples per lane transposed at a time; the scratch frames stay on the stack. */
+    static constexpr size_t laneFrames = 64;
+
+    /** Processes up to numLanes channels at once, starting at firstChannel,
+    with one channel per SIMD lane. Each chunk of the span is transposed once
+    into lane-major frames, so the recursion runs on whole registers rather
+    than gathering every sample; unused lanes run on silence. */
+    template <TransformationType Type, bool isRamping, typename InputBlock, typename OutputBlock>
+    void processLanes(const InputBlock& inputBlock, OutputBlock& outputBlock, size_t firstChannel, size_t start, size_t span,
+                      SampleType b_0, SampleType b_1, SampleType a_1, SampleType incb0, SampleType incb1, SampleType inca1) noexcept
+    {
+        const auto lanes = juce::jmin(numLanes, outputBlock.getNumChannels() - firstChannel);
+
+        alignas(sizeof(SIMDType)) SampleType frames[laneFrames * numLanes];
+
+        constexpr auto n = FirstOrderKernel<Type>::numRegisters;
+
+        std::array<SIMDType, n> z;
+        z.fill(SIMDType::expand(zero));
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+            for (size_t r = 0; r < n; ++r)
+                z[r].set(lane, state[((firstChannel + lane) * n) + r]);
+
+        for (size_t done = 0; done < span; done += laneFrames)
+        {
+            const auto numFrames = juce::jmin(laneFrames, span - done);
+
+            if (lanes < numLanes)
+                std::fill_n(frames, numFrames * numLanes, zero);
 
-    SampleType directFormI(int channel, SampleType inputValue);
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                const auto* inputSamples = inputBlock.getChannelPointer(firstChannel + lane) + start + done;
 
-    SampleType directFormII(int channel, SampleType inputValue);
+                for (size_t i = 0; i < numFrames; ++i)
+                    frames[(i * numLanes) + lane] = inputSamples[i];
+            }
 
-    SampleType directFormITransposed(int channel, SampleType inputValue);
+            for (size_t i = 0; i < numFrames; ++i)
+            {
+                auto* frame = frames + (i * numLanes);
 
-    SampleType directFormIITransposed(int channel, SampleType inputValue);
+                FirstOrderKernel<Type>::processSample(SIMDType::fromRawArray(frame), z.data(), b_0, b_1, a_1).copyToRawArray(frame);
+
+                if (isRamping)
+                    b_0 += incb0, b_1 += incb1, a_1 += inca1;
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                auto* outputSamples = outputBlock.getChannelPointer(firstChannel + lane) + start + done;
+
+                for (size_t i = 0; i < numFrames; ++i)
+                    outputSamples[i] = frames[(i * numLanes) + lane];
+            }
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+            for (size_t r = 0; r < n; ++r)
+                state[((firstChannel + lane) * n) + r] = z[r].get(lane);
+    }
+#endif
 
     //==============================================================================
-    SampleType getb0() { return static_cast<SampleType>(b0); }
-    SampleType getb1() { return static_cast<SampleType>(b1); }
-    SampleType geta0() { return static_cast<SampleType>(a0); }
-    SampleType geta1() { return static_cast<SampleType>(a1); }
+    void coefficients();
 
     //==============================================================================
-    /** Unit-delay objects. */
-    std::vector<SampleType> Wn_1, Xn_1, Yn_1;
+    /** Unit-delays, packed per channel with only as many registers as the
+    current topology uses; room for the largest topology is kept so that
+    switching never allocates. */
+    std::vector<SampleType> state;
+    size_t numChannels = 0, numRegisters = 1;
 
     //==============================================================================
     /** Initialise the coefficient gains. */
@@ -161,11 +380,15 @@ private:
     juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> frq;
     juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> lev;
 
+    /** Position of a design switch, from previousDesign (0) to designMode (1). */
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> designFade;
+
     //==============================================================================
     /** Initialise the parameters. */
     SampleType minFreq = 20.0, maxFreq = 20000.0, hz = 1000.0, g = 0.0;
     filterType filtType = filterType::lowPass;
     transformationType transformType = transformationType::directFormIItransposed;
+    designType designMode = designType::bilinear, previousDesign = designType::bilinear;
 
     //==============================================================================
     /** Initialise constants. */
@@ -63,11 +63,22 @@ void Biquads<SampleType>::setTransformType(transformationType newTransformType)
     if (transformType != newTransformType)
     {
         transformType = newTransformType;
+        numRegisters = getSecondOrderRegisters(transformType);
         reset(static_cast<SampleType>(0.0));
         coefficients();
     }
 }
 
+template <typename SampleType>
+void Biquads<SampleType>::setDesignType(designType newDesignType)
+{
+    if (designMode != newDesignType)
+    {
+        designMode = newDesignType;
+        coefficients();
+    }
+}
+
 //==============================================================================
 template <typename SampleType>
 void Biquads<SampleType>::setRampDurationSeconds(double newDurationSeconds) noexcept
@@ -75,7 +86,10 @@ void Biquads<SampleType>::setRampDurationSeconds(double newDurationSeconds) noex
     if (rampDurationSeconds != newDurationSeconds)
     {
         rampDurationSeconds = newDurationSeconds;
-        reset(static_cast<SampleType>(0.0));
+
+        Smoothing::retime(frq, sampleRate, rampDurationSeconds);
+        Smoothing::retime(res, sampleRate, rampDurationSeconds);
+        Smoothing::retime(lev, sampleRate, rampDurationSeconds);
     }
 }
 
@@ -103,12 +117,9 @@ void Biquads<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
 
     sampleRate = spec.sampleRate;
 
-    Wn_1.resize(spec.numChannels);
-    Wn_2.resize(spec.numChannels);
-    Xn_1.resize(spec.numChannels);
-    Xn_2.resize(spec.numChannels);
-    Yn_1.resize(spec.numChannels);
-    Yn_2.resize(spec.numChannels);
+    numChannels = static_cast<size_t>(spec.numChannels);
+    numRegisters = getSecondOrderRegisters(transformType);
+    state.resize(numChannels * maxSecondOrderRegisters);
 
     reset(static_cast<SampleType>(0.0));
 
@@ -126,118 +137,35 @@ void Biquads<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
 }
 
 template <typename SampleType>
-void Biquads<SampleType>::reset(SampleType initialValue)
+void Biquads<SampleType>::setSampleRate(double newSampleRate) noexcept
 {
-    for (auto v : { &Wn_1, &Wn_2, &Xn_1, &Xn_2, &Yn_1, &Yn_2 })
-        std::fill(v->begin(), v->end(), initialValue);
+    jassert(newSampleRate > 0);
 
-    frq.reset(sampleRate, rampDurationSeconds);
-    res.reset(sampleRate, rampDurationSeconds);
-    lev.reset(sampleRate, rampDurationSeconds);
+    sampleRate = newSampleRate;
 
-    coefficients();
-}
-
-template <typename SampleType>
-SampleType Biquads<SampleType>::processSample(int channel, SampleType inputValue)
-{
-    jassert(juce::isPositiveAndBelow(channel, Wn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Wn_2.size()));
-    jassert(juce::isPositiveAndBelow(channel, Xn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Xn_2.size()));
-    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
-    jassert(juce::isPositiveAndBelow(channel, Yn_1.size()));
-
-
-    switch (transformType)
-    {
-    case TransformationType::directFormI:
-        inputValue = directFormI(channel, inputValue);
-        break;
-    case TransformationType::directFormII:
-        inputValue = directFormII(channel, inputValue);
-        break;
-    case TransformationType::directFormItransposed:
-        inputValue = directFormITransposed(channel, inputValue);
-        break;
-    case TransformationType::directFormIItransposed:
-        inputValue = directFormIITransposed(channel, inputValue);
-        break;
-    default:
-        inputValue = directFormIITransposed(channel, inputValue);
-    }
-
-    return inputValue;
-}
-
-template <typename SampleType>
-SampleType Biquads<SampleType>::directFormI(int channel, SampleType inputValue)
-{
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
-    auto& Yn1 = Yn_1[(size_t)channel];
-    auto& Yn2 = Yn_2[(size_t)channel];
-
-    SampleType Xn = inputValue;
-
-    SampleType Yn = ((Xn * b0) + (Xn1 * b1) + (Xn2 * b2) + (Yn1 * a1) + (Yn2 * a2));
-
-    Xn2 = Xn1, Yn2 = Yn1;
-    Xn1 = Xn, Yn1 = Yn;
-
-    return Yn;
-}
-
-template <typename SampleType>
-SampleType Biquads<SampleType>::directFormII(int channel, SampleType inputValue)
-{
-    auto& Wn1 = Wn_1[(size_t)channel];
-    auto& Wn2 = Wn_2[(size_t)channel];
-
-    SampleType Xn = inputValue;
-
-    SampleType Wn = (Xn + ((Wn1 * a1) + (Wn2 * a2)));
-    SampleType Yn = ((Wn * b0) + (Wn1 * b1) + (Wn2 * b2));
-
-    Wn2 = Wn1;
-    Wn1 = Wn;
-
-    return Yn;
-}
-
-template <typename SampleType>
-SampleType Biquads<SampleType>::directFormITransposed(int channel, SampleType inputValue)
-{
-    auto& Wn1 = Wn_1[(size_t)channel];
-    auto& Wn2 = Wn_2[(size_t)channel];
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
-
-    SampleType Xn = inputValue;
+    minFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(24576.0);
+    maxFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(2.125);
 
-    SampleType Wn = (Xn + Wn2);
-    SampleType Yn = ((Wn * b0) + Xn2);
+    jassert(static_cast <SampleType>(20.0) >= minFreq && minFreq <= static_cast <SampleType>(20000.0));
+    jassert(static_cast <SampleType>(20.0) <= maxFreq && maxFreq >= static_cast <SampleType>(20000.0));
 
-    Xn2 = ((Wn * b1) + Xn1), Wn2 = ((Wn * a1) + Wn1);
-    Xn1 = (Wn * b2), Wn1 = (Wn * a2);
+    Smoothing::retime(frq, sampleRate, rampDurationSeconds);
+    Smoothing::retime(res, sampleRate, rampDurationSeconds);
+    Smoothing::retime(lev, sampleRate, rampDurationSeconds);
 
-    return Yn;
+    coefficients();
 }
 
 template <typename SampleType>
-SampleType Biquads<SampleType>::directFormIITransposed(int channel, SampleType inputValue)
+void Biquads<SampleType>::reset(SampleType initialValue)
 {
-    auto& Xn1 = Xn_1[(size_t)channel];
-    auto& Xn2 = Xn_2[(size_t)channel];
-
-    SampleType Xn = inputValue;
-
-    SampleType Yn = ((Xn * b0) + (Xn2));
+    std::fill(state.begin(), state.end(), initialValue);
 
-    Xn2 = ((Xn * b1) + (Xn1)+(Yn * a1));
-    Xn1 = ((Xn * b2) + (Yn * a2));
+    frq.reset(sampleRate, rampDurationSeconds);
+    res.reset(sampleRate, rampDurationSeconds);
+    lev.reset(sampleRate, rampDurationSeconds);
 
-    return Yn;
+    coefficients();
 }
 
 template <typename SampleType>
@@ -246,12 +174,9 @@ void Biquads<SampleType>::coefficients()
     SampleType omega = static_cast <SampleType>(frq.getNextValue() * ((pi * two) / sampleRate));
     SampleType cos = static_cast <SampleType>(std::cos(omega));
     SampleType sin = static_cast <SampleType>(std::sin(omega));
-    SampleType tan = static_cast <SampleType>(sin / cos);
     SampleType alpha = static_cast <SampleType>(sin * (one - res.getNextValue()));
     SampleType a = static_cast <SampleType>(juce::Decibels::decibelsToGain(static_cast<SampleType>(lev.getNextValue() * static_cast <SampleType>(0.5))));
 
-    juce::ignoreUnused(tan);
-
     auto sqrtA = (std::sqrt(a) * two) * alpha;
 
     SampleType b_0 = one;
@@ -277,12 +202,7 @@ void Biquads<SampleType>::coefficients()
 
     case filterType::lowPass1:
 
-        b_0 = omega / (one + omega);
-        b_1 = omega / (one + omega);
-        b_2 = zero;
-        a_0 = one;
-        a_1 = minusOne * ((one - omega) / (one + omega));
-        a_2 = zero;
+        FirstOrderDesign<SampleType>::design(designMode, omega, one, one, zero, b_0, b_1, a_1);
 
         break;
 
@@ -301,12 +221,7 @@ void Biquads<SampleType>::coefficients()
 
     case filterType::highPass1:
 
-        b_0 = one / (one + omega);
-        b_1 = (one / (one + omega)) * minusOne;
-        b_2 = zero;
-        a_0 = one;
-        a_1 = ((one - omega) / (one + omega)) * minusOne;
-        a_2 = zero;
+        FirstOrderDesign<SampleType>::design(designMode, omega, one, zero, one, b_0, b_1, a_1);
 
         break;
 
@@ -349,24 +264,14 @@ void Biquads<SampleType>::coefficients()
 
     case filterType::lowShelf1:
 
-        b_0 = one + ((omega / (one + omega)) * (minusOne + (a * a)));
-        b_1 = (((omega / (one + omega)) * (minusOne + (a * a))) - ((one - omega) / (one + omega)));
-        b_2 = zero;
-        a_0 = one;
-        a_1 = minusOne * ((one - omega) / (one + omega));
-        a_2 = zero;
+        FirstOrderDesign<SampleType>::design(designMode, omega, one, (a * a), one, b_0, b_1, a_1);
 
         break;
 
 
     case filterType::lowShelf1C:
 
-        b_0 = one + ((omega / a) / (one + (omega / a)) * (minusOne + (a * a)));
-        b_1 = ((((omega / a) / (one + (omega / a))) * (minusOne + (a * a))) - ((one - (omega / a)) / (one + (omega / a))));
-        b_2 = zero;
-        a_0 = one;
-        a_1 = minusOne * ((one - (omega / a)) / (one + (omega / a)));
-        a_2 = zero;
+        FirstOrderDesign<SampleType>::design(designMode, omega, (one / a), (a * a), one, b_0, b_1, a_1);
 
         break;
 
@@ -385,24 +290,14 @@ void Biquads<SampleType>::coefficients()
 
     case filterType::highShelf1:
 
-        b_0 = one + ((minusOne + (a * a)) / (one + omega));
-        b_1 = minusOne * (((one - omega) / (one + omega)) + ((minusOne + (a * a)) / (one + omega)));
-        b_2 = zero;
-        a_0 = one;
-        a_1 = minusOne * ((one - omega) / (one + omega));
-        a_2 = zero;
+        FirstOrderDesign<SampleType>::design(designMode, omega, one, one, (a * a), b_0, b_1, a_1);
 
         break;
 
 
     case filterType::highShelf1C:
 
-        b_0 = one + ((minusOne + (a * a)) / (one + (omega * a)));
-        b_1 = minusOne * (((one - (omega * a)) / (one + (omega * a))) + ((minusOne + (a * a)) / (one + (omega * a))));
-        b_2 = zero;
-        a_0 = one;
-        a_1 = minusOne * ((one - (omega * a)) / (one + (omega * a)));
-        a_2 = zero;
+        FirstOrderDesign<SampleType>::design(designMode, omega, a, one, (a * a), b_0, b_1, a_1);
 
         break;
 
@@ -466,9 +361,82 @@ void Biquads<SampleType>::coefficients()
 template <typename SampleType>
 void Biquads<SampleType>::snapToZero() noexcept
 {
-    for (auto v : { &Wn_1, &Wn_2, &Xn_1, &Xn_2, &Yn_1, &Yn_2 })
-        for (auto& element : *v)
-            juce::dsp::util::snapToZero(element);
+    // Only the registers the topology uses.
+    for (size_t i = 0; i < numChannels * numRegisters; ++i)
+        juce::dsp::util::snapToZero(state[i]);
+}
+
+template <typename SampleType>
+bool Biquads<SampleType>::hasDecayed() const noexcept
+{
+    const auto level = static_cast<SampleType>(1.0e-8);
+
+    for (size_t i = 0; i < numChannels * numRegisters; ++i)
+        if (state[i] < -level || state[i] > level)
+            return false;
+
+    return true;
+}
+
+template <typename SampleType>
+double Biquads<SampleType>::getDecaySamples(SampleType decayLevel) const noexcept
+{
+    // The poles are the roots of z^2 - a_1 z - a_2 with the negated
+    // coefficients: a complex pair of radius sqrt(-a_2), or two real poles,
+    // e.g. at a low Q, of which the larger decays the slowest.
+    const auto maxDecaySamples = sampleRate * 10.0;
+    const auto a_1 = static_cast<double>(a1), a_2 = static_cast<double>(a2);
+    const auto discriminant = (a_1 * a_1) + (4.0 * a_2);
+
+    const auto radius = discriminant >= 0.0 ? 0.5 * (std::abs(a_1) + std::sqrt(discriminant))
+                                            : std::sqrt(-a_2);
+
+    if (radius >= 1.0)
+        return maxDecaySamples;
+
+    if (radius <= std::numeric_limits<double>::epsilon())
+        return 2.0;
+
+    return juce::jmin(maxDecaySamples, std::ceil(std::log(static_cast<double>(decayLevel)) / std::log(radius)));
+}
+
+template <typename SampleType>
+std::complex<double> Biquads<SampleType>::getResponse(double omega) const noexcept
+{
+    const auto z1 = std::polar(1.0, -omega);
+    const auto z2 = z1 * z1;
+
+    const auto numerator = static_cast<double>(b0) + (static_cast<double>(b1) * z1) + (static_cast<double>(b2) * z2);
+    const auto denominator = 1.0 - (static_cast<double>(a1) * z1) - (static_cast<double>(a2) * z2);
+
+    return numerator / denominator;
+}
+
+//==============================================================================
+template <typename SampleType>
+void Biquads<SampleType>::getZeroInputResponse(int channel, SampleType& y0, SampleType& y1) const noexcept
+{
+    jassert(transformType == TransformationType::directFormIItransposed);
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+
+    // y[n] = b0.x[n] + Xn2, then Xn2 = b1.x[n] + Xn1 + a1.y[n].
+    const auto* z = state.data() + (static_cast<size_t>(channel) * 2);
+
+    y0 = z[1];
+    y1 = z[0] + (a1 * y0);
+}
+
+template <typename SampleType>
+void Biquads<SampleType>::setZeroInputResponse(int channel, SampleType y0, SampleType y1) noexcept
+{
+    jassert(transformType == TransformationType::directFormIItransposed);
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+
+    // Registers Xn1, Xn2, as SecondOrderKernel<directFormIItransposed>.
+    auto* z = state.data() + (static_cast<size_t>(channel) * 2);
+
+    z[1] = y0;
+    z[0] = y1 - (a1 * y0);
 }
 
 //==============================================================================
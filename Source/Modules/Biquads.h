@@ -13,9 +13,12 @@
 #ifndef BIQUADS_H_INCLUDED
 #define BIQUADS_H_INCLUDED
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
+#include "Transformations.h"
+#include "CoefficientDesign.h"
+#include "Smoothing.h"
 
-enum class FilterType
+enum class BiquadType
 {
     lowPass2 = 0,
     lowPass1 = 1,
@@ -34,14 +37,6 @@ enum class FilterType
     allPass = 14
 };
 
-enum class TransformationType
-{
-    directFormI = 0,
-    directFormII = 1,
-    directFormItransposed = 2,
-    directFormIItransposed = 3
-};
-
 /**
     A handy 2-pole Biquad multi-mode equalizer.
 */
@@ -51,8 +46,9 @@ class Biquads
 {
 public:
 
-    using filterType = FilterType;
+    using filterType = BiquadType;
     using transformationType = TransformationType;
+    using designType = DesignType;
 
     //==============================================================================
     /** Constructor. */
@@ -74,6 +70,11 @@ public:
     /** Sets the BiLinear Transform for the filter to use. See enum for availa ble types. */
     void setTransformType(transformationType newTransformType);
 
+    /** Sets how the first-order types are mapped to coefficients. The
+    second-order types always use the cookbook designs, which are already
+    prewarped at their centre frequency. See CoefficientDesign.h. */
+    void setDesignType(designType newDesignType);
+
     //==============================================================================
     /** Sets the length of the ramp used for smoothing parameter changes. */
     void setRampDurationSeconds(double newDurationSeconds) noexcept;
@@ -88,6 +89,10 @@ public:
     /** Initialises the processor. */
     void prepare(juce::dsp::ProcessSpec& spec);
 
+    /** Moves the filter to a new sample rate without clearing its state or
+    snapping its ramps. */
+    void setSampleRate(double newSampleRate) noexcept;
+
     /** Resets the internal state variables of the processor. */
     void reset(SampleType initialValue);
 
@@ -96,6 +101,29 @@ public:
     by sample processing.*/
     void snapToZero() noexcept;
 
+    /** Returns true once every unit-delay is within the level that
+    snapToZero() would flush. */
+    bool hasDecayed() const noexcept;
+
+    /** Returns how many samples the impulse response takes to decay below
+    decayLevel (linear), from the current pole radius. */
+    double getDecaySamples(SampleType decayLevel) const noexcept;
+
+    /** Returns the frequency response of the current coefficients at omega
+    radians per sample. */
+    std::complex<double> getResponse(double omega) const noexcept;
+
+    //==============================================================================
+    /** Returns the next two outputs of one channel for silent input. A
+    second-order section's state is fully described by these two values, so
+    they can be handed to any other realisation of the same response.
+    directFormIItransposed only. */
+    void getZeroInputResponse(int channel, SampleType& y0, SampleType& y1) const noexcept;
+
+    /** Sets one channel's state so that its next two outputs for silent input
+    are y0 and y1. directFormIItransposed only. */
+    void setZeroInputResponse(int channel, SampleType y0, SampleType y1) noexcept;
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context. */
     template <typename ProcessContext>
@@ -103,12 +131,14 @@ public:
     {
         const auto& inputBlock = context.getInputBlock();
         auto& outputBlock = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
+        const auto numBlockChannels = outputBlock.getNumChannels();
         const auto numSamples = outputBlock.getNumSamples();
         const auto len = inputBlock.getNumSamples();
 
-        jassert(inputBlock.getNumChannels() == numChannels);
+        jassert(inputBlock.getNumChannels() == numBlockChannels);
         jassert(inputBlock.getNumSamples() == numSamples);
+        jassert(numBlockChannels <= numChannels);
+        juce::ignoreUnused(numBlockChannels, numSamples);
 
         if (context.isBypassed)
         {
@@ -120,37 +150,161 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
+        switch (transformType)
         {
-            auto* inputSamples = inputBlock.getChannelPointer(channel);
-            auto* outputSamples = outputBlock.getChannelPointer(channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample((int)channel, inputSamples[i]);
+        case TransformationType::directFormI:
+            processBlock<TransformationType::directFormI>(inputBlock, outputBlock);
+            break;
+        case TransformationType::directFormII:
+            processBlock<TransformationType::directFormII>(inputBlock, outputBlock);
+            break;
+        case TransformationType::directFormItransposed:
+            processBlock<TransformationType::directFormItransposed>(inputBlock, outputBlock);
+            break;
+        case TransformationType::directFormIItransposed:
+            processBlock<TransformationType::directFormIItransposed>(inputBlock, outputBlock);
+            break;
+        default:
+            processBlock<TransformationType::directFormIItransposed>(inputBlock, outputBlock);
         }
-
-#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
-        snapToZero();
-#endif
     }
 
     //==============================================================================
     /** Processes one sample at a time on a given channel. */
-    SampleType processSample(int channel, SampleType inputValue);
+    SampleType processSample(int channel, SampleType inputValue)
+    {
+        jassert(juce::isPositiveAndBelow(channel, numChannels));
+
+        switch (transformType)
+        {
+        case TransformationType::directFormI:
+            return processSample<TransformationType::directFormI>(channel, inputValue);
+        case TransformationType::directFormII:
+            return processSample<TransformationType::directFormII>(channel, inputValue);
+        case TransformationType::directFormItransposed:
+            return processSample<TransformationType::directFormItransposed>(channel, inputValue);
+        case TransformationType::directFormIItransposed:
+            return processSample<TransformationType::directFormIItransposed>(channel, inputValue);
+        default:
+            return processSample<TransformationType::directFormIItransposed>(channel, inputValue);
+        }
+    }
+
+    /** Processes one sample on a given channel with a fixed transformation. */
+    template <TransformationType Type>
+    SampleType processSample(int channel, SampleType inputValue) noexcept
+    {
+        constexpr auto n = SecondOrderKernel<Type>::numRegisters;
+
+        return SecondOrderKernel<Type>::processSample(inputValue, state.data() + (static_cast<size_t>(channel) * n), b0, b1, b2, a1, a2);
+    }
 
     double sampleRate = 44100.0, rampDurationSeconds = 0.00005;
 
 private:
     //==============================================================================
-    void coefficients();
+    /** Processes a whole block with a fixed transformation, keeping each
+    channel's unit-delays in locals for the duration of the channel. */
+    template <TransformationType Type, typename InputBlock, typename OutputBlock>
+    void processBlock(const InputBlock& inputBlock, OutputBlock& outputBlock) noexcept
+    {
+        constexpr auto n = SecondOrderKernel<Type>::numRegisters;
+        const auto numBlockChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto b_0 = b0, b_1 = b1, b_2 = b2, a_1 = a1, a_2 = a2;
+        size_t channel = 0;
 
-    SampleType directFormI(int channel, SampleType inputValue);
+#if JUCE_USE_SIMD
+        if (numBlockChannels > 1)
+            for (; channel < numBlockChannels; channel += numLanes)
+                processLanes<Type>(inputBlock, outputBlock, channel);
+#endif
 
-    SampleType directFormII(int channel, SampleType inputValue);
+        for (; channel < numBlockChannels; ++channel)
+        {
+            auto* inputSamples = inputBlock.getChannelPointer(channel);
+            auto* outputSamples = outputBlock.getChannelPointer(channel);
+            auto* channelState = state.data() + (channel * n);
+
+            std::array<SampleType, n> z;
+            std::copy_n(channelState, n, z.begin());
+
+            for (size_t i = 0; i < numSamples; ++i)
+                outputSamples[i] = SecondOrderKernel<Type>::processSample(inputSamples[i], z.data(), b_0, b_1, b_2, a_1, a_2);
+
+            std::copy_n(z.begin(), n, channelState);
+        }
+    }
+
+#if JUCE_USE_SIMD
+    //==============================================================================
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = SIMDType::SIMDNumElements;
+
+    /** Samples per lane transposed at a time; the scratch frames stay on the stack. */
+    static constexpr size_t laneFrames = 64;
+
+    /** Processes up to numLanes channels at once, starting at firstChannel,
+    with one channel per SIMD lane. Each chunk of the block is transposed
+    once into lane-major frames, so the recursion runs on whole registers
+    rather than gathering every sample; unused lanes run on silence. */
+    template <TransformationType Type, typename InputBlock, typename OutputBlock>
+    void processLanes(const InputBlock& inputBlock, OutputBlock& outputBlock, size_t firstChannel) noexcept
+    {
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto lanes = juce::jmin(numLanes, outputBlock.getNumChannels() - firstChannel);
+        const auto b_0 = b0, b_1 = b1, b_2 = b2, a_1 = a1, a_2 = a2;
+
+        alignas(sizeof(SIMDType)) SampleType frames[laneFrames * numLanes];
+
+        constexpr auto n = SecondOrderKernel<Type>::numRegisters;
+
+        std::array<SIMDType, n> z;
+        z.fill(SIMDType::expand(zero));
 
-    SampleType directFormITransposed(int channel, SampleType inputValue);
+        for (size_t lane = 0; lane < lanes; ++lane)
+            for (size_t r = 0; r < n; ++r)
+                z[r].set(lane, state[((firstChannel + lane) * n) + r]);
 
-    SampleType directFormIITransposed(int channel, SampleType inputValue);
+        for (size_t done = 0; done < numSamples; done += laneFrames)
+        {
+            const auto numFrames = juce::jmin(laneFrames, numSamples - done);
+
+            if (lanes < numLanes)
+                std::fill_n(frames, numFrames * numLanes, zero);
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                const auto* inputSamples = inputBlock.getChannelPointer(firstChannel + lane) + done;
+
+                for (size_t i = 0; i < numFrames; ++i)
+                    frames[(i * numLanes) + lane] = inputSamples[i];
+            }
+
+            for (size_t i = 0; i < numFrames; ++i)
+            {
+                auto* frame = frames + (i * numLanes);
+
+                SecondOrderKernel<Type>::processSample(SIMDType::fromRawArray(frame), z.data(), b_0, b_1, b_2, a_1, a_2).copyToRawArray(frame);
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                auto* outputSamples = outputBlock.getChannelPointer(firstChannel + lane) + done;
+
+                for (size_t i = 0; i < numFrames; ++i)
+                    outputSamples[i] = frames[(i * numLanes) + lane];
+            }
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+            for (size_t r = 0; r < n; ++r)
+                state[((firstChannel + lane) * n) + r] = z[r].get(lane);
+    }
+#endif
+
+    //==============================================================================
+    void coefficients();
 
     //==============================================================================
     SampleType getb0() { return static_cast<SampleType>(b0); }
@@ -161,8 +315,11 @@ private:
     SampleType geta2() { return static_cast<SampleType>(a2); }
 
     //==============================================================================
-    /** Unit-delay objects. */
-    std::vector<SampleType> Wn_1, Wn_2, Xn_1, Xn_2, Yn_1, Yn_2;
+    /** Unit-delays, packed per channel with only as many registers as the
+    current topology uses; room for the largest topology is kept so that
+    switching never allocates. */
+    std::vector<SampleType> state;
+    size_t numChannels = 0, numRegisters = 2;
 
     //==============================================================================
     /** Initialise the coefficient gains. */
@@ -184,6 +341,7 @@ private:
     SampleType minFreq = 20.0, maxFreq = 20000.0, hz = 1000.0, q = 0.5, g = 0.0;
     filterType filtType = filterType::lowPass2;
     transformationType transformType = transformationType::directFormIItransposed;
+    designType designMode = designType::bilinear;
 
     //==============================================================================
     /** Initialise constants. */
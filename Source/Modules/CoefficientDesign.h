@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    CoefficientDesign.h
+    Created: 14 Oct 2026 5:12:40pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef COEFFICIENTDESIGN_H_INCLUDED
+#define COEFFICIENTDESIGN_H_INCLUDED
+
+#include <JuceHeader.h>
+
+enum class DesignType
+{
+    bilinear = 0,
+    prewarped = 1,
+    matched = 2
+};
+
+/**
+    First-order coefficient design for each DesignType.
+
+    Every first-order type in this project is the analog prototype
+
+        H(s) = (hfGain * s + dcGain * wp) / (s + wp),  wp = 2 * omega * poleScale
+
+    which is mapped to a digital one-pole, one-zero filter. wp is the
+    corner the original bilinear design has always had, so all three modes
+    agree at low frequencies and differ only towards Nyquist. The results
+    have the same sign convention as the coefficients() switches, with
+    a_0 = 1; callers normalise them as usual.
+
+    - bilinear: the original mapping, K = omega * poleScale, with no
+      frequency warping. No transcendental functions.
+    - prewarped: K = 2 * tan(omega / 2) * poleScale, which compensates the
+      warping so the corner keeps its place relative to the set frequency
+      as that approaches Nyquist. One tan() per update.
+    - matched: the pole is placed with exp(-wp) and the zero is solved so
+      that the gain at DC and at Nyquist equal the analog prototype's, which
+      keeps shelves and slopes from cramping towards Nyquist at 1x. One exp()
+      and one sqrt() per update.
+*/
+
+template <typename SampleType>
+struct FirstOrderDesign
+{
+    static void design(DesignType type, SampleType omega, SampleType poleScale, SampleType dcGain, SampleType hfGain,
+                       SampleType& b_0, SampleType& b_1, SampleType& a_1) noexcept
+    {
+        const SampleType one = static_cast<SampleType>(1.0), two = static_cast<SampleType>(2.0), half = static_cast<SampleType>(0.5);
+
+        if (type == DesignType::matched)
+        {
+            const SampleType pi = juce::MathConstants<SampleType>::pi;
+            const SampleType wp = two * omega * poleScale;
+            const SampleType p = std::exp(-wp);
+
+            const SampleType nyquistGain = std::sqrt(((hfGain * hfGain) * (pi * pi)) + ((dcGain * dcGain) * (wp * wp)))
+                                         / std::sqrt((pi * pi) + (wp * wp));
+
+            b_0 = ((dcGain * (one - p)) + (nyquistGain * (one + p))) * half;
+            b_1 = ((dcGain * (one - p)) - (nyquistGain * (one + p))) * half;
+            a_1 = -p;
+
+            return;
+        }
+
+        const SampleType K = (type == DesignType::prewarped ? two * std::tan(omega * half) : omega) * poleScale;
+        const SampleType norm = one / (one + K);
+
+        b_0 = (hfGain + (dcGain * K)) * norm;
+        b_1 = ((dcGain * K) - hfGain) * norm;
+        a_1 = -((one - K) * norm);
+    }
+};
+
+//==============================================================================
+/**
+    A first-order filter type, expressed as weights on the shelf gain.
+
+    With a the square root of the linear gain, and A = a * a:
+
+        dcGain    = dc0 + dcA * A
+        hfGain    = hf0 + hfA * A
+        poleScale = pole0 + poleA * a + poleInvA / a
+
+    so a whole batch of different types can be designed by the same
+    branch-free arithmetic.
+*/
+
+template <typename SampleType>
+struct FirstOrderPrototype
+{
+    SampleType dc0 = 1, dcA = 0, hf0 = 1, hfA = 0;
+    SampleType pole0 = 1, poleA = 0, poleInvA = 0;
+
+    SampleType getDCGain(SampleType A) const noexcept { return dc0 + (dcA * A); }
+    SampleType getHFGain(SampleType A) const noexcept { return hf0 + (hfA * A); }
+    SampleType getPoleScale(SampleType a) const noexcept { return pole0 + (poleA * a) + (poleInvA / a); }
+};
+
+//==============================================================================
+/**
+    Polynomial approximations used by FirstOrderBatch. They are branch-free,
+    so loops over them vectorise, and are accurate to a few parts in 1e7 in
+    single precision over the ranges the designers use.
+*/
+
+struct DesignMath
+{
+    /** exp(x) - 1, accurate relative to the result near 0. |x| < 20 */
+    template <typename Type>
+    static Type expm1(Type x) noexcept
+    {
+        // Taylor series on x / 32, then doubled back five times with
+        // (e^y - 1)(e^y + 1) = e^2y - 1, which keeps the relative error.
+        const Type y = x * static_cast<Type>(1.0 / 32.0);
+        Type m = y * (Type(1) + y * (Type(1.0 / 2.0) + y * (Type(1.0 / 6.0) + y * (Type(1.0 / 24.0) + y * (Type(1.0 / 120.0)
+               + y * (Type(1.0 / 720.0) + y * (Type(1.0 / 5040.0) + y * Type(1.0 / 40320.0))))))));
+
+        for (int i = 0; i < 5; ++i)
+            m = m * (Type(2) + m);
+
+        return m;
+    }
+
+    /** tan(x) for 0 <= x < 1.5, as the ratio of the sine and cosine series. */
+    template <typename Type>
+    static Type tan(Type x) noexcept
+    {
+        const Type x2 = x * x;
+        const Type one = Type(1);
+
+        const Type sin = x * (one - x2 * Type(1.0 / 6.0) * (one - x2 * Type(1.0 / 20.0) * (one - x2 * Type(1.0 / 42.0)
+                       * (one - x2 * Type(1.0 / 72.0) * (one - x2 * Type(1.0 / 110.0) * (one - x2 * Type(1.0 / 156.0)))))));
+        const Type cos = one - x2 * Type(1.0 / 2.0) * (one - x2 * Type(1.0 / 12.0) * (one - x2 * Type(1.0 / 30.0) * (one - x2 * Type(1.0 / 56.0)
+                       * (one - x2 * Type(1.0 / 90.0) * (one - x2 * Type(1.0 / 132.0) * (one - x2 * Type(1.0 / 182.0)))))));
+
+        return sin / cos;
+    }
+};
+
+//==============================================================================
+/**
+    Designs a whole EQ's first-order bands in one go.
+
+    Fill in each band's omega (radians per sample), shelf gain in dB and
+    prototype, then call design(). The inputs and results are laid out one
+    array per quantity, and every loop runs over all bands without branching,
+    so the compiler can keep the bands in SIMD lanes. Results are normalised
+    for y[n] = b0.x[n] + b1.x[n-1] + a1.y[n-1], as BiLinearFilters::getb0()
+    and friends; they match FirstOrderDesign to within the accuracy of
+    DesignMath.
+*/
+
+template <typename SampleType, size_t numBands>
+struct FirstOrderBatch
+{
+    /** Inputs. */
+    std::array<SampleType, numBands> omega {}, gainDecibels {};
+    std::array<SampleType, numBands> dc0 {}, dcA {}, hf0 {}, hfA {}, pole0 {}, poleA {}, poleInvA {};
+
+    /** Results. */
+    std::array<SampleType, numBands> b0 {}, b1 {}, a1 {};
+
+    void setPrototype(size_t band, const FirstOrderPrototype<SampleType>& prototype) noexcept
+    {
+        dc0[band] = prototype.dc0, dcA[band] = prototype.dcA;
+        hf0[band] = prototype.hf0, hfA[band] = prototype.hfA;
+        pole0[band] = prototype.pole0, poleA[band] = prototype.poleA, poleInvA[band] = prototype.poleInvA;
+    }
+
+    void design(DesignType type) noexcept
+    {
+        const SampleType one = 1, two = 2, half = static_cast<SampleType>(0.5);
+        const SampleType pi = juce::MathConstants<SampleType>::pi;
+        const SampleType gainScale = static_cast<SampleType>(std::log(10.0) / 40.0);
+
+        std::array<SampleType, numBands> dcGain, hfGain, scale;
+
+        for (size_t i = 0; i < numBands; ++i)
+        {
+            const auto a = one + DesignMath::expm1(gainDecibels[i] * gainScale);
+            const auto A = a * a;
+
+            dcGain[i] = dc0[i] + (dcA[i] * A);
+            hfGain[i] = hf0[i] + (hfA[i] * A);
+            scale[i] = pole0[i] + (poleA[i] * a) + (poleInvA[i] / a);
+        }
+
+        if (type == DesignType::matched)
+        {
+            for (size_t i = 0; i < numBands; ++i)
+            {
+                const auto wp = two * omega[i] * scale[i];
+                const auto m = DesignMath::expm1(-wp);
+
+                // p = 1 + m; written in terms of m so 1 - p stays exact.
+                const auto oneMinusP = -m;
+                const auto onePlusP = two + m;
+
+                const auto nyquistGain = std::sqrt(((hfGain[i] * hfGain[i]) * (pi * pi)) + ((dcGain[i] * dcGain[i]) * (wp * wp)))
+                                       / std::sqrt((pi * pi) + (wp * wp));
+
+                b0[i] = ((dcGain[i] * oneMinusP) + (nyquistGain * onePlusP)) * half;
+                b1[i] = ((dcGain[i] * oneMinusP) - (nyquistGain * onePlusP)) * half;
+                a1[i] = one + m;
+            }
+
+            return;
+        }
+
+        std::array<SampleType, numBands> warped;
+
+        if (type == DesignType::prewarped)
+            for (size_t i = 0; i < numBands; ++i)
+                warped[i] = two * DesignMath::tan(omega[i] * half);
+        else
+            warped = omega;
+
+        for (size_t i = 0; i < numBands; ++i)
+        {
+            const auto K = warped[i] * scale[i];
+            const auto norm = one / (one + K);
+
+            b0[i] = (hfGain[i] + (dcGain[i] * K)) * norm;
+            b1[i] = ((dcGain[i] * K) - hfGain[i]) * norm;
+            a1[i] = (one - K) * norm;
+        }
+    }
+};
+
+#endif //COEFFICIENTDESIGN_H_INCLUDED
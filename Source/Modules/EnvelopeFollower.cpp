@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    EnvelopeFollower.cpp
+    Created: 14 Oct 2026 11:48:20pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "EnvelopeFollower.h"
+
+template <typename SampleType>
+EnvelopeFollower<SampleType>::EnvelopeFollower()
+{
+    // The detector only needs to hear the band, so it follows its frequency
+    // straight away rather than gliding there.
+    detector.setFilterType(FilterType::lowPass);
+    detector.setTransformType(TransformationType::directFormIItransposed);
+    detector.setRampDurationSeconds(0.0);
+
+    coefficients();
+}
+
+//==============================================================================
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::setFilterType(filterType newFiltType)
+{
+    jassert(newFiltType == FilterType::lowPass || newFiltType == FilterType::highPass);
+
+    detector.setFilterType(newFiltType);
+}
+
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::setFrequency(SampleType newFreq)
+{
+    detector.setFrequency(newFreq);
+}
+
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::setAttack(SampleType newAttackSeconds) noexcept
+{
+    if (attackSeconds != newAttackSeconds)
+    {
+        attackSeconds = newAttackSeconds;
+        coefficients();
+    }
+}
+
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::setRelease(SampleType newReleaseSeconds) noexcept
+{
+    if (releaseSeconds != newReleaseSeconds)
+    {
+        releaseSeconds = newReleaseSeconds;
+        coefficients();
+    }
+}
+
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::setInterval(int newInterval) noexcept
+{
+    jassert(newInterval > 0);
+
+    newInterval = juce::jmax(1, newInterval);
+
+    if (interval != newInterval)
+    {
+        interval = newInterval;
+        coefficients();
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    numStateChannels = static_cast<size_t>(spec.numChannels);
+
+    detector.prepare(spec);
+    coefficients();
+
+    reset();
+}
+
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::reset()
+{
+    detector.reset(static_cast<SampleType>(0.0));
+
+    envelope = peak = static_cast<SampleType>(0.0);
+    samplesToTick = interval;
+}
+
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::skip(int numSamples) noexcept
+{
+    while (numSamples > 0)
+    {
+        const auto span = juce::jmin(numSamples, samplesToTick);
+
+        advance(span);
+        numSamples -= span;
+    }
+}
+
+template <typename SampleType>
+SampleType EnvelopeFollower<SampleType>::getLevelDecibels() const noexcept
+{
+    return juce::Decibels::gainToDecibels(envelope, static_cast<SampleType>(-100.0));
+}
+
+//==============================================================================
+template <typename SampleType>
+bool EnvelopeFollower<SampleType>::advance(int numSamples) noexcept
+{
+    samplesToTick -= numSamples;
+
+    if (samplesToTick > 0)
+        return false;
+
+    const auto coefficient = peak > envelope ? attackCoefficient : releaseCoefficient;
+
+    envelope = peak + (coefficient * (envelope - peak));
+    peak = static_cast<SampleType>(0.0);
+    samplesToTick = interval;
+
+    return true;
+}
+
+template <typename SampleType>
+void EnvelopeFollower<SampleType>::coefficients() noexcept
+{
+    // One step per period, so the time constants come out in seconds
+    // whatever the period.
+    const auto periodSeconds = static_cast<double>(interval) / sampleRate;
+
+    auto getCoefficient = [periodSeconds](SampleType seconds)
+    {
+        if (seconds <= static_cast<SampleType>(0.0))
+            return static_cast<SampleType>(0.0);
+
+        return static_cast<SampleType>(std::exp(-periodSeconds / static_cast<double>(seconds)));
+    };
+
+    attackCoefficient = getCoefficient(attackSeconds);
+    releaseCoefficient = getCoefficient(releaseSeconds);
+}
+
+//==============================================================================
+template class EnvelopeFollower<float>;
+template class EnvelopeFollower<double>;
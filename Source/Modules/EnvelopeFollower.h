@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    EnvelopeFollower.h
+    Created: 14 Oct 2026 11:48:20pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef ENVELOPEFOLLOWER_H_INCLUDED
+#define ENVELOPEFOLLOWER_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "BiLinearFilters.h"
+
+/**
+    A peak envelope follower whose ballistics run at a decimated control
+    rate.
+
+    The detector hears its input through a one-pole BiLinearFilters, so a
+    lowPass or highPass at a shelf's frequency follows only that shelf's
+    band. The rectified peak across every channel is collected for one
+    control period of interval samples, and only then taken through the
+    attack or release; the level holds until the next period ends. The
+    per-sample cost is one first-order section and a compare per channel.
+*/
+
+template <typename SampleType>
+class EnvelopeFollower
+{
+public:
+    using filterType = FilterType;
+    //==============================================================================
+    /** Constructor. */
+    EnvelopeFollower();
+
+    //==============================================================================
+    /** Sets the detector's band filter. lowPass or highPass only. */
+    void setFilterType(filterType newFiltType);
+
+    /** Sets the corner frequency of the detector's band filter. Range = 20..20000 */
+    void setFrequency(SampleType newFreq);
+
+    /** Sets the attack and release times in seconds. */
+    void setAttack(SampleType newAttackSeconds) noexcept;
+    void setRelease(SampleType newReleaseSeconds) noexcept;
+
+    /** Sets the control period in samples. The current period keeps its
+    length; the new one starts with the next. */
+    void setInterval(int newInterval) noexcept;
+
+    /** Returns the control period in samples. */
+    int getInterval() const noexcept { return interval; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Resets the detector and the level to silence. */
+    void reset();
+
+    //==============================================================================
+    /** Returns how many more samples complete the current control period. */
+    int getSamplesToNextTick() const noexcept { return samplesToTick; }
+
+    /** Feeds every channel of the block to the detector. The block must not
+    run past the end of the current period; returns true if it completes the
+    period, so the level has moved. */
+    template <typename BlockType>
+    bool process(const BlockType& block) noexcept
+    {
+        const auto numChannels = block.getNumChannels();
+        const auto numSamples = block.getNumSamples();
+
+        jassert(numSamples <= static_cast<size_t>(samplesToTick));
+        jassert(numChannels <= numStateChannels);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* samples = block.getChannelPointer(channel);
+            auto channelPeak = peak;
+
+            for (size_t i = 0; i < numSamples; ++i)
+                channelPeak = juce::jmax(channelPeak, std::abs(detector.template processSample<TransformationType::directFormIItransposed>(static_cast<int>(channel), samples[i])));
+
+            peak = channelPeak;
+        }
+
+        return advance(static_cast<int>(numSamples));
+    }
+
+    /** Advances by numSamples of silence, releasing the level as it goes. */
+    void skip(int numSamples) noexcept;
+
+    /** Returns the level at the end of the last control period, in dB. */
+    SampleType getLevelDecibels() const noexcept;
+
+private:
+    //==============================================================================
+    /** Counts down the period; at its end, takes the collected peak through
+    the ballistics and starts the next period. */
+    bool advance(int numSamples) noexcept;
+
+    /** Recalculates the per-period attack and release coefficients. */
+    void coefficients() noexcept;
+
+    //==============================================================================
+    BiLinearFilters<SampleType> detector;
+    size_t numStateChannels = 0;
+
+    //==============================================================================
+    /** Level, the peak collected so far this period, and the ballistics. */
+    SampleType envelope = 0.0, peak = 0.0;
+    SampleType attackCoefficient = 0.0, releaseCoefficient = 0.0;
+
+    //==============================================================================
+    /** Initialise the parameters. */
+    SampleType attackSeconds = 0.01, releaseSeconds = 0.15;
+    double sampleRate = 44100.0;
+    int interval = 32, samplesToTick = 32;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeFollower)
+};
+
+#endif //ENVELOPEFOLLOWER_H_INCLUDED
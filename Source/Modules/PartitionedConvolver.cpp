@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+    PartitionedConvolver.cpp
+    Created: 14 Oct 2026 8:40:12pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "PartitionedConvolver.h"
+
+namespace
+{
+    /** Returns n such that 2^n == value, for a power of two. */
+    int getOrder(int value) noexcept
+    {
+        jassert(value > 0 && (value & (value - 1)) == 0);
+
+        int order = 0;
+
+        while ((1 << order) < value)
+            ++order;
+
+        return order;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+PartitionedConvolver<SampleType>::PartitionedConvolver()
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void PartitionedConvolver<SampleType>::prepare(int numChannels, int newMaxKernelLength, int newMinPartitionSize, int newMaxPartitionSize)
+{
+    jassert(numChannels > 0);
+    jassert(newMaxKernelLength > 0);
+    jassert(0 < newMinPartitionSize && newMinPartitionSize <= newMaxPartitionSize);
+
+    maxKernelLength = newMaxKernelLength;
+    minPartitionSize = newMinPartitionSize;
+    maxPartitionSize = newMaxPartitionSize;
+
+    audioFFTs.clear();
+    writerFFTs.clear();
+
+    for (auto order = getOrder(minPartitionSize); order <= getOrder(maxPartitionSize); ++order)
+    {
+        audioFFTs.push_back(std::make_unique<juce::dsp::FFT>(order + 1));
+        writerFFTs.push_back(std::make_unique<juce::dsp::FFT>(order + 1));
+    }
+
+    // The smallest partition needs the most spectrum space: each partition
+    // of P samples stores P + 1 complex bins.
+    const auto maxPartitions = static_cast<size_t>((maxKernelLength + minPartitionSize - 1) / minPartitionSize);
+    const auto spectraSize = maxPartitions * static_cast<size_t>(2 * (minPartitionSize + 1));
+    const auto workSize = static_cast<size_t>(4 * maxPartitionSize);
+
+    for (auto& kernel : kernels.getSlots())
+    {
+        kernel.spectra.assign(spectraSize, 0.0f);
+        kernel.partitionSize = 0, kernel.numPartitions = 0, kernel.length = 0, kernel.latency = 0;
+    }
+
+    channels.resize(static_cast<size_t>(numChannels));
+
+    for (auto& state : channels)
+    {
+        state.input.assign(static_cast<size_t>(2 * maxPartitionSize), 0.0f);
+        state.output.assign(static_cast<size_t>(maxPartitionSize), 0.0f);
+        state.history.assign(spectraSize, 0.0f);
+    }
+
+    spectrum.assign(workSize, 0.0f);
+    accumulator.assign(workSize, 0.0f);
+    writerSpectrum.assign(workSize, 0.0f);
+    crossfadeOutput.assign(static_cast<size_t>(maxPartitionSize), 0.0f);
+
+    partitionSize = 0;
+    fft = nullptr;
+}
+
+template <typename SampleType>
+void PartitionedConvolver<SampleType>::setKernel(const float* impulse, int length, int newPartitionSize, int kernelLatency) noexcept
+{
+    jassert(minPartitionSize <= newPartitionSize && newPartitionSize <= maxPartitionSize);
+    jassert(0 < length && length <= maxKernelLength);
+
+    newPartitionSize = juce::jlimit(minPartitionSize, maxPartitionSize, newPartitionSize);
+    length = juce::jlimit(1, maxKernelLength, length);
+
+    auto& kernel = kernels.getWriteSlot();
+    auto& writerFFT = *writerFFTs[getFFTIndex(newPartitionSize)];
+    const auto stride = static_cast<size_t>(2 * (newPartitionSize + 1));
+
+    kernel.partitionSize = newPartitionSize;
+    kernel.numPartitions = (length + newPartitionSize - 1) / newPartitionSize;
+    kernel.length = length;
+    kernel.latency = kernelLatency;
+
+    for (int k = 0; k < kernel.numPartitions; ++k)
+    {
+        const auto offset = k * newPartitionSize;
+        const auto numToCopy = juce::jmin(newPartitionSize, length - offset);
+
+        std::fill(writerSpectrum.begin(), writerSpectrum.end(), 0.0f);
+        std::copy_n(impulse + offset, numToCopy, writerSpectrum.begin());
+
+        writerFFT.performRealOnlyForwardTransform(writerSpectrum.data(), true);
+
+        std::copy_n(writerSpectrum.begin(), stride, kernel.spectra.begin() + static_cast<std::ptrdiff_t>(static_cast<size_t>(k) * stride));
+    }
+
+    kernels.publish();
+}
+
+//==============================================================================
+template <typename SampleType>
+void PartitionedConvolver<SampleType>::reset() noexcept
+{
+    start();
+}
+
+template <typename SampleType>
+void PartitionedConvolver<SampleType>::start() noexcept
+{
+    const auto& kernel = kernels.acquire();
+
+    partitionSize = kernel.partitionSize;
+    fft = partitionSize > 0 ? audioFFTs[getFFTIndex(partitionSize)].get() : nullptr;
+    historySize = partitionSize > 0 ? (maxKernelLength + partitionSize - 1) / partitionSize : 0;
+    historyPosition = 0;
+    position = 0;
+    quietPartitions = kernel.numPartitions + 1;
+
+    for (auto& state : channels)
+    {
+        std::fill(state.input.begin(), state.input.end(), 0.0f);
+        std::fill(state.output.begin(), state.output.end(), 0.0f);
+        std::fill(state.history.begin(), state.history.end(), 0.0f);
+    }
+}
+
+template <typename SampleType>
+bool PartitionedConvolver<SampleType>::hasDecayed() const noexcept
+{
+    return quietPartitions > kernels.getReadSlot().numPartitions;
+}
+
+//==============================================================================
+template <typename SampleType>
+int PartitionedConvolver<SampleType>::getLatencySamples() const noexcept
+{
+    const auto& kernel = kernels.getReadSlot();
+
+    return kernel.partitionSize + kernel.latency;
+}
+
+template <typename SampleType>
+int PartitionedConvolver<SampleType>::getKernelLength() const noexcept
+{
+    return kernels.getReadSlot().length;
+}
+
+//==============================================================================
+template <typename SampleType>
+void PartitionedConvolver<SampleType>::processPartition(size_t numChannels) noexcept
+{
+    const auto size = static_cast<size_t>(partitionSize);
+    const auto stride = 2 * (size + 1);
+    auto isQuiet = true;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto& state = channels[channel];
+
+        for (size_t i = size; i < 2 * size; ++i)
+            isQuiet = isQuiet && std::abs(state.input[i]) <= 1.0e-8f;
+
+        // Previous and current partition in, one spectrum into the delay line.
+        std::fill(spectrum.begin() + static_cast<std::ptrdiff_t>(2 * size), spectrum.end(), 0.0f);
+        std::copy_n(state.input.begin(), 2 * size, spectrum.begin());
+
+        fft->performRealOnlyForwardTransform(spectrum.data(), true);
+
+        std::copy_n(spectrum.begin(), stride, state.history.begin() + static_cast<std::ptrdiff_t>(static_cast<size_t>(historyPosition) * stride));
+        std::copy_n(state.input.begin() + static_cast<std::ptrdiff_t>(size), size, state.input.begin());
+
+        convolve(state, kernels.getReadSlot(), state.output.data());
+    }
+
+    if (kernels.hasFresh())
+    {
+        const auto& kernel = kernels.acquire();
+
+        if (kernel.partitionSize != partitionSize)
+        {
+            start();
+            return;
+        }
+
+        const auto ramp = 1.0f / static_cast<float>(size);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto& state = channels[channel];
+
+            convolve(state, kernel, crossfadeOutput.data());
+
+            for (size_t i = 0; i < size; ++i)
+                state.output[i] += (crossfadeOutput[i] - state.output[i]) * (static_cast<float>(i + 1) * ramp);
+        }
+    }
+
+    historyPosition = (historyPosition + 1) % historySize;
+    quietPartitions = isQuiet ? juce::jmin(quietPartitions + 1, historySize + 1) : 0;
+}
+
+template <typename SampleType>
+void PartitionedConvolver<SampleType>::convolve(const Channel& state, const Kernel& kernel, float* destination) noexcept
+{
+    const auto size = static_cast<size_t>(partitionSize);
+    const auto bins = size + 1;
+    const auto stride = 2 * bins;
+
+    std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+
+    auto* acc = accumulator.data();
+
+    for (int k = 0; k < kernel.numPartitions; ++k)
+    {
+        const auto slot = static_cast<size_t>((historyPosition + historySize - k) % historySize);
+        const auto* x = state.history.data() + (slot * stride);
+        const auto* h = kernel.spectra.data() + (static_cast<size_t>(k) * stride);
+
+        for (size_t b = 0; b < stride; b += 2)
+        {
+            acc[b] += (x[b] * h[b]) - (x[b + 1] * h[b + 1]);
+            acc[b + 1] += (x[b] * h[b + 1]) + (x[b + 1] * h[b]);
+        }
+    }
+
+    fft->performRealOnlyInverseTransform(acc);
+
+    // Overlap-save: the first half is wrapped around, the second is valid.
+    std::copy_n(acc + size, size, destination);
+}
+
+template <typename SampleType>
+size_t PartitionedConvolver<SampleType>::getFFTIndex(int newPartitionSize) const noexcept
+{
+    return static_cast<size_t>(getOrder(newPartitionSize) - getOrder(minPartitionSize));
+}
+
+//==============================================================================
+template class PartitionedConvolver<float>;
+template class PartitionedConvolver<double>;
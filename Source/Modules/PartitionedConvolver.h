@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+    PartitionedConvolver.h
+    Created: 14 Oct 2026 8:40:12pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PARTITIONEDCONVOLVER_H_INCLUDED
+#define PARTITIONEDCONVOLVER_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "TripleBuffer.h"
+
+/**
+    Uniformly partitioned FFT convolution with kernels swapped lock-free.
+
+    The kernel is cut into partitions of partitionSize samples, each
+    transformed once at FFT size 2 * partitionSize. Every partitionSize
+    input samples, the newest input is transformed once and multiplied with
+    each kernel partition against a delay line of past input spectra
+    (overlap-save), so the cost per sample grows with the number of
+    partitions rather than the kernel length. The output is delayed by
+    exactly one partition.
+
+    A writer thread designs kernels and hands them over with setKernel(); the
+    audio thread picks up the newest one at the next partition boundary and
+    crossfades to it over one partition. A kernel with a different partition
+    size restarts the convolution, since the delay line no longer fits.
+
+    The FFTs run in single precision whatever the SampleType.
+*/
+
+template <typename SampleType>
+class PartitionedConvolver
+{
+public:
+    //==============================================================================
+    /** Constructor. */
+    PartitionedConvolver();
+
+    //==============================================================================
+    /** Allocates everything needed for kernels up to maxKernelLength samples,
+    at any power-of-two partition size from minPartitionSize to
+    maxPartitionSize. Neither the audio thread nor the writer may be running.
+    Clears the current kernel, so the output is silent until the next
+    setKernel() and reset(). */
+    void prepare(int numChannels, int maxKernelLength, int minPartitionSize, int maxPartitionSize);
+
+    /** Writer thread only. Transforms the first length samples of impulse and
+    publishes them as the next kernel. kernelLatency is the delay of the
+    kernel itself, e.g. half its length for a linear-phase filter, and is
+    reported on top of the partition's delay. */
+    void setKernel(const float* impulse, int length, int partitionSize, int kernelLatency) noexcept;
+
+    //==============================================================================
+    /** Clears the convolution state and takes the newest kernel, if any. */
+    void reset() noexcept;
+
+    /** Returns true once the input has been silent for long enough that
+    nothing remains in the delay line or the output. */
+    bool hasDecayed() const noexcept;
+
+    //==============================================================================
+    /** Returns the delay of the current kernel through the convolver, in
+    samples: one partition plus the kernel's own latency. */
+    int getLatencySamples() const noexcept;
+
+    /** Returns the length of the current kernel in samples. */
+    int getKernelLength() const noexcept;
+
+    /** Returns the partition size of the current kernel; 0 if there is none. */
+    int getPartitionSize() const noexcept { return partitionSize; }
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert(inputBlock.getNumChannels() == numChannels);
+        jassert(inputBlock.getNumSamples() == numSamples);
+        jassert(numChannels <= channels.size());
+
+        if (partitionSize == 0 && kernels.hasFresh())
+            start();
+
+        if (partitionSize == 0)
+        {
+            outputBlock.clear();
+            return;
+        }
+
+        for (size_t done = 0; done < numSamples;)
+        {
+            const auto numToDo = juce::jmin(numSamples - done, static_cast<size_t>(partitionSize - position));
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* inputSamples = inputBlock.getChannelPointer(channel) + done;
+                auto* outputSamples = outputBlock.getChannelPointer(channel) + done;
+                auto* currentInput = channels[channel].input.data() + partitionSize + position;
+                const auto* readyOutput = channels[channel].output.data() + position;
+
+                // Read before writing, as the blocks may be the same.
+                for (size_t i = 0; i < numToDo; ++i)
+                {
+                    const auto x = static_cast<float>(inputSamples[i]);
+                    outputSamples[i] = static_cast<SampleType>(readyOutput[i]);
+                    currentInput[i] = x;
+                }
+            }
+
+            position += static_cast<int>(numToDo);
+            done += numToDo;
+
+            if (position == partitionSize)
+            {
+                processPartition(numChannels);
+                position = 0;
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Kernel
+    {
+        /** Spectra of each partition, (partitionSize + 1) complex bins apiece. */
+        std::vector<float> spectra;
+        int partitionSize = 0, numPartitions = 0, length = 0, latency = 0;
+    };
+
+    struct Channel
+    {
+        /** The previous and the current partition of input. */
+        std::vector<float> input;
+
+        /** The output being played out during the current partition. */
+        std::vector<float> output;
+
+        /** Ring of past input spectra. */
+        std::vector<float> history;
+    };
+
+    //==============================================================================
+    /** Takes the newest kernel and starts again from silence at its partition
+    size. */
+    void start() noexcept;
+
+    /** Transforms the partition just collected and computes the next
+    partition of output, crossfading to a new kernel if one is waiting. */
+    void processPartition(size_t numChannels) noexcept;
+
+    /** Multiplies the delay line with every partition of the kernel and
+    writes the resulting partitionSize samples of output to destination. */
+    void convolve(const Channel& state, const Kernel& kernel, float* destination) noexcept;
+
+    /** Returns the index into the FFT arrays for a given partition size. */
+    size_t getFFTIndex(int newPartitionSize) const noexcept;
+
+    //==============================================================================
+    TripleBuffer<Kernel> kernels;
+    std::vector<Channel> channels;
+
+    /** FFTs of size 2 * partitionSize for every supported partition size;
+    the writer has its own set. */
+    std::vector<std::unique_ptr<juce::dsp::FFT>> audioFFTs, writerFFTs;
+    juce::dsp::FFT* fft { nullptr };
+
+    /** Scratch space for the transforms, 4 * maxPartitionSize floats each. */
+    std::vector<float> spectrum, accumulator, writerSpectrum;
+    std::vector<float> crossfadeOutput;
+
+    int maxKernelLength = 0, minPartitionSize = 0, maxPartitionSize = 0;
+    int partitionSize = 0, position = 0;
+    int historySize = 0, historyPosition = 0;
+    int quietPartitions = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartitionedConvolver)
+};
+
+#endif //PARTITIONEDCONVOLVER_H_INCLUDED
@@ -0,0 +1,353 @@
+/*
+  ==============================================================================
+
+    PeakCascade.cpp
+    Created: 14 Oct 2026 11:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "PeakCascade.h"
+
+template <typename SampleType>
+PeakCascade<SampleType>::PeakCascade()
+{
+    const auto zero = static_cast<SampleType>(0.0), one = static_cast<SampleType>(1.0);
+
+    b0.fill(one), b1.fill(zero), b2.fill(zero), a1.fill(zero), a2.fill(zero);
+    nextb0 = b0, nextb1 = b1, nextb2 = b2, nexta1 = a1, nexta2 = a2;
+    incb0.fill(zero), incb1.fill(zero), incb2.fill(zero), inca1.fill(zero), inca2.fill(zero);
+
+    targetFrequency.fill(static_cast<SampleType>(1000.0));
+    targetGain.fill(zero);
+    targetQ.fill(static_cast<SampleType>(0.70710678118654752440));
+
+    tailSamples.fill(0.0);
+    skipped.fill(true);
+
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void PeakCascade<SampleType>::setBand(size_t band, SampleType newFrequency, SampleType newGainDecibels, SampleType newQ) noexcept
+{
+    jassert(band < maxBands);
+    jassert(newFrequency > static_cast<SampleType>(0.0) && newQ > static_cast<SampleType>(0.0));
+
+    targetFrequency[band] = newFrequency;
+    targetGain[band] = std::abs(newGainDecibels) <= static_cast<SampleType>(identityDecibels) ? static_cast<SampleType>(0.0) : newGainDecibels;
+    targetQ[band] = newQ;
+
+    applyTargets(band);
+}
+
+template <typename SampleType>
+void PeakCascade<SampleType>::setNumBands(size_t newNumBands) noexcept
+{
+    newNumBands = juce::jmin(newNumBands, maxBands);
+
+    if (numBands == newNumBands)
+        return;
+
+    numBands = newNumBands;
+
+    for (size_t band = 0; band < maxBands; ++band)
+        applyTargets(band);
+}
+
+template <typename SampleType>
+void PeakCascade<SampleType>::applyTargets(size_t band) noexcept
+{
+    const auto heardGain = band < numBands ? targetGain[band] : static_cast<SampleType>(0.0);
+
+    // A skipped band is silent state at 0 dB, so it can jump to its new
+    // shape and fade in on the gain alone.
+    if (skipped[band])
+    {
+        frequency[band].setCurrentAndTargetValue(targetFrequency[band]);
+        q[band].setCurrentAndTargetValue(targetQ[band]);
+        gain[band].setCurrentAndTargetValue(static_cast<SampleType>(0.0));
+    }
+
+    frequency[band].setTargetValue(targetFrequency[band]);
+    q[band].setTargetValue(targetQ[band]);
+    gain[band].setTargetValue(heardGain);
+}
+
+//==============================================================================
+template <typename SampleType>
+void PeakCascade<SampleType>::setRampDurationSeconds(double newDurationSeconds) noexcept
+{
+    if (rampDurationSeconds != newDurationSeconds)
+    {
+        rampDurationSeconds = newDurationSeconds;
+
+        for (size_t band = 0; band < maxBands; ++band)
+        {
+            Smoothing::retime(frequency[band], sampleRate, rampDurationSeconds);
+            Smoothing::retime(q[band], sampleRate, rampDurationSeconds);
+            Smoothing::retime(gain[band], sampleRate, rampDurationSeconds);
+        }
+    }
+}
+
+template <typename SampleType>
+double PeakCascade<SampleType>::getRampDurationSeconds() const noexcept
+{
+    return rampDurationSeconds;
+}
+
+//==============================================================================
+template <typename SampleType>
+void PeakCascade<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    numStateChannels = static_cast<size_t>(spec.numChannels);
+
+    // Keep the largest state seen, so a later prepare doesn't allocate.
+    if (state.size() < numStateChannels * maxBands * n)
+        state.resize(numStateChannels * maxBands * n);
+
+    reset();
+}
+
+template <typename SampleType>
+void PeakCascade<SampleType>::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+
+    sampleRate = newSampleRate;
+
+    const auto maxFrequency = static_cast<SampleType>(sampleRate / 2.125);
+
+    for (size_t band = 0; band < maxBands; ++band)
+    {
+        Smoothing::retime(frequency[band], sampleRate, rampDurationSeconds);
+        Smoothing::retime(q[band], sampleRate, rampDurationSeconds);
+        Smoothing::retime(gain[band], sampleRate, rampDurationSeconds);
+
+        if (skipped[band])
+            continue;
+
+        design(sampleRate, juce::jmin(frequency[band].getCurrentValue(), maxFrequency), gain[band].getCurrentValue(), q[band].getCurrentValue(),
+               nextb0[band], nextb1[band], nextb2[band], nexta1[band], nexta2[band]);
+
+        b0[band] = nextb0[band], b1[band] = nextb1[band], b2[band] = nextb2[band];
+        a1[band] = nexta1[band], a2[band] = nexta2[band];
+
+        tailSamples[band] = getDecaySamples(a1[band], a2[band]);
+    }
+}
+
+template <typename SampleType>
+void PeakCascade<SampleType>::reset()
+{
+    std::fill(state.begin(), state.end(), static_cast<SampleType>(0.0));
+
+    // Start on the current settings rather than ramping towards them.
+    for (size_t band = 0; band < maxBands; ++band)
+    {
+        const auto heardGain = band < numBands ? targetGain[band] : static_cast<SampleType>(0.0);
+
+        frequency[band].reset(sampleRate, rampDurationSeconds);
+        q[band].reset(sampleRate, rampDurationSeconds);
+        gain[band].reset(sampleRate, rampDurationSeconds);
+
+        frequency[band].setCurrentAndTargetValue(targetFrequency[band]);
+        q[band].setCurrentAndTargetValue(targetQ[band]);
+        gain[band].setCurrentAndTargetValue(heardGain);
+
+        skipped[band] = heardGain == static_cast<SampleType>(0.0);
+        tailSamples[band] = 0.0;
+
+        if (skipped[band])
+            clearBand(band);
+        else
+            design(sampleRate, juce::jmin(targetFrequency[band], static_cast<SampleType>(sampleRate / 2.125)), heardGain, targetQ[band],
+                   nextb0[band], nextb1[band], nextb2[band], nexta1[band], nexta2[band]);
+    }
+
+    b0 = nextb0, b1 = nextb1, b2 = nextb2, a1 = nexta1, a2 = nexta2;
+
+    numActiveBands = 0;
+
+    for (size_t band = 0; band < maxBands; ++band)
+        if (! skipped[band])
+            activeBands[numActiveBands++] = band;
+}
+
+template <typename SampleType>
+void PeakCascade<SampleType>::snapToZero() noexcept
+{
+    for (auto& value : state)
+        juce::dsp::util::snapToZero(value);
+}
+
+template <typename SampleType>
+bool PeakCascade<SampleType>::hasDecayed() const noexcept
+{
+    // The same threshold juce::dsp::util::snapToZero() flushes below.
+    const auto threshold = static_cast<SampleType>(1.0e-8);
+
+    for (auto value : state)
+        if (value < -threshold || value > threshold)
+            return false;
+
+    return true;
+}
+
+template <typename SampleType>
+void PeakCascade<SampleType>::skip(int numSamples) noexcept
+{
+    const auto maxFrequency = static_cast<SampleType>(sampleRate / 2.125);
+
+    // Nothing is ramped through, so any band that moved takes its new
+    // coefficients straight away.
+    for (size_t band = 0; band < maxBands; ++band)
+    {
+        if (! (frequency[band].isSmoothing() || q[band].isSmoothing() || gain[band].isSmoothing()))
+            continue;
+
+        design(sampleRate, juce::jmin(frequency[band].skip(numSamples), maxFrequency), gain[band].skip(numSamples), q[band].skip(numSamples),
+               nextb0[band], nextb1[band], nextb2[band], nexta1[band], nexta2[band]);
+
+        b0[band] = nextb0[band], b1[band] = nextb1[band], b2[band] = nextb2[band];
+        a1[band] = nexta1[band], a2[band] = nexta2[band];
+
+        tailSamples[band] = getDecaySamples(a1[band], a2[band]);
+        skipped[band] = false;
+    }
+}
+
+template <typename SampleType>
+double PeakCascade<SampleType>::getTailSamples() const noexcept
+{
+    // The bands ring out one after another, so their decays add up.
+    double tail = 0.0;
+
+    for (size_t k = 0; k < numActiveBands; ++k)
+        tail += getDecaySamples(a1[activeBands[k]], a2[activeBands[k]]);
+
+    return tail;
+}
+
+//==============================================================================
+template <typename SampleType>
+bool PeakCascade<SampleType>::isSmoothing() const noexcept
+{
+    for (size_t band = 0; band < maxBands; ++band)
+        if (frequency[band].isSmoothing() || q[band].isSmoothing() || gain[band].isSmoothing())
+            return true;
+
+    return false;
+}
+
+template <typename SampleType>
+bool PeakCascade<SampleType>::loadCoefficients(size_t numSamples) noexcept
+{
+    const auto zero = static_cast<SampleType>(0.0);
+    const auto scale = static_cast<SampleType>(1.0) / static_cast<SampleType>(juce::jmax(numSamples, static_cast<size_t>(1)));
+    const auto maxFrequency = static_cast<SampleType>(sampleRate / 2.125);
+    bool ramping = false;
+
+    numActiveBands = 0;
+
+    for (size_t band = 0; band < maxBands; ++band)
+    {
+        incb0[band] = incb1[band] = incb2[band] = inca1[band] = inca2[band] = zero;
+
+        const auto smoothing = frequency[band].isSmoothing() || q[band].isSmoothing() || gain[band].isSmoothing();
+
+        if (skipped[band])
+        {
+            if (! smoothing)
+                continue;
+
+            // The state was cleared when the band was skipped, so it
+            // restarts at exactly 0 dB and ramps from there.
+            skipped[band] = false;
+        }
+
+        if (smoothing)
+        {
+            const auto steps = static_cast<int>(numSamples);
+
+            design(sampleRate, juce::jmin(frequency[band].skip(steps), maxFrequency), gain[band].skip(steps), q[band].skip(steps),
+                   nextb0[band], nextb1[band], nextb2[band], nexta1[band], nexta2[band]);
+
+            incb0[band] = (nextb0[band] - b0[band]) * scale;
+            incb1[band] = (nextb1[band] - b1[band]) * scale;
+            incb2[band] = (nextb2[band] - b2[band]) * scale;
+            inca1[band] = (nexta1[band] - a1[band]) * scale;
+            inca2[band] = (nexta2[band] - a2[band]) * scale;
+
+            tailSamples[band] = getDecaySamples(nexta1[band], nexta2[band]);
+            ramping = true;
+        }
+
+        // Resting at 0 dB: let whatever the poles still hold ring out
+        // before dropping the band, so skipping it is inaudible.
+        else if (gain[band].getCurrentValue() == zero)
+        {
+            tailSamples[band] -= static_cast<double>(numSamples);
+
+            if (tailSamples[band] <= 0.0)
+            {
+                skipped[band] = true;
+                clearBand(band);
+                continue;
+            }
+        }
+
+        activeBands[numActiveBands++] = band;
+    }
+
+    return ramping;
+}
+
+template <typename SampleType>
+void PeakCascade<SampleType>::clearBand(size_t band) noexcept
+{
+    const auto zero = static_cast<SampleType>(0.0);
+
+    for (size_t channel = 0; channel < numStateChannels; ++channel)
+        std::fill_n(state.begin() + static_cast<std::ptrdiff_t>(((channel * maxBands) + band) * n), n, zero);
+
+    // An exact identity, so a ramp back in starts from a cancelled pole
+    // pair whatever shape the band had.
+    b0[band] = nextb0[band] = static_cast<SampleType>(1.0);
+    b1[band] = b2[band] = a1[band] = a2[band] = zero;
+    nextb1[band] = nextb2[band] = nexta1[band] = nexta2[band] = zero;
+}
+
+template <typename SampleType>
+double PeakCascade<SampleType>::getDecaySamples(SampleType negatedA1, SampleType negatedA2) const noexcept
+{
+    // The poles are the roots of z^2 - a_1 z - a_2 in the negated form: a
+    // complex pair of radius sqrt(-a_2), or, once Q times A is down to 1/2
+    // or less, two real poles, of which the larger decays the slowest.
+    const auto maxDecaySamples = sampleRate * 10.0;
+    const auto a_1 = static_cast<double>(negatedA1), a_2 = static_cast<double>(negatedA2);
+    const auto discriminant = (a_1 * a_1) + (4.0 * a_2);
+
+    const auto radius = discriminant >= 0.0 ? 0.5 * (std::abs(a_1) + std::sqrt(discriminant))
+                                            : std::sqrt(-a_2);
+
+    if (radius >= 1.0)
+        return maxDecaySamples;
+
+    if (radius <= std::numeric_limits<double>::epsilon())
+        return 2.0;
+
+    return juce::jmin(maxDecaySamples, std::ceil(std::log(decayLevel) / std::log(radius)));
+}
+
+//==============================================================================
+template class PeakCascade<float>;
+template class PeakCascade<double>;
@@ -0,0 +1,338 @@
+/*
+  ==============================================================================
+
+    PeakCascade.h
+    Created: 14 Oct 2026 11:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PEAKCASCADE_H_INCLUDED
+#define PEAKCASCADE_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "Transformations.h"
+#include "Smoothing.h"
+
+/**
+    Up to maxBands cookbook peak bands run as one fused cascade.
+
+    Each band's coefficients live in contiguous arrays, one per coefficient,
+    and the bands are run one after another in a single loop per channel
+    with their unit-delays in locals, directFormIItransposed throughout.
+
+    Only the bands in the active list are run. A band at 0 dB, or one beyond
+    the band count, fades its gain to 0 dB, rings out whatever its poles
+    still hold and then leaves the list, so it costs nothing until its gain
+    moves again. While any band is smoothing, its coefficients are redesigned
+    every rampInterval samples and ramped linearly in between.
+*/
+
+template <typename SampleType>
+class PeakCascade
+{
+public:
+    static constexpr size_t maxBands = 8;
+
+    //==============================================================================
+    /** Constructor. */
+    PeakCascade();
+
+    //==============================================================================
+    /** Sets one band's centre frequency in Hz, gain in dB and Q. */
+    void setBand(size_t band, SampleType newFrequency, SampleType newGainDecibels, SampleType newQ) noexcept;
+
+    /** Sets how many bands, from the first, are heard; the others fade out. */
+    void setNumBands(size_t newNumBands) noexcept;
+
+    /** Returns true while any band is part of the processing. */
+    bool isActive() const noexcept { return numActiveBands > 0; }
+
+    //==============================================================================
+    /** Sets the length of the ramp used for smoothing parameter changes. */
+    void setRampDurationSeconds(double newDurationSeconds) noexcept;
+
+    /** Returns the ramp duration in seconds. */
+    double getRampDurationSeconds() const noexcept;
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Moves the bands to a new sample rate without clearing their state or
+    snapping their ramps; each heard band is redesigned where it is. */
+    void setSampleRate(double newSampleRate) noexcept;
+
+    /** Resets the internal state variables of the processor. */
+    void reset();
+
+    /** Ensure that the state variables are rounded to zero if the state
+    variables are denormals. */
+    void snapToZero() noexcept;
+
+    /** Returns true once every unit-delay has decayed to the level that
+    snapToZero() would flush. */
+    bool hasDecayed() const noexcept;
+
+    /** Advances the parameter ramps by numSamples without processing any audio. */
+    void skip(int numSamples) noexcept;
+
+    /** Returns how many samples the active bands take to ring out to -120 dB
+    after the input stops, from their current pole positions. */
+    double getTailSamples() const noexcept;
+
+    //==============================================================================
+    /** Designs a cookbook peak at the given rate. The feedback coefficients
+    are negated, as SecondOrderKernel expects. */
+    template <typename CoefficientType>
+    static void design(double sampleRate, CoefficientType frequency, CoefficientType gainDecibels, CoefficientType q,
+                       CoefficientType& b0, CoefficientType& b1, CoefficientType& b2, CoefficientType& a1, CoefficientType& a2) noexcept
+    {
+        const auto omega = juce::MathConstants<CoefficientType>::twoPi * frequency / static_cast<CoefficientType>(sampleRate);
+        const auto cos = std::cos(omega);
+        const auto alpha = std::sin(omega) / (static_cast<CoefficientType>(2.0) * q);
+        const auto a = std::pow(static_cast<CoefficientType>(10.0), gainDecibels / static_cast<CoefficientType>(40.0));
+        const auto a0 = static_cast<CoefficientType>(1.0) / (static_cast<CoefficientType>(1.0) + (alpha / a));
+
+        b0 = (static_cast<CoefficientType>(1.0) + (alpha * a)) * a0;
+        b1 = static_cast<CoefficientType>(-2.0) * cos * a0;
+        b2 = (static_cast<CoefficientType>(1.0) - (alpha * a)) * a0;
+        a1 = -b1;
+        a2 = ((alpha / a) - static_cast<CoefficientType>(1.0)) * a0;
+    }
+
+    //==============================================================================
+    /** Processes the samples supplied in a replacing processing context. */
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        static_assert(! ProcessContext::usesSeparateInputAndOutputBlocks(), "PeakCascade only processes in place");
+
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert(numChannels <= numStateChannels);
+        juce::ignoreUnused(numChannels);
+
+        if (context.isBypassed)
+        {
+            skip(static_cast<int> (numSamples));
+            return;
+        }
+
+        for (size_t start = 0; start < numSamples;)
+        {
+            const auto chunk = isSmoothing() ? juce::jmin(rampInterval, numSamples - start) : numSamples - start;
+            const auto ramping = loadCoefficients(chunk);
+
+            if (numActiveBands > 0)
+            {
+                if (ramping)
+                    processChannels<true>(outputBlock, start, chunk);
+                else
+                    processChannels<false>(outputBlock, start, chunk);
+            }
+
+            if (ramping)
+                b0 = nextb0, b1 = nextb1, b2 = nextb2, a1 = nexta1, a2 = nexta2;
+
+            start += chunk;
+        }
+    }
+
+    double sampleRate = 44100.0, rampDurationSeconds = 0.05;
+
+    /** Gains this close to 0 dB are treated as 0 dB, so a control that
+    snaps near zero still lets the band be skipped. */
+    static constexpr double identityDecibels = 0.01;
+
+    /** Number of samples between coefficient designs while any band is smoothing. */
+    static constexpr size_t rampInterval = 32;
+
+private:
+    //==============================================================================
+    using Kernel = SecondOrderKernel<TransformationType::directFormIItransposed>;
+    static constexpr size_t n = Kernel::numRegisters;
+
+    /** Returns true if any band is still interpolating its parameters. */
+    bool isSmoothing() const noexcept;
+
+    /** Moves a band's ramps to its targets, at once if it isn't being heard. */
+    void applyTargets(size_t band) noexcept;
+
+    /** Advances smoothing bands by numSamples and designs where they end up,
+    storing the per-sample increments towards it. Rebuilds the list of
+    active bands. Returns true if any band is ramping over the chunk. */
+    bool loadCoefficients(size_t numSamples) noexcept;
+
+    /** Zeroes one band's unit-delays on every channel and sets it to an
+    identity. */
+    void clearBand(size_t band) noexcept;
+
+    /** Returns the decay to decayLevel of a band with the given negated a1
+    and a2, set by its slower pole. */
+    double getDecaySamples(SampleType negatedA1, SampleType negatedA2) const noexcept;
+
+    /** Runs one chunk over every channel. With SIMD available, channels are
+    processed in groups of numLanes, one channel per lane; any channels left
+    over run through the scalar path. */
+    template <bool isRampingCoefficients, typename OutputBlock>
+    void processChannels(OutputBlock& outputBlock, size_t start, size_t numSamples) noexcept
+    {
+        const auto numChannels = outputBlock.getNumChannels();
+        size_t channel = 0;
+
+#if JUCE_USE_SIMD
+        if (numChannels > 1)
+            for (; channel < numChannels; channel += numLanes)
+                processLanes<isRampingCoefficients>(outputBlock, channel, start, numSamples);
+#endif
+
+        for (; channel < numChannels; ++channel)
+            processChannel<isRampingCoefficients>(channel, outputBlock.getChannelPointer(channel) + start, numSamples);
+    }
+
+    /** Runs every active band over one channel. */
+    template <bool isRampingCoefficients>
+    void processChannel(size_t channel, SampleType* samples, size_t numSamples) noexcept
+    {
+        std::array<std::array<SampleType, n>, maxBands> z;
+        auto* channelState = state.data() + (channel * maxBands * n);
+
+        for (size_t k = 0; k < numActiveBands; ++k)
+            std::copy_n(channelState + (activeBands[k] * n), n, z[activeBands[k]].begin());
+
+        auto b_0 = b0, b_1 = b1, b_2 = b2, a_1 = a1, a_2 = a2;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto Yn = samples[i];
+
+            for (size_t k = 0; k < numActiveBands; ++k)
+            {
+                const auto band = activeBands[k];
+
+                Yn = Kernel::processSample(Yn, z[band].data(), b_0[band], b_1[band], b_2[band], a_1[band], a_2[band]);
+
+                if (isRampingCoefficients)
+                    b_0[band] += incb0[band], b_1[band] += incb1[band], b_2[band] += incb2[band], a_1[band] += inca1[band], a_2[band] += inca2[band];
+            }
+
+            samples[i] = Yn;
+        }
+
+        for (size_t k = 0; k < numActiveBands; ++k)
+            std::copy_n(z[activeBands[k]].begin(), n, channelState + (activeBands[k] * n));
+    }
+
+#if JUCE_USE_SIMD
+    //==============================================================================
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr size_t numLanes = SIMDType::SIMDNumElements;
+
+    /** Runs every active band over up to numLanes channels starting at
+    firstChannel, one channel per SIMD lane. Unused lanes run on silence. */
+    template <bool isRampingCoefficients, typename OutputBlock>
+    void processLanes(OutputBlock& outputBlock, size_t firstChannel, size_t start, size_t numSamples) noexcept
+    {
+        const auto lanes = juce::jmin(numLanes, outputBlock.getNumChannels() - firstChannel);
+
+        std::array<SampleType*, numLanes> samples {};
+        alignas(sizeof(SIMDType)) SampleType frame[numLanes] = {};
+
+        std::array<std::array<SIMDType, n>, maxBands> z;
+
+        for (auto& bandRegisters : z)
+            bandRegisters.fill(SIMDType::expand(static_cast<SampleType>(0.0)));
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const auto channel = firstChannel + lane;
+            const auto* channelState = state.data() + (channel * maxBands * n);
+
+            samples[lane] = outputBlock.getChannelPointer(channel) + start;
+
+            for (size_t k = 0; k < numActiveBands; ++k)
+                for (size_t r = 0; r < n; ++r)
+                    z[activeBands[k]][r].set(lane, channelState[(activeBands[k] * n) + r]);
+        }
+
+        auto b_0 = b0, b_1 = b1, b_2 = b2, a_1 = a1, a_2 = a2;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t lane = 0; lane < lanes; ++lane)
+                frame[lane] = samples[lane][i];
+
+            auto Yn = SIMDType::fromRawArray(frame);
+
+            for (size_t k = 0; k < numActiveBands; ++k)
+            {
+                const auto band = activeBands[k];
+
+                Yn = Kernel::processSample(Yn, z[band].data(), b_0[band], b_1[band], b_2[band], a_1[band], a_2[band]);
+
+                if (isRampingCoefficients)
+                    b_0[band] += incb0[band], b_1[band] += incb1[band], b_2[band] += incb2[band], a_1[band] += inca1[band], a_2[band] += inca2[band];
+            }
+
+            Yn.copyToRawArray(frame);
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+                samples[lane][i] = frame[lane];
+        }
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            auto* channelState = state.data() + ((firstChannel + lane) * maxBands * n);
+
+            for (size_t k = 0; k < numActiveBands; ++k)
+                for (size_t r = 0; r < n; ++r)
+                    channelState[(activeBands[k] * n) + r] = z[activeBands[k]][r].get(lane);
+        }
+    }
+#endif
+
+    //==============================================================================
+    /** Coefficients for each band, where a ramp ends, and the per-sample
+    increments towards it. */
+    std::array<SampleType, maxBands> b0, b1, b2, a1, a2;
+    std::array<SampleType, maxBands> nextb0, nextb1, nextb2, nexta1, nexta2;
+    std::array<SampleType, maxBands> incb0, incb1, incb2, inca1, inca2;
+
+    //==============================================================================
+    /** Parameter Smoothers. */
+    std::array<juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative>, maxBands> frequency, q;
+    std::array<juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear>, maxBands> gain;
+
+    /** The values set for each band; the gain target is 0 dB while the band
+    is beyond the band count. */
+    std::array<SampleType, maxBands> targetFrequency, targetGain, targetQ;
+    size_t numBands = 0;
+
+    //==============================================================================
+    /** Bands taking part in the current chunk, in processing order. Once a
+    band rests at 0 dB it stays in the list for tailSamples more samples. */
+    std::array<size_t, maxBands> activeBands;
+    size_t numActiveBands = 0;
+    std::array<double, maxBands> tailSamples;
+    std::array<bool, maxBands> skipped;
+
+    /** The level a band's tail must decay to before it is skipped (-120 dB). */
+    static constexpr double decayLevel = 1.0e-6;
+
+    //==============================================================================
+    /** Unit-delays, per channel and band. */
+    std::vector<SampleType> state;
+    size_t numStateChannels = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PeakCascade)
+};
+
+#endif //PEAKCASCADE_H_INCLUDED
@@ -48,6 +48,14 @@ void StateVariableTPTFilter<SampleType>::setResonance(SampleType newResonance)
     update();
 }
 
+template <typename SampleType>
+void StateVariableTPTFilter<SampleType>::setGain(SampleType newGainDecibels)
+{
+    gain = newGainDecibels;
+    lev.setTargetValue(gain);
+    update();
+}
+
 //==============================================================================
 template <typename SampleType>
 void StateVariableTPTFilter<SampleType>::setRampDurationSeconds(double newDurationSeconds) noexcept
@@ -55,7 +63,10 @@ void StateVariableTPTFilter<SampleType>::setRampDurationSeconds(double newDurati
     if (rampDurationSeconds != newDurationSeconds)
     {
         rampDurationSeconds = newDurationSeconds;
-        reset(static_cast<SampleType>(0.0));
+
+        Smoothing::retime(frq, sampleRate, rampDurationSeconds);
+        Smoothing::retime(res, sampleRate, rampDurationSeconds);
+        Smoothing::retime(lev, sampleRate, rampDurationSeconds);
     }
 }
 
@@ -68,7 +79,7 @@ double StateVariableTPTFilter<SampleType>::getRampDurationSeconds() const noexce
 template <typename SampleType>
 bool StateVariableTPTFilter<SampleType>::isSmoothing() const noexcept
 {
-    bool compSmoothing = frq.isSmoothing() || res.isSmoothing();
+    bool compSmoothing = frq.isSmoothing() || res.isSmoothing() || lev.isSmoothing();
 
     return compSmoothing;
 }
@@ -95,6 +106,26 @@ void StateVariableTPTFilter<SampleType>::prepare(const juce::dsp::ProcessSpec& s
     update();
 }
 
+template <typename SampleType>
+void StateVariableTPTFilter<SampleType>::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+
+    sampleRate = newSampleRate;
+
+    minFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(24576.0);
+    maxFreq = static_cast <SampleType>(sampleRate) / static_cast <SampleType>(2.125);
+
+    jassert(static_cast <SampleType>(20.0) >= minFreq && minFreq <= static_cast <SampleType>(20000.0));
+    jassert(static_cast <SampleType>(20.0) <= maxFreq && maxFreq >= static_cast <SampleType>(20000.0));
+
+    Smoothing::retime(frq, sampleRate, rampDurationSeconds);
+    Smoothing::retime(res, sampleRate, rampDurationSeconds);
+    Smoothing::retime(lev, sampleRate, rampDurationSeconds);
+
+    update();
+}
+
 template <typename SampleType>
 void StateVariableTPTFilter<SampleType>::reset(SampleType newValue)
 {
@@ -103,6 +134,10 @@ void StateVariableTPTFilter<SampleType>::reset(SampleType newValue)
 
     frq.reset(sampleRate, rampDurationSeconds);
     res.reset(sampleRate, rampDurationSeconds);
+    lev.reset(sampleRate, rampDurationSeconds);
+
+    // The smoothers have jumped to their targets; follow them.
+    update();
 }
 
 template <typename SampleType>
@@ -113,23 +148,97 @@ void StateVariableTPTFilter<SampleType>::snapToZero() noexcept
             juce::dsp::util::snapToZero(element);
 }
 
+template <typename SampleType>
+bool StateVariableTPTFilter<SampleType>::hasDecayed() const noexcept
+{
+    const auto level = static_cast<SampleType>(1.0e-8);
+
+    for (auto v : { &s1, &s2 })
+        for (auto element : *v)
+            if (element < -level || element > level)
+                return false;
+
+    return true;
+}
+
+template <typename SampleType>
+double StateVariableTPTFilter<SampleType>::getDecaySamples(SampleType decayLevel) const noexcept
+{
+    // The structure is the bilinear transform of s^2 + R2.s + 1 at g, so the
+    // squared pole radius is (1 - R2.g + g^2) / (1 + R2.g + g^2).
+    const auto maxDecaySamples = sampleRate * 10.0;
+    const auto radiusSquared = std::abs(static_cast<double>((1 - (R2 * g) + (g * g)) * h));
+
+    if (radiusSquared >= 1.0)
+        return maxDecaySamples;
+
+    if (radiusSquared <= std::numeric_limits<double>::epsilon())
+        return 2.0;
+
+    return juce::jmin(maxDecaySamples, std::ceil((2.0 * std::log(static_cast<double>(decayLevel))) / std::log(radiusSquared)));
+}
+
 //==============================================================================
 template <typename SampleType>
-SampleType StateVariableTPTFilter<SampleType>::processSample(int channel, SampleType inputValue)
+void StateVariableTPTFilter<SampleType>::getZeroInputResponse(int channel, SampleType& y0, SampleType& y1) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(channel, s1.size()));
+
+    auto ls1 = s1[(size_t)channel], ls2 = s2[(size_t)channel];
+
+    y0 = tick(static_cast<SampleType>(0.0), ls1, ls2);
+    y1 = tick(static_cast<SampleType>(0.0), ls1, ls2);
+}
+
+template <typename SampleType>
+void StateVariableTPTFilter<SampleType>::setZeroInputResponse(int channel, SampleType y0, SampleType y1) noexcept
 {
     jassert(juce::isPositiveAndBelow(channel, s1.size()));
-    jassert(juce::isPositiveAndBelow(channel, s2.size()));
+
+    const auto zero = static_cast<SampleType>(0.0), one = static_cast<SampleType>(1.0);
+
+    // The zero-input response is linear in (s1, s2); find it for each state
+    // variable alone and solve for the combination giving y0 and y1.
+    SampleType p1 = one, p2 = zero, q1 = zero, q2 = one;
+    const auto p0 = tick(zero, p1, p2), pn = tick(zero, p1, p2);
+    const auto q0 = tick(zero, q1, q2), qn = tick(zero, q1, q2);
+
+    const auto det = (p0 * qn) - (q0 * pn);
+    const auto scale = (std::abs(p0) + std::abs(pn)) * (std::abs(q0) + std::abs(qn));
 
     auto& ls1 = s1[(size_t)channel];
     auto& ls2 = s2[(size_t)channel];
 
+    if (std::abs(det) <= scale * std::numeric_limits<SampleType>::epsilon())
+    {
+        ls1 = ls2 = zero;
+        return;
+    }
+
+    ls1 = ((y0 * qn) - (q0 * y1)) / det;
+    ls2 = ((p0 * y1) - (y0 * pn)) / det;
+}
+
+//==============================================================================
+template <typename SampleType>
+SampleType StateVariableTPTFilter<SampleType>::processSample(int channel, SampleType inputValue)
+{
+    jassert(juce::isPositiveAndBelow(channel, s1.size()));
+    jassert(juce::isPositiveAndBelow(channel, s2.size()));
+
+    return tick(inputValue, s1[(size_t)channel], s2[(size_t)channel]);
+}
+
+template <typename SampleType>
+SampleType StateVariableTPTFilter<SampleType>::tick(SampleType inputValue, SampleType& ls1, SampleType& ls2) const noexcept
+{
     auto yHP = h * (inputValue - ls1 * (g + R2) - ls2);
 
     auto yBP = yHP * g + ls1;
     ls1 = yHP * g + yBP;
 
     auto yLP = yBP * g + ls2;
-    ls2 = yBP * g + yLP;
+    ls2 = yBP * g + yLP + static_cast<SampleType>(antiDenormal);
 
     if (filterType == Type::LP2)
         return (yLP);
@@ -153,6 +262,10 @@ SampleType StateVariableTPTFilter<SampleType>::processSample(int channel, Sample
         return (yLP + yHP);
     else if (filterType == Type::N2)
         return (yLP - yHP);
+    else if (filterType == Type::LS2)
+        return (inputValue + (yBP * m1) + (yLP * m2));
+    else if (filterType == Type::HS2)
+        return ((inputValue * (A * A)) + (yBP * m1) + (yLP * m2));
     else
         return (yLP);
 }
@@ -161,8 +274,28 @@ SampleType StateVariableTPTFilter<SampleType>::processSample(int channel, Sample
 template <typename SampleType>
 void StateVariableTPTFilter<SampleType>::update()
 {
+    const auto r = res.getNextValue();
+
     g = static_cast<SampleType> (std::tan(juce::MathConstants<double>::pi * frq.getNextValue() / sampleRate));
-    R2 = static_cast<SampleType> (1.0 - (res.getNextValue() * 0.9875)) + (1.0 - (res.getNextValue() * 0.9875));
+    R2 = static_cast<SampleType> ((1.0 - (r * 0.9875)) * 2.0);
+    A = static_cast<SampleType> (juce::Decibels::decibelsToGain(lev.getNextValue() * static_cast<SampleType>(0.5)));
+
+    // Shelves move the poles by sqrt(A) and mix the outputs back to x with
+    // gains chosen so that DC (low shelf) or Nyquist (high shelf) reaches A^2.
+    if (filterType == Type::LS2)
+    {
+        g /= std::sqrt(A);
+        m1 = R2 * (A - static_cast<SampleType>(1.0));
+        m2 = (A * A) - static_cast<SampleType>(1.0);
+    }
+
+    else if (filterType == Type::HS2)
+    {
+        g *= std::sqrt(A);
+        m1 = R2 * (static_cast<SampleType>(1.0) - A) * A;
+        m2 = static_cast<SampleType>(1.0) - (A * A);
+    }
+
     h = static_cast<SampleType> (1.0 / (1.0 + R2 * g + g * g));
 }
 
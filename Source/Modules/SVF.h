@@ -11,7 +11,9 @@
 #ifndef SVF_H_INCLUDED
 #define SVF_H_INCLUDED
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
+#include "Transformations.h"
+#include "Smoothing.h"
 
 enum class StateVariableTPTFilterType
 {
@@ -25,7 +27,9 @@ enum class StateVariableTPTFilterType
     BP2n,
     AP2,
     N2,
-    P2
+    P2,
+    LS2,
+    HS2
 };
 
 //==============================================================================
@@ -71,6 +75,10 @@ public:
     */
     void setResonance(SampleType newResonance);
 
+    /** Sets the shelf gain in dB. LS2 and HS2 only; the slope follows the
+    resonance, with 1 - 1 / sqrt(2) giving the cookbook S = 1 shelf. */
+    void setGain(SampleType newGainDecibels);
+
     //==========================================================================
     /** Returns the type of the filter. */
     Type getType() const noexcept { return filterType; }
@@ -81,6 +89,9 @@ public:
     /** Returns the resonance of the filter. */
     SampleType getResonance() const noexcept { return resonance; }
 
+    /** Returns the shelf gain of the filter in dB. */
+    SampleType getGain() const noexcept { return gain; }
+
     //==============================================================================
     /** Sets the length of the ramp used for smoothing parameter changes. */
     void setRampDurationSeconds(double newDurationSeconds) noexcept;
@@ -95,7 +106,12 @@ public:
     /** Initialises the filter. */
     void prepare(const juce::dsp::ProcessSpec& spec);
 
-    /** Resets the internal state variables of the filter to a given value. */
+    /** Moves the filter to a new sample rate without clearing its state or
+    snapping its ramps. */
+    void setSampleRate(double newSampleRate) noexcept;
+
+    /** Resets the internal state variables of the filter to a given value,
+    and moves the parameters straight to their targets. */
     void reset(SampleType newValue);
 
     /** Ensure that the state variables are rounded to zero if the state
@@ -104,6 +120,24 @@ public:
     */
     void snapToZero() noexcept;
 
+    /** Returns true once every state variable is within the level that
+    snapToZero() would flush. */
+    bool hasDecayed() const noexcept;
+
+    /** Returns how many samples the impulse response takes to decay below
+    decayLevel (linear), from the current pole radius. */
+    double getDecaySamples(SampleType decayLevel) const noexcept;
+
+    //==========================================================================
+    /** Returns the next two outputs of one channel for silent input. Together
+    they describe the state completely, so they can be handed to any other
+    realisation of the same response. See Biquads::getZeroInputResponse(). */
+    void getZeroInputResponse(int channel, SampleType& y0, SampleType& y1) const noexcept;
+
+    /** Sets one channel's state so that its next two outputs for silent input
+    are y0 and y1. The state is cleared if the output doesn't depend on it. */
+    void setZeroInputResponse(int channel, SampleType y0, SampleType y1) noexcept;
+
     //==========================================================================
     /** Processes the input and output samples supplied in the processing context. */
     template <typename ProcessContext>
@@ -128,18 +162,30 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
+        // While smoothing, the coefficients are recalculated every sample,
+        // which the TPT structure tolerates without artefacts.
+        if (isSmoothing())
         {
-            auto* inputSamples = inputBlock.getChannelPointer(channel);
-            auto* outputSamples = outputBlock.getChannelPointer(channel);
-
             for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample((int)channel, inputSamples[i]);
+            {
+                update();
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    outputBlock.getChannelPointer(channel)[i] = processSample((int)channel, inputBlock.getChannelPointer(channel)[i]);
+            }
         }
 
-#if JUCE_DSP_ENABLE_SNAP_TO_ZERO
-        snapToZero();
-#endif
+        else
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* inputSamples = inputBlock.getChannelPointer(channel);
+                auto* outputSamples = outputBlock.getChannelPointer(channel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    outputSamples[i] = processSample((int)channel, inputSamples[i]);
+            }
+        }
     }
 
     //==========================================================================
@@ -152,22 +198,30 @@ private:
     //==========================================================================
     void update();
 
+    /** Runs one sample through the structure with the given state variables. */
+    SampleType tick(SampleType inputValue, SampleType& ls1, SampleType& ls2) const noexcept;
+
     //==========================================================================
     /** Parameter Smoothers. */
     juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative> frq;
     juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> res;
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> lev;
 
     SampleType minFreq = 20.0;
     SampleType maxFreq = 20000.0;
 
     //==========================================================================
     SampleType g, h, R2;
+
+    /** Shelf gain (the square root of the linear gain) and output weights. */
+    SampleType A = 1.0, m1 = 0.0, m2 = 0.0;
     std::vector<SampleType> s1{ 2 }, s2{ 2 };
 
     //==========================================================================
     Type filterType = Type::LP2;
     SampleType cutoffFrequency = 1000.0; 
     SampleType resonance = 0.70710678118654752440084436210485;
+    SampleType gain = 0.0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StateVariableTPTFilter)
 };
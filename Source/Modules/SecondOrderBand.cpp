@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+    SecondOrderBand.cpp
+    Created: 14 Oct 2026 7:21:05pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "SecondOrderBand.h"
+
+//==============================================================================
+template <typename SampleType>
+SecondOrderBand<SampleType>::SecondOrderBand()
+{
+    // The biquad only ever sees settled parameters, so it needn't smooth.
+    biquad.setRampDurationSeconds(0.0);
+    biquad.setTransformType(TransformationType::directFormIItransposed);
+    biquad.setResonance(static_cast<SampleType>(resonance));
+
+    // The SVF's resonance law is R2 = 2 (1 - 0.9875 r), the cookbook's is
+    // 1 / Q = 2 (1 - r).
+    svf.setResonance(static_cast<SampleType>(resonance / 0.9875));
+
+    setFilterType(filtType);
+}
+
+//==============================================================================
+template <typename SampleType>
+void SecondOrderBand<SampleType>::setFilterType(filterType newFiltType)
+{
+    jassert(newFiltType == filterType::lowPass2 || newFiltType == filterType::highPass2
+         || newFiltType == filterType::lowShelf2 || newFiltType == filterType::highShelf2);
+
+    filtType = newFiltType;
+
+    switch (filtType)
+    {
+    case filterType::highPass2:
+        svf.setType(StateVariableTPTFilterType::HP2);
+        break;
+    case filterType::lowShelf2:
+        svf.setType(StateVariableTPTFilterType::LS2);
+        break;
+    case filterType::highShelf2:
+        svf.setType(StateVariableTPTFilterType::HS2);
+        break;
+    default:
+        svf.setType(StateVariableTPTFilterType::LP2);
+    }
+
+    biquad.setFilterType(filtType);
+
+    restart();
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::setFrequency(SampleType newFreq)
+{
+    hz = newFreq;
+    biquadIsCurrent = false;
+
+    if (isActive())
+    {
+        moveToStateVariable();
+        svf.setCutoffFrequency(hz);
+    }
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::setGain(SampleType newGain)
+{
+    g = newGain;
+    biquadIsCurrent = false;
+
+    if (isActive())
+    {
+        moveToStateVariable();
+        svf.setGain(g);
+    }
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::setEnabled(bool shouldBeEnabled) noexcept
+{
+    if (enabled == shouldBeEnabled)
+        return;
+
+    // Parameters aren't followed while the band is silent, so catch up, and
+    // start again from silence.
+    if (shouldBeEnabled && ! isActive())
+        restart();
+
+    enabled = shouldBeEnabled;
+    fade.setTargetValue(static_cast<SampleType>(enabled ? 1.0 : 0.0));
+}
+
+template <typename SampleType>
+bool SecondOrderBand<SampleType>::isActive() const noexcept
+{
+    return enabled || fade.getCurrentValue() > static_cast<SampleType>(0.0);
+}
+
+//==============================================================================
+template <typename SampleType>
+void SecondOrderBand<SampleType>::setRampDurationSeconds(double newDurationSeconds) noexcept
+{
+    if (rampDurationSeconds != newDurationSeconds)
+    {
+        rampDurationSeconds = newDurationSeconds;
+        svf.setRampDurationSeconds(rampDurationSeconds);
+    }
+}
+
+template <typename SampleType>
+double SecondOrderBand<SampleType>::getRampDurationSeconds() const noexcept
+{
+    return rampDurationSeconds;
+}
+
+//==============================================================================
+template <typename SampleType>
+void SecondOrderBand<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.sampleRate > 0);
+    jassert(spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    numChannels = static_cast<int>(spec.numChannels);
+
+    biquad.prepare(spec);
+    svf.prepare(spec);
+    svf.setRampDurationSeconds(rampDurationSeconds);
+
+    // Keep the largest buffers seen, so a later prepare at a lower rate
+    // doesn't allocate.
+    dryBuffer.setSize(numChannels, static_cast<int>(spec.maximumBlockSize), false, false, true);
+
+    if (fadeGains.size() < spec.maximumBlockSize)
+        fadeGains.resize(spec.maximumBlockSize);
+
+    holdSamples = juce::roundToInt(holdDurationSeconds * sampleRate);
+    fade.reset(sampleRate, fadeDurationSeconds);
+
+    restart();
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::setSampleRate(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0);
+
+    sampleRate = newSampleRate;
+
+    biquad.setSampleRate(sampleRate);
+    svf.setSampleRate(sampleRate);
+
+    holdSamples = juce::roundToInt(holdDurationSeconds * sampleRate);
+    holdRemaining = juce::jmin(holdRemaining, holdSamples);
+    Smoothing::retime(fade, sampleRate, fadeDurationSeconds);
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::reset()
+{
+    fade.setCurrentAndTargetValue(static_cast<SampleType>(enabled ? 1.0 : 0.0));
+
+    restart();
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::restart() noexcept
+{
+    const auto zero = static_cast<SampleType>(0.0);
+
+    svf.setCutoffFrequency(hz);
+    svf.setGain(g);
+    svf.reset(zero);
+
+    if (! biquadIsCurrent)
+    {
+        biquad.setFrequency(hz);
+        biquad.setGain(g);
+        biquadIsCurrent = true;
+    }
+
+    biquad.reset(zero);
+
+    engine = Engine::biquad;
+    holdRemaining = 0;
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::snapToZero() noexcept
+{
+    svf.snapToZero();
+    biquad.snapToZero();
+}
+
+template <typename SampleType>
+bool SecondOrderBand<SampleType>::hasDecayed() const noexcept
+{
+    if (! isActive())
+        return true;
+
+    return engine == Engine::stateVariable ? svf.hasDecayed() : biquad.hasDecayed();
+}
+
+template <typename SampleType>
+double SecondOrderBand<SampleType>::getTailSamples(SampleType decayLevel) const noexcept
+{
+    if (! isActive())
+        return 0.0;
+
+    return engine == Engine::stateVariable ? svf.getDecaySamples(decayLevel) : biquad.getDecaySamples(decayLevel);
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::skip(int numSamples) noexcept
+{
+    fade.skip(numSamples);
+}
+
+//==============================================================================
+template <typename SampleType>
+void SecondOrderBand<SampleType>::selectEngine(size_t numSamples) noexcept
+{
+    if (engine == Engine::biquad || svf.isSmoothing())
+        return;
+
+    holdRemaining -= static_cast<int>(numSamples);
+
+    if (holdRemaining <= 0)
+        moveToBiquad();
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::moveToStateVariable() noexcept
+{
+    holdRemaining = holdSamples;
+
+    if (engine == Engine::stateVariable)
+        return;
+
+    SampleType y0, y1;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        biquad.getZeroInputResponse(channel, y0, y1);
+        svf.setZeroInputResponse(channel, y0, y1);
+    }
+
+    engine = Engine::stateVariable;
+}
+
+template <typename SampleType>
+void SecondOrderBand<SampleType>::moveToBiquad() noexcept
+{
+    if (! biquadIsCurrent)
+    {
+        biquad.setFrequency(hz);
+        biquad.setGain(g);
+        biquadIsCurrent = true;
+    }
+
+    SampleType y0, y1;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        svf.getZeroInputResponse(channel, y0, y1);
+        biquad.setZeroInputResponse(channel, y0, y1);
+    }
+
+    engine = Engine::biquad;
+}
+
+//==============================================================================
+template class SecondOrderBand<float>;
+template class SecondOrderBand<double>;
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    SecondOrderBand.h
+    Created: 14 Oct 2026 7:21:05pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SECONDORDERBAND_H_INCLUDED
+#define SECONDORDERBAND_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "Biquads.h"
+#include "SVF.h"
+
+/**
+    A second-order band that picks the cheaper of two engines.
+
+    While a parameter is moving, the band runs a StateVariableTPTFilter,
+    which recalculates its coefficients every sample without artefacts. Once
+    nothing has moved for holdDurationSeconds it hands over to a
+    directFormIItransposed Biquads, the cheapest static section, and takes the
+    SVF back as soon as a parameter changes again. Both engines are the
+    bilinear transform of the same prototype, prewarped at the set frequency,
+    and each hands the other its next two outputs for silent input, so the
+    switch is sample-exact in both directions.
+
+    When enabled or disabled the band is crossfaded against its input, so it
+    can replace a first-order stage without a click.
+*/
+
+template <typename SampleType>
+class SecondOrderBand
+{
+public:
+    using filterType = BiquadType;
+
+    //==============================================================================
+    /** Constructor. */
+    SecondOrderBand();
+
+    //==============================================================================
+    /** Sets the response of the band. lowPass2, highPass2, lowShelf2 and
+    highShelf2 only. */
+    void setFilterType(filterType newFiltType);
+
+    /** Sets the centre Frequency of the filter. Range = 20..20000 */
+    void setFrequency(SampleType newFreq);
+
+    /** Sets the shelf gain in dB. Shelf types only. */
+    void setGain(SampleType newGain);
+
+    /** Fades the band in or out over fadeDurationSeconds. */
+    void setEnabled(bool shouldBeEnabled) noexcept;
+
+    /** Returns true while the band is heard, including while it fades out. */
+    bool isActive() const noexcept;
+
+    /** Returns true while the band is running its modulation engine. */
+    bool isUsingStateVariable() const noexcept { return engine == Engine::stateVariable; }
+
+    //==============================================================================
+    /** Sets the length of the ramp used for smoothing parameter changes. */
+    void setRampDurationSeconds(double newDurationSeconds) noexcept;
+
+    /** Returns the ramp duration in seconds. */
+    double getRampDurationSeconds() const noexcept;
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare(juce::dsp::ProcessSpec& spec);
+
+    /** Moves both engines to a new sample rate without clearing their state,
+    and carries the crossfade on at the new rate. */
+    void setSampleRate(double newSampleRate) noexcept;
+
+    /** Resets the internal state variables of the processor. */
+    void reset();
+
+    /** Ensure that the state variables are rounded to zero if the state
+    variables are denormals. */
+    void snapToZero() noexcept;
+
+    /** Returns true once the active engine's state has decayed to the level
+    that snapToZero() would flush. */
+    bool hasDecayed() const noexcept;
+
+    /** Returns how many samples the band takes to ring out below decayLevel
+    (linear); 0 while it isn't active. */
+    double getTailSamples(SampleType decayLevel) const noexcept;
+
+    /** Advances the crossfade by numSamples without processing any audio. */
+    void skip(int numSamples) noexcept;
+
+    //==============================================================================
+    /** Processes the samples supplied in a replacing processing context. */
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        static_assert(! ProcessContext::usesSeparateInputAndOutputBlocks(), "SecondOrderBand only processes in place");
+
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert(numChannels <= static_cast<size_t>(dryBuffer.getNumChannels()));
+        jassert(numSamples <= fadeGains.size());
+
+        if (context.isBypassed || ! isActive())
+            return;
+
+        selectEngine(numSamples);
+
+        const auto fading = fade.isSmoothing();
+
+        if (fading)
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                std::copy_n(outputBlock.getChannelPointer(channel), numSamples, dryBuffer.getWritePointer(static_cast<int>(channel)));
+
+        juce::dsp::ProcessContextReplacing<SampleType> engineContext(outputBlock);
+
+        if (engine == Engine::stateVariable)
+            svf.process(engineContext);
+        else
+            biquad.process(engineContext);
+
+        if (! fading)
+            return;
+
+        for (size_t i = 0; i < numSamples; ++i)
+            fadeGains[i] = fade.getNextValue();
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* drySamples = dryBuffer.getReadPointer(static_cast<int>(channel));
+            auto* outputSamples = outputBlock.getChannelPointer(channel);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                outputSamples[i] = drySamples[i] + ((outputSamples[i] - drySamples[i]) * fadeGains[i]);
+        }
+    }
+
+    double sampleRate = 44100.0, rampDurationSeconds = 0.001;
+
+    /** Crossfade time when enabled or disabled; matches the cascade's stage
+    fades, so a first-order stage and its replacement cross over together. */
+    double fadeDurationSeconds = 0.05;
+
+    /** Automation arrives as a stream of small steps, so the band stays on the
+    SVF until no parameter has moved for this long. */
+    double holdDurationSeconds = 0.1;
+
+    /** Biquads resonance used by the band. It gives Butterworth passes and
+    cookbook S = 1 shelves; the SVF is set to the equivalent in its own
+    convention. */
+    static constexpr double resonance = 0.29289321881345247560;
+
+private:
+    //==============================================================================
+    enum class Engine
+    {
+        stateVariable,
+        biquad
+    };
+
+    /** Hands over to the biquad once the SVF has settled and the hold has run
+    out. Called at the start of every block. */
+    void selectEngine(size_t numSamples) noexcept;
+
+    /** Makes the SVF the active engine, taking over the biquad's state, and
+    restarts the hold. Called before any parameter reaches the SVF. */
+    void moveToStateVariable() noexcept;
+
+    /** Brings the biquad up to date and hands it the SVF's state. */
+    void moveToBiquad() noexcept;
+
+    /** Clears both engines and moves them straight to the current parameters. */
+    void restart() noexcept;
+
+    //==============================================================================
+    /** Engines. */
+    Biquads<SampleType> biquad;
+    StateVariableTPTFilter<SampleType> svf;
+    Engine engine = Engine::biquad;
+
+    /** False while the biquad's parameters lag behind the SVF's. */
+    bool biquadIsCurrent = false;
+    int holdSamples = 0, holdRemaining = 0;
+    int numChannels = 0;
+
+    //==============================================================================
+    /** Crossfade against the input, and the scratch space it needs. */
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> fade;
+    juce::AudioBuffer<SampleType> dryBuffer;
+    std::vector<SampleType> fadeGains;
+    bool enabled = false;
+
+    //==============================================================================
+    /** Initialise the parameters. */
+    SampleType hz = 1000.0, g = 0.0;
+    filterType filtType = filterType::lowPass2;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SecondOrderBand)
+};
+
+#endif //SECONDORDERBAND_H_INCLUDED
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    Smoothing.h
+    Created: 15 Oct 2026 2:04:18am
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SMOOTHING_H_INCLUDED
+#define SMOOTHING_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/**
+    Changes the timing of a juce::SmoothedValue without snapping it.
+
+    SmoothedValue::reset() jumps to the target, which turns a ramp in
+    progress into a step. retime() keeps the value reached so far and ramps
+    on to the same target over the new length, so a sample rate or ramp
+    length can change while processing.
+*/
+
+struct Smoothing
+{
+    template <typename FloatType, typename SmoothingType>
+    static void retime(juce::SmoothedValue<FloatType, SmoothingType>& smoother, double sampleRate, double rampLengthSeconds) noexcept
+    {
+        const auto current = smoother.getCurrentValue();
+        const auto target = smoother.getTargetValue();
+
+        smoother.reset(sampleRate, rampLengthSeconds);
+        smoother.setCurrentAndTargetValue(current);
+        smoother.setTargetValue(target);
+    }
+};
+
+#endif //SMOOTHING_H_INCLUDED
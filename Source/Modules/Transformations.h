@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+    Transformations.h
+    Created: 14 Oct 2026 1:40:12pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef TRANSFORMATIONS_H_INCLUDED
+#define TRANSFORMATIONS_H_INCLUDED
+
+#include <JuceHeader.h>
+
+enum class TransformationType
+{
+    directFormI = 0,
+    directFormII = 1,
+    directFormItransposed = 2,
+    directFormIItransposed = 3
+};
+
+/**
+    Added to the recursive unit-delay of every section on every sample.
+
+    A decaying state would otherwise pass through the denormal range, which
+    is many times slower on most FPUs unless flush-to-zero happens to be
+    enabled. With this offset the state settles just above it instead, on
+    any platform and in any host. It is far above the smallest normal float
+    (1.2e-38), and far below the rounding error of any state carrying signal,
+    so it never changes the output audibly.
+*/
+static constexpr double antiDenormal = 1.0e-20;
+
+/**
+    Compile-time kernels for each TransformationType.
+
+    Each kernel processes a single sample against its own unit-delays, passed
+    as an array of numRegisters values in the order listed for each kernel,
+    so a filter only has to store and clear the registers its topology uses.
+    Callers pick the topology once per block and keep the registers in locals
+    for the whole inner loop. The value type may be a plain sample or a
+    juce::dsp::SIMDRegister; coefficients are always applied on the
+    right-hand side so that both work.
+*/
+
+template <TransformationType Type>
+struct FirstOrderKernel;
+
+template <>
+struct FirstOrderKernel<TransformationType::directFormI>
+{
+    /** Xn1, Yn1. */
+    static constexpr size_t numRegisters = 2;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient a1) noexcept
+    {
+        auto& Xn1 = z[0];
+        auto& Yn1 = z[1];
+
+        Value Yn = ((Xn * b0) + (Xn1 * b1) + (Yn1 * a1));
+
+        Xn1 = Xn, Yn1 = (Yn + static_cast<Coefficient>(antiDenormal));
+
+        return Yn;
+    }
+};
+
+template <>
+struct FirstOrderKernel<TransformationType::directFormII>
+{
+    /** Wn1. */
+    static constexpr size_t numRegisters = 1;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient a1) noexcept
+    {
+        auto& Wn1 = z[0];
+
+        Value Wn = (Xn + ((Wn1 * a1)));
+        Value Yn = ((Wn * b0) + (Wn1 * b1));
+
+        Wn1 = (Wn + static_cast<Coefficient>(antiDenormal));
+
+        return Yn;
+    }
+};
+
+template <>
+struct FirstOrderKernel<TransformationType::directFormItransposed>
+{
+    /** Wn1, Yn1. */
+    static constexpr size_t numRegisters = 2;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient a1) noexcept
+    {
+        auto& Wn1 = z[0];
+        auto& Yn1 = z[1];
+
+        Value Wn = (Xn + Wn1);
+        Value Yn = ((Wn * b0) + Yn1);
+
+        Wn1 = ((Wn * a1) + static_cast<Coefficient>(antiDenormal)), Yn1 = ((Wn * b1));
+
+        return Yn;
+    }
+};
+
+template <>
+struct FirstOrderKernel<TransformationType::directFormIItransposed>
+{
+    /** Xn1. */
+    static constexpr size_t numRegisters = 1;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient a1) noexcept
+    {
+        auto& Xn1 = z[0];
+
+        Value Yn = ((Xn * b0) + Xn1);
+
+        Xn1 = ((Xn * b1) + (Yn * a1) + static_cast<Coefficient>(antiDenormal));
+
+        return Yn;
+    }
+};
+
+/** The largest numRegisters of any first-order kernel. */
+static constexpr size_t maxFirstOrderRegisters = 2;
+
+/** Returns the numRegisters of the first-order kernel for a given type. */
+inline size_t getFirstOrderRegisters(TransformationType type) noexcept
+{
+    switch (type)
+    {
+    case TransformationType::directFormI:
+        return FirstOrderKernel<TransformationType::directFormI>::numRegisters;
+    case TransformationType::directFormII:
+        return FirstOrderKernel<TransformationType::directFormII>::numRegisters;
+    case TransformationType::directFormItransposed:
+        return FirstOrderKernel<TransformationType::directFormItransposed>::numRegisters;
+    default:
+        return FirstOrderKernel<TransformationType::directFormIItransposed>::numRegisters;
+    }
+}
+
+//==============================================================================
+template <TransformationType Type>
+struct SecondOrderKernel;
+
+template <>
+struct SecondOrderKernel<TransformationType::directFormI>
+{
+    /** Xn1, Xn2, Yn1, Yn2. */
+    static constexpr size_t numRegisters = 4;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient b2, Coefficient a1, Coefficient a2) noexcept
+    {
+        auto& Xn1 = z[0];
+        auto& Xn2 = z[1];
+        auto& Yn1 = z[2];
+        auto& Yn2 = z[3];
+
+        Value Yn = ((Xn * b0) + (Xn1 * b1) + (Xn2 * b2) + (Yn1 * a1) + (Yn2 * a2));
+
+        Xn2 = Xn1, Yn2 = Yn1;
+        Xn1 = Xn, Yn1 = (Yn + static_cast<Coefficient>(antiDenormal));
+
+        return Yn;
+    }
+};
+
+template <>
+struct SecondOrderKernel<TransformationType::directFormII>
+{
+    /** Wn1, Wn2. */
+    static constexpr size_t numRegisters = 2;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient b2, Coefficient a1, Coefficient a2) noexcept
+    {
+        auto& Wn1 = z[0];
+        auto& Wn2 = z[1];
+
+        Value Wn = (Xn + ((Wn1 * a1) + (Wn2 * a2)));
+        Value Yn = ((Wn * b0) + (Wn1 * b1) + (Wn2 * b2));
+
+        Wn2 = Wn1;
+        Wn1 = (Wn + static_cast<Coefficient>(antiDenormal));
+
+        return Yn;
+    }
+};
+
+template <>
+struct SecondOrderKernel<TransformationType::directFormItransposed>
+{
+    /** Wn1, Wn2, Xn1, Xn2. */
+    static constexpr size_t numRegisters = 4;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient b2, Coefficient a1, Coefficient a2) noexcept
+    {
+        auto& Wn1 = z[0];
+        auto& Wn2 = z[1];
+        auto& Xn1 = z[2];
+        auto& Xn2 = z[3];
+
+        Value Wn = (Xn + Wn2);
+        Value Yn = ((Wn * b0) + Xn2);
+
+        Xn2 = ((Wn * b1) + Xn1), Wn2 = ((Wn * a1) + Wn1 + static_cast<Coefficient>(antiDenormal));
+        Xn1 = (Wn * b2), Wn1 = (Wn * a2);
+
+        return Yn;
+    }
+};
+
+template <>
+struct SecondOrderKernel<TransformationType::directFormIItransposed>
+{
+    /** Xn1, Xn2. */
+    static constexpr size_t numRegisters = 2;
+
+    template <typename Value, typename Coefficient>
+    static Value processSample(Value Xn, Value* z, Coefficient b0, Coefficient b1, Coefficient b2, Coefficient a1, Coefficient a2) noexcept
+    {
+        auto& Xn1 = z[0];
+        auto& Xn2 = z[1];
+
+        Value Yn = ((Xn * b0) + (Xn2));
+
+        Xn2 = ((Xn * b1) + (Xn1) + (Yn * a1) + static_cast<Coefficient>(antiDenormal));
+        Xn1 = ((Xn * b2) + (Yn * a2));
+
+        return Yn;
+    }
+};
+
+/** The largest numRegisters of any second-order kernel. */
+static constexpr size_t maxSecondOrderRegisters = 4;
+
+/** Returns the numRegisters of the second-order kernel for a given type. */
+inline size_t getSecondOrderRegisters(TransformationType type) noexcept
+{
+    switch (type)
+    {
+    case TransformationType::directFormI:
+        return SecondOrderKernel<TransformationType::directFormI>::numRegisters;
+    case TransformationType::directFormII:
+        return SecondOrderKernel<TransformationType::directFormII>::numRegisters;
+    case TransformationType::directFormItransposed:
+        return SecondOrderKernel<TransformationType::directFormItransposed>::numRegisters;
+    default:
+        return SecondOrderKernel<TransformationType::directFormIItransposed>::numRegisters;
+    }
+}
+
+#endif //TRANSFORMATIONS_H_INCLUDED
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 14 Oct 2026 8:40:12pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef TRIPLEBUFFER_H_INCLUDED
+#define TRIPLEBUFFER_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/**
+    Lock-free hand-over of a value from one writer thread to one reader thread.
+
+    The writer owns one slot, the reader owns another, and the third holds the
+    last published value, flagged until the reader takes it. Neither side ever
+    waits, and the reader always gets the newest complete value; values that
+    are overwritten before being read are simply skipped.
+
+    Slots are never copied on hand-over, so Type can hold large preallocated
+    buffers; prepare them all through getSlots() while neither side is running.
+*/
+
+template <typename Type>
+class TripleBuffer
+{
+public:
+    //==============================================================================
+    /** Writer only. Returns the slot to fill in before publish(). */
+    Type& getWriteSlot() noexcept { return slots[static_cast<size_t>(back)]; }
+
+    /** Writer only. Makes the write slot the newest published value. */
+    void publish() noexcept
+    {
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    //==============================================================================
+    /** Reader only. Returns true if a value has been published since the last
+    acquire(). */
+    bool hasFresh() const noexcept
+    {
+        return (middle.load(std::memory_order_acquire) & freshBit) != 0;
+    }
+
+    /** Reader only. Takes the newest published value, if there is a new one,
+    and returns the read slot. The previous read slot may be reused by the
+    writer as soon as this returns. */
+    Type& acquire() noexcept
+    {
+        if (hasFresh())
+            front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+
+        return slots[static_cast<size_t>(front)];
+    }
+
+    /** Reader only. Returns the slot taken by the last acquire(). */
+    Type& getReadSlot() noexcept { return slots[static_cast<size_t>(front)]; }
+    const Type& getReadSlot() const noexcept { return slots[static_cast<size_t>(front)]; }
+
+    //==============================================================================
+    /** Every slot, for preparing or clearing while neither side is running. */
+    std::array<Type, 3>& getSlots() noexcept { return slots; }
+
+private:
+    //==============================================================================
+    static constexpr int freshBit = 4, indexMask = 3;
+
+    std::array<Type, 3> slots;
+    int back = 0, front = 2;
+    std::atomic<int> middle { 1 };
+};
+
+#endif //TRIPLEBUFFER_H_INCLUDED
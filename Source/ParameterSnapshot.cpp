@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 14 Oct 2026 6:02:51pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+ParameterSnapshot::ParameterSnapshot(APVTS& apvts) : state(apvts)
+{
+    output = state.getRawParameterValue("outputID");
+    mix = state.getRawParameterValue("mixID");
+    hpFrequency = state.getRawParameterValue("hpFrequencyID");
+    lsFrequency = state.getRawParameterValue("lsFrequencyID");
+    lsGain = state.getRawParameterValue("lsGainID");
+    hsFrequency = state.getRawParameterValue("hsFrequencyID");
+    hsGain = state.getRawParameterValue("hsGainID");
+    lpFrequency = state.getRawParameterValue("lpFrequencyID");
+    oversampling = state.getRawParameterValue("oversamplingID");
+    design = state.getRawParameterValue("designID");
+    bypass = state.getRawParameterValue("bypassID");
+    hpBypass = state.getRawParameterValue("hpBypassID");
+    lsBypass = state.getRawParameterValue("lsBypassID");
+    hsBypass = state.getRawParameterValue("hsBypassID");
+    lpBypass = state.getRawParameterValue("lpBypassID");
+    hpOrder = state.getRawParameterValue("hpOrderID");
+    lsOrder = state.getRawParameterValue("lsOrderID");
+    hsOrder = state.getRawParameterValue("hsOrderID");
+    lpOrder = state.getRawParameterValue("lpOrderID");
+    phase = state.getRawParameterValue("phaseID");
+    firLength = state.getRawParameterValue("firLengthID");
+    firPartition = state.getRawParameterValue("firPartitionID");
+    scenes = state.getRawParameterValue("scenesID");
+    sceneA = state.getRawParameterValue("sceneAID");
+    sceneB = state.getRawParameterValue("sceneBID");
+    morph = state.getRawParameterValue("morphID");
+    channelMode = state.getRawParameterValue("channelModeID");
+    link = state.getRawParameterValue("linkID");
+    hp2Frequency = state.getRawParameterValue("hp2FrequencyID");
+    ls2Frequency = state.getRawParameterValue("ls2FrequencyID");
+    ls2Gain = state.getRawParameterValue("ls2GainID");
+    hs2Frequency = state.getRawParameterValue("hs2FrequencyID");
+    hs2Gain = state.getRawParameterValue("hs2GainID");
+    lp2Frequency = state.getRawParameterValue("lp2FrequencyID");
+    numPeaks = state.getRawParameterValue("peaksID");
+    lsDynamic = state.getRawParameterValue("lsDynamicID");
+    lsThreshold = state.getRawParameterValue("lsThresholdID");
+    lsRange = state.getRawParameterValue("lsRangeID");
+    hsDynamic = state.getRawParameterValue("hsDynamicID");
+    hsThreshold = state.getRawParameterValue("hsThresholdID");
+    hsRange = state.getRawParameterValue("hsRangeID");
+    dynamicRatio = state.getRawParameterValue("dynamicRatioID");
+    dynamicAttack = state.getRawParameterValue("dynamicAttackID");
+    dynamicRelease = state.getRawParameterValue("dynamicReleaseID");
+    dynamicSource = state.getRawParameterValue("dynamicSourceID");
+    dynamicRate = state.getRawParameterValue("dynamicRateID");
+    dynamicInterpolation = state.getRawParameterValue("dynamicInterpolationID");
+    precision = state.getRawParameterValue("precisionID");
+
+    for (size_t i = 0; i < peakFrequency.size(); ++i)
+    {
+        const auto prefix = "peak" + juce::String(static_cast<int>(i) + 1);
+
+        peakFrequency[i] = state.getRawParameterValue(prefix + "FrequencyID");
+        peakGain[i] = state.getRawParameterValue(prefix + "GainID");
+        peakQ[i] = state.getRawParameterValue(prefix + "QID");
+
+        jassert(peakFrequency[i] != nullptr && peakGain[i] != nullptr && peakQ[i] != nullptr);
+    }
+
+    for (auto* value : { output, mix, hpFrequency, lsFrequency, lsGain, hsFrequency, hsGain, lpFrequency,
+                         oversampling, design, bypass, hpBypass, lsBypass, hsBypass, lpBypass,
+                         hpOrder, lsOrder, hsOrder, lpOrder, phase, firLength, firPartition,
+                         scenes, sceneA, sceneB, morph, channelMode, link,
+                         hp2Frequency, ls2Frequency, ls2Gain, hs2Frequency, hs2Gain, lp2Frequency, numPeaks,
+                         lsDynamic, lsThreshold, lsRange, hsDynamic, hsThreshold, hsRange,
+                         dynamicRatio, dynamicAttack, dynamicRelease, dynamicSource, dynamicRate, dynamicInterpolation, precision })
+    {
+        jassert(value != nullptr);
+        juce::ignoreUnused(value);
+    }
+
+    for (auto* param : state.processor.getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            state.addParameterListener(paramWithID->paramID, this);
+
+    publish();
+}
+
+ParameterSnapshot::~ParameterSnapshot()
+{
+    for (auto* param : state.processor.getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            state.removeParameterListener(paramWithID->paramID, this);
+}
+
+//==============================================================================
+int ParameterSnapshot::Values::limitOversampling(int choice, double sampleRate) noexcept
+{
+    while (choice > 0 && sampleRate * static_cast<double>(1 << choice) > maxFilterRate)
+        --choice;
+
+    return choice;
+}
+
+//==============================================================================
+const ParameterSnapshot::Values& ParameterSnapshot::read() noexcept
+{
+    return published.acquire();
+}
+
+ParameterSnapshot::Values ParameterSnapshot::getValues() const noexcept
+{
+    // Read the version first; a publish racing with the build only makes
+    // these values newer than their version says.
+    const auto newestVersion = getVersion();
+
+    auto values = build();
+    values.version = newestVersion;
+
+    return values;
+}
+
+//==============================================================================
+void ParameterSnapshot::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    juce::ignoreUnused(parameterID, newValue);
+
+    if (batchDepth.load(std::memory_order_acquire) > 0)
+        return;
+
+    publish();
+}
+
+void ParameterSnapshot::beginBatch() noexcept
+{
+    batchDepth.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void ParameterSnapshot::endBatch() noexcept
+{
+    const auto depth = batchDepth.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+    jassert(depth >= 0);
+
+    if (depth == 0)
+        publish();
+}
+
+void ParameterSnapshot::publish() noexcept
+{
+    requests.fetch_add(1, std::memory_order_acq_rel);
+
+    // Whoever holds the lock re-checks the request count after releasing
+    // it, so a writer that can't get in can simply leave.
+    while (writeLock.tryEnter())
+    {
+        const auto seen = requests.load(std::memory_order_acquire);
+
+        auto& slot = published.getWriteSlot();
+        slot = build();
+        slot.version = ++version;
+
+        published.publish();
+
+        writeLock.exit();
+
+        if (requests.load(std::memory_order_acquire) == seen)
+            return;
+    }
+}
+
+ParameterSnapshot::Values ParameterSnapshot::build() const noexcept
+{
+    Values values;
+
+    values.outputGain = juce::Decibels::decibelsToGain(output->load());
+    values.mix = mix->load() * 0.01f;
+    values.hpFrequency = hpFrequency->load();
+    values.lsFrequency = lsFrequency->load();
+    values.lsGain = lsGain->load();
+    values.hsFrequency = hsFrequency->load();
+    values.hsGain = hsGain->load();
+    values.lpFrequency = lpFrequency->load();
+    values.oversampling = juce::roundToInt(oversampling->load());
+    values.design = juce::roundToInt(design->load());
+    values.bypass = bypass->load() >= 0.5f;
+    values.hpBypass = hpBypass->load() >= 0.5f;
+    values.lsBypass = lsBypass->load() >= 0.5f;
+    values.hsBypass = hsBypass->load() >= 0.5f;
+    values.lpBypass = lpBypass->load() >= 0.5f;
+    values.hpOrder = juce::roundToInt(hpOrder->load());
+    values.lsOrder = juce::roundToInt(lsOrder->load());
+    values.hsOrder = juce::roundToInt(hsOrder->load());
+    values.lpOrder = juce::roundToInt(lpOrder->load());
+    values.phase = juce::roundToInt(phase->load());
+    values.firLength = 4096 << juce::roundToInt(firLength->load());
+    values.firPartition = 256 << juce::roundToInt(firPartition->load());
+    values.scenes = scenes->load() >= 0.5f;
+    values.sceneA = juce::roundToInt(sceneA->load());
+    values.sceneB = juce::roundToInt(sceneB->load());
+    values.morph = morph->load() * 0.01f;
+    values.channelMode = juce::roundToInt(channelMode->load());
+    values.link = link->load() >= 0.5f;
+    values.hp2Frequency = hp2Frequency->load();
+    values.ls2Frequency = ls2Frequency->load();
+    values.ls2Gain = ls2Gain->load();
+    values.hs2Frequency = hs2Frequency->load();
+    values.hs2Gain = hs2Gain->load();
+    values.lp2Frequency = lp2Frequency->load();
+    values.numPeaks = juce::roundToInt(numPeaks->load());
+
+    for (size_t i = 0; i < peakFrequency.size(); ++i)
+    {
+        values.peakFrequency[i] = peakFrequency[i]->load();
+        values.peakGain[i] = peakGain[i]->load();
+        values.peakQ[i] = peakQ[i]->load();
+    }
+
+    values.lsDynamic = lsDynamic->load() >= 0.5f;
+    values.lsThreshold = lsThreshold->load();
+    values.lsRange = lsRange->load();
+    values.hsDynamic = hsDynamic->load() >= 0.5f;
+    values.hsThreshold = hsThreshold->load();
+    values.hsRange = hsRange->load();
+    values.dynamicRatio = dynamicRatio->load();
+    values.dynamicAttack = dynamicAttack->load() * 0.001f;
+    values.dynamicRelease = dynamicRelease->load() * 0.001f;
+    values.dynamicSource = juce::roundToInt(dynamicSource->load());
+    values.dynamicInterval = 8 << juce::roundToInt(dynamicRate->load());
+    values.dynamicInterpolation = juce::roundToInt(dynamicInterpolation->load());
+    values.precision = juce::roundToInt(precision->load());
+
+    return values;
+}
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 14 Oct 2026 6:02:51pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PARAMETERSNAPSHOT_H_INCLUDED
+#define PARAMETERSNAPSHOT_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "Modules/TripleBuffer.h"
+
+/**
+    Lock-free hand-over of every parameter the audio thread needs.
+
+    Whenever a parameter changes, on whichever thread the host or editor
+    changes it, the listener builds a complete Values struct with all unit
+    conversions done and publishes it through a triple buffer. The audio
+    thread picks up the newest published Values with a single atomic
+    exchange, and can tell from the version whether anything has changed
+    since it last looked.
+
+    Writers never block: if another writer is part-way through publishing,
+    the change is left for that writer to pick up before it finishes.
+*/
+
+class ParameterSnapshot : private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    using APVTS = juce::AudioProcessorValueTreeState;
+
+    struct Values
+    {
+        /** Linear output gain and wet proportion (0..1). */
+        float outputGain = 1.0f, mix = 1.0f;
+
+        /** Frequencies in Hz, shelf gains in dB. */
+        float hpFrequency = 20.0f, lsFrequency = 20.0f, lsGain = 0.0f;
+        float hsFrequency = 20000.0f, hsGain = 0.0f, lpFrequency = 20000.0f;
+
+        /** Choice indices. */
+        int oversampling = 0, design = 0;
+
+        bool bypass = false, hpBypass = false, lsBypass = false, hsBypass = false, lpBypass = false;
+
+        /** Per-band order choice; 0 is first order, 1 second. */
+        int hpOrder = 0, lsOrder = 0, hsOrder = 0, lpOrder = 0;
+
+        /** Phase mode; 0 is minimum, 1 linear. The FIR length and partition
+        size are in samples. */
+        int phase = 0, firLength = 8192, firPartition = 1024;
+
+        /** Scenes; see SceneBank. The morph runs from scene A (0) to B (1). */
+        bool scenes = false;
+        int sceneA = 0, sceneB = 1;
+        float morph = 0.0f;
+
+        /** Channel mode; 0 is stereo, 1 mid/side, 2 dual mono. Unless linked,
+        the second set of band values applies to side or right. */
+        int channelMode = 0;
+        bool link = true;
+        float hp2Frequency = 20.0f, ls2Frequency = 20.0f, ls2Gain = 0.0f;
+        float hs2Frequency = 20000.0f, hs2Gain = 0.0f, lp2Frequency = 20000.0f;
+
+        /** Peak bands; see PeakCascade. The first numPeaks are heard.
+        Frequencies in Hz, gains in dB. */
+        static constexpr int maxPeaks = 8;
+        int numPeaks = 0;
+        std::array<float, maxPeaks> peakFrequency { { 100.0f, 200.0f, 400.0f, 800.0f, 1600.0f, 3200.0f, 6400.0f, 12800.0f } };
+        std::array<float, maxPeaks> peakGain { {} };
+        std::array<float, maxPeaks> peakQ { { 0.7071f, 0.7071f, 0.7071f, 0.7071f, 0.7071f, 0.7071f, 0.7071f, 0.7071f } };
+
+        /** Dynamic shelves; see EnvelopeFollower. Above its threshold (dB) a
+        dynamic shelf's gain moves by the excess level over the ratio, up to
+        its range (dB) in the range's direction. Attack and release are in
+        seconds; the detector hears the band (0) or the sidechain (1) once
+        every dynamicInterval samples, interpolating the gain held (0) or
+        linearly (1) in between. */
+        bool lsDynamic = false, hsDynamic = false;
+        float lsThreshold = -24.0f, lsRange = -6.0f, hsThreshold = -24.0f, hsRange = -6.0f;
+        float dynamicRatio = 2.0f, dynamicAttack = 0.01f, dynamicRelease = 0.15f;
+        int dynamicSource = 0, dynamicInterval = 32, dynamicInterpolation = 1;
+
+        /** Precision when the host processes in float; 0 runs float
+        throughout, 1 runs the first-order bands in double on the float
+        buffers. Double hosts run in double throughout either way. */
+        int precision = 0;
+
+        /** Incremented by every publish; never 0 once constructed. */
+        juce::uint32 version = 0;
+
+        /** Returns the oversampling choice that runs at the host rate: at most
+        the one keeping the filters within maxFilterRate, above which their
+        lowest frequency, rate / 24576, would pass 20 Hz. */
+        static int limitOversampling(int choice, double sampleRate) noexcept;
+        static constexpr double maxFilterRate = 20.0 * 24576.0;
+    };
+
+    //==============================================================================
+    /** Constructor. Listens to every parameter in the tree. */
+    ParameterSnapshot(APVTS& apvts);
+
+    /** Destructor. */
+    ~ParameterSnapshot() override;
+
+    //==============================================================================
+    /** Audio thread only. Returns the newest published values; the reference
+    stays valid until the next call. */
+    const Values& read() noexcept;
+
+    /** Any thread. Builds values from the current parameter values without
+    publishing them. Their version is that of the newest publish, so a
+    reader can skip work until getVersion() moves on. */
+    Values getValues() const noexcept;
+
+    /** Any thread. Holds back publishing while many parameters change at once,
+    e.g. while restoring state, and publishes once when the outermost batch
+    ends. Calls may nest but must pair up. */
+    void beginBatch() noexcept;
+    void endBatch() noexcept;
+
+    /** Any thread. Returns the version of the newest publish. */
+    juce::uint32 getVersion() const noexcept { return version.load(std::memory_order_acquire); }
+
+private:
+    //==============================================================================
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    /** Builds and publishes a new Values from the current parameter values. */
+    void publish() noexcept;
+
+    Values build() const noexcept;
+
+    //==============================================================================
+    APVTS& state;
+
+    std::atomic<float>* output { nullptr };
+    std::atomic<float>* mix { nullptr };
+    std::atomic<float>* hpFrequency { nullptr };
+    std::atomic<float>* lsFrequency { nullptr };
+    std::atomic<float>* lsGain { nullptr };
+    std::atomic<float>* hsFrequency { nullptr };
+    std::atomic<float>* hsGain { nullptr };
+    std::atomic<float>* lpFrequency { nullptr };
+    std::atomic<float>* oversampling { nullptr };
+    std::atomic<float>* design { nullptr };
+    std::atomic<float>* bypass { nullptr };
+    std::atomic<float>* hpBypass { nullptr };
+    std::atomic<float>* lsBypass { nullptr };
+    std::atomic<float>* hsBypass { nullptr };
+    std::atomic<float>* lpBypass { nullptr };
+    std::atomic<float>* hpOrder { nullptr };
+    std::atomic<float>* lsOrder { nullptr };
+    std::atomic<float>* hsOrder { nullptr };
+    std::atomic<float>* lpOrder { nullptr };
+    std::atomic<float>* phase { nullptr };
+    std::atomic<float>* firLength { nullptr };
+    std::atomic<float>* firPartition { nullptr };
+    std::atomic<float>* scenes { nullptr };
+    std::atomic<float>* sceneA { nullptr };
+    std::atomic<float>* sceneB { nullptr };
+    std::atomic<float>* morph { nullptr };
+    std::atomic<float>* channelMode { nullptr };
+    std::atomic<float>* link { nullptr };
+    std::atomic<float>* hp2Frequency { nullptr };
+    std::atomic<float>* ls2Frequency { nullptr };
+    std::atomic<float>* ls2Gain { nullptr };
+    std::atomic<float>* hs2Frequency { nullptr };
+    std::atomic<float>* hs2Gain { nullptr };
+    std::atomic<float>* lp2Frequency { nullptr };
+    std::atomic<float>* numPeaks { nullptr };
+    std::array<std::atomic<float>*, Values::maxPeaks> peakFrequency {}, peakGain {}, peakQ {};
+    std::atomic<float>* lsDynamic { nullptr };
+    std::atomic<float>* lsThreshold { nullptr };
+    std::atomic<float>* lsRange { nullptr };
+    std::atomic<float>* hsDynamic { nullptr };
+    std::atomic<float>* hsThreshold { nullptr };
+    std::atomic<float>* hsRange { nullptr };
+    std::atomic<float>* dynamicRatio { nullptr };
+    std::atomic<float>* dynamicAttack { nullptr };
+    std::atomic<float>* dynamicRelease { nullptr };
+    std::atomic<float>* dynamicSource { nullptr };
+    std::atomic<float>* dynamicRate { nullptr };
+    std::atomic<float>* dynamicInterpolation { nullptr };
+    std::atomic<float>* precision { nullptr };
+
+    //==============================================================================
+    /** Published values; writers take turns through writeLock. */
+    TripleBuffer<Values> published;
+
+    juce::SpinLock writeLock;
+    std::atomic<juce::uint32> requests { 0 };
+    std::atomic<int> batchDepth { 0 };
+    std::atomic<juce::uint32> version { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSnapshot)
+};
+
+#endif //PARAMETERSNAPSHOT_H_INCLUDED
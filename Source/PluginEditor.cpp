@@ -16,34 +16,90 @@ BiLinearEQAudioProcessorEditor::BiLinearEQAudioProcessorEditor(BiLinearEQAudioPr
     audioProcessor(p),
     state(apvts),
     undoManager(um),
-    subComponents(p, apvts)
+    subComponents(p, apvts),
+    spectrumDisplay(p.getAnalyser(), p.getParameterSnapshot(), p.getSceneBank())
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
 
     
     addAndMakeVisible(subComponents);
+    addAndMakeVisible(spectrumDisplay);
     addAndMakeVisible(undoButton);
     addAndMakeVisible(redoButton);
     undoButton.onClick = [this] { undoManager.undo(); };
     redoButton.onClick = [this] { undoManager.redo(); };
+
+    addAndMakeVisible(storeAButton);
+    addAndMakeVisible(storeBButton);
+    storeAButton.onClick = [this] { audioProcessor.storeScene(audioProcessor.getParameterSnapshot().getValues().sceneA); };
+    storeBButton.onClick = [this] { audioProcessor.storeScene(audioProcessor.getParameterSnapshot().getValues().sceneB); };
+    setOpaque(true);
     setResizable(true, true);
-    setSize(650, 300);
+    setSize(1170, 860);
+
+    audioProcessor.getLoadMeter().setEnabled(true);
+    audioProcessor.getAnalyser().setEnabled(true);
 
     startTimerHz(60);
 }
 
 BiLinearEQAudioProcessorEditor::~BiLinearEQAudioProcessorEditor()
 {
+    audioProcessor.getLoadMeter().setEnabled(false);
+    audioProcessor.getAnalyser().setEnabled(false);
 }
 
 //==============================================================================
 void BiLinearEQAudioProcessorEditor::timerCallback()
 {
+    // Only the atomics published by the audio thread are read here. The peak
+    // is held for a few frames so that single-block spikes stay readable.
+    const auto latest = audioProcessor.getLoadMeter().getStatistics();
+    const auto peakHold = juce::jmax(latest.peakLoad, loadStatistics.peakLoad * 0.95f);
+
+    loadStatistics = latest;
+    loadStatistics.peakLoad = peakHold;
+
+    // Only the meter's own area is repainted, and only when its text changes.
+    auto percent = [](float load) { return juce::String(load * 100.0f, 1) + "%"; };
+
+    const auto text = "DSP " + percent(loadStatistics.averageLoad)
+                      + " (params " + percent(loadStatistics.sectionLoads[ProcessLoadMeter::parameterSection])
+                      + ", filters " + percent(loadStatistics.sectionLoads[ProcessLoadMeter::filterSection])
+                      + ") peak " + percent(loadStatistics.peakLoad)
+                      + " | near xruns " + juce::String(loadStatistics.nearOverruns)
+                      + ", xruns " + juce::String(loadStatistics.overruns);
+
+    if (text != loadMeterText)
+    {
+        loadMeterText = text;
+        repaint(getLoadMeterBounds());
+    }
+
+    spectrumDisplay.update();
 }
 
 void BiLinearEQAudioProcessorEditor::paint (juce::Graphics& g)
 {
+    g.drawImage(background, getLocalBounds().toFloat());
+
+    g.setColour(juce::Colours::antiquewhite);
+    g.setFont(12.0f);
+    g.drawFittedText(loadMeterText, getLoadMeterBounds(), juce::Justification::centredRight, 1);
+}
+
+void BiLinearEQAudioProcessorEditor::renderBackground()
+{
+    // Everything here only changes with the size, so it is drawn once per
+    // resize at the display's scale and copied on every repaint.
+    const auto scale = juce::Component::getApproximateScaleFactorForComponent(this);
+
+    background = juce::Image(juce::Image::RGB, juce::jmax(1, juce::roundToInt(getWidth() * scale)), juce::jmax(1, juce::roundToInt(getHeight() * scale)), false);
+
+    juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll(juce::Colours::darkslateblue);
 
@@ -59,15 +115,26 @@ void BiLinearEQAudioProcessorEditor::paint (juce::Graphics& g)
     g.drawFittedText(ProjectInfo::versionString, getLocalBounds(), juce::Justification::bottomLeft, 1);
 }
 
+juce::Rectangle<int> BiLinearEQAudioProcessorEditor::getLoadMeterBounds() const
+{
+    return getLocalBounds().removeFromBottom(20).removeFromRight(getWidth() / 2 - 20).reduced(4, 0);
+}
+
 void BiLinearEQAudioProcessorEditor::resized()
 {
     // This is generally where you'll want to lay out the positions of any
     // subcomponents in your editor..
 
-    subComponents.setBounds(0, 0, getWidth(), getHeight());
+    // The display sits between the title text and the controls.
+    spectrumDisplay.setBounds(getLocalBounds().withTrimmedTop(20).withHeight(displayHeight).reduced(10, 0));
+    subComponents.setBounds(0, displayHeight + 20, getWidth(), getHeight() - (displayHeight + 20));
     undoButton.setBounds((getWidth() / 2) - 10, getHeight() - 20, 20, 20);
     redoButton.setBounds((getWidth() / 2) + 10, getHeight() - 20, 20, 20);
+    storeAButton.setBounds((getWidth() / 2) - 150, getHeight() - 20, 60, 18);
+    storeBButton.setBounds((getWidth() / 2) - 85, getHeight() - 20, 60, 18);
     subComponents.resized();
     undoButton.resized();
     redoButton.resized();
+
+    renderBackground();
 }
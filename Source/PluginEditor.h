@@ -8,9 +8,10 @@
 
 #pragma once
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "Components/AutoComponent.h"
+#include "Components/SpectrumDisplay.h"
 
 //==============================================================================
 /**
@@ -36,9 +37,26 @@ private:
     juce::UndoManager& undoManager;
 
     AutoComponent subComponents;
+    SpectrumDisplay spectrumDisplay;
+
+    //==========================================================================
+    /** Latest DSP load statistics and where they are drawn. */
+    ProcessLoadMeter::Statistics loadStatistics;
+    juce::String loadMeterText;
+    juce::Rectangle<int> getLoadMeterBounds() const;
+
+    /** Background, outline and project info, drawn once per resize. */
+    juce::Image background;
+    void renderBackground();
+
+    /** Height of the spectrum display above the controls. */
+    static constexpr int displayHeight = 160;
 
     juce::ArrowButton undoButton{ "Undo", 0.5f , juce::Colours::white };
     juce::ArrowButton redoButton{ "Redo", 0.0f , juce::Colours::white };
 
+    /** Store the current controls in the scene selected as A or B. */
+    juce::TextButton storeAButton{ "Store A" }, storeBButton{ "Store B" };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BiLinearEQAudioProcessorEditor)
 };
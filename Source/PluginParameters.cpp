@@ -25,13 +25,33 @@ void Parameters::setParameterLayout(Params& params)
     const auto gainRange = juce::NormalisableRange<float>(dBMin, dBMax, 0.01f, 1.00f);
     const auto mixRange = juce::NormalisableRange<float>(00.00f, 100.00f, 0.01f, 1.00f);
     const auto outputRange = juce::NormalisableRange<float>(dBOut, dBMax, 0.01f, 1.00f);
+    const auto qRange = juce::NormalisableRange<float>(00.10f, 10.00f, 0.001f, 00.289065f);
+    const auto thresholdRange = juce::NormalisableRange<float>(-60.00f, 00.00f, 0.01f, 1.00f);
+    const auto rangeRange = juce::NormalisableRange<float>(-18.00f, 18.00f, 0.01f, 1.00f);
+    const auto ratioRange = juce::NormalisableRange<float>(01.00f, 20.00f, 0.01f, 00.35f);
+    const auto attackRange = juce::NormalisableRange<float>(00.10f, 100.00f, 0.01f, 00.35f);
+    const auto releaseRange = juce::NormalisableRange<float>(05.00f, 2000.00f, 0.01f, 00.35f);
 
     const auto decibels = juce::String { ( "dB" ) };
     const auto frequency = juce::String { ( "Hz" ) };
     const auto percentage = juce::String { ( "%"  ) };
     const auto inOut = juce::String { ("IO") };
+    const auto milliseconds = juce::String { ( "ms" ) };
+    const auto ratio = juce::String { ( ":1" ) };
 
-    //const auto pString = juce::StringArray{ "Floats", "Doubles" };
+    const auto pString = juce::StringArray{ "Float", "Mixed" };
+    const auto osString = juce::StringArray{ "Off", "2x", "4x" };
+    const auto dString = juce::StringArray{ "Bilinear", "Prewarped", "Matched" };
+    const auto oString = juce::StringArray{ "1st", "2nd" };
+    const auto phString = juce::StringArray{ "Minimum", "Linear" };
+    const auto flString = juce::StringArray{ "4096", "8192", "16384", "32768" };
+    const auto fpString = juce::StringArray{ "256", "512", "1024", "2048", "4096" };
+    const auto scString = juce::StringArray{ "1", "2", "3", "4", "5", "6", "7", "8" };
+    const auto cmString = juce::StringArray{ "Stereo", "Mid/Side", "Dual Mono" };
+    const auto pkString = juce::StringArray{ "0", "1", "2", "3", "4", "5", "6", "7", "8" };
+    const auto dsString = juce::StringArray{ "Band", "Sidechain" };
+    const auto drString = juce::StringArray{ "8", "16", "32", "64" };
+    const auto diString = juce::StringArray{ "Hold", "Linear" };
 
     const auto genParam = juce::AudioProcessorParameter::Category::genericParameter;;
     const auto inMeter = juce::AudioProcessorParameter::Category::inputMeter;
@@ -51,7 +71,15 @@ void Parameters::setParameterLayout(Params& params)
             std::make_unique<juce::AudioParameterFloat>("lsGainID", "dB", gainRange, 0.0f, decibels, genParam),
             std::make_unique<juce::AudioParameterFloat>("hsFrequencyID", "HS", freqRange, 20000.00f, frequency, genParam),
             std::make_unique<juce::AudioParameterFloat>("hsGainID", "dB", gainRange, 0.0f, decibels, genParam),
-            std::make_unique<juce::AudioParameterFloat>("lpFrequencyID", "LP", freqRange, 632.455f, frequency, genParam)
+            std::make_unique<juce::AudioParameterFloat>("lpFrequencyID", "LP", freqRange, 632.455f, frequency, genParam),
+            std::make_unique<juce::AudioParameterBool>("hpBypassID", "HP Bypass", false),
+            std::make_unique<juce::AudioParameterBool>("lsBypassID", "LS Bypass", false),
+            std::make_unique<juce::AudioParameterBool>("hsBypassID", "HS Bypass", false),
+            std::make_unique<juce::AudioParameterBool>("lpBypassID", "LP Bypass", false),
+            std::make_unique<juce::AudioParameterChoice>("hpOrderID", "HP Order", oString, 0),
+            std::make_unique<juce::AudioParameterChoice>("lsOrderID", "LS Order", oString, 0),
+            std::make_unique<juce::AudioParameterChoice>("hsOrderID", "HS Order", oString, 0),
+            std::make_unique<juce::AudioParameterChoice>("lpOrderID", "LP Order", oString, 0)
             //==================================================================
             ));
 
@@ -61,8 +89,76 @@ void Parameters::setParameterLayout(Params& params)
             //==================================================================
             std::make_unique<juce::AudioParameterFloat>("outputID", "Output", outputRange, 00.00f, decibels, genParam),
             std::make_unique<juce::AudioParameterFloat>("mixID", "Mix", mixRange, 100.00f, percentage, genParam),
-            std::make_unique<juce::AudioParameterBool>("bypassID", "Bypass", false)/*,
-            std::make_unique<juce::AudioParameterChoice>("precisionID", "Precision", pString, 1)*/
+            std::make_unique<juce::AudioParameterChoice>("oversamplingID", "Oversampling", osString, 0),
+            std::make_unique<juce::AudioParameterChoice>("designID", "Design", dString, 0),
+            std::make_unique<juce::AudioParameterChoice>("phaseID", "Phase", phString, 0),
+            std::make_unique<juce::AudioParameterChoice>("firLengthID", "FIR Length", flString, 1),
+            std::make_unique<juce::AudioParameterChoice>("firPartitionID", "FIR Partition", fpString, 2),
+            std::make_unique<juce::AudioParameterBool>("bypassID", "Bypass", false),
+            std::make_unique<juce::AudioParameterChoice>("precisionID", "Precision", pString, 0)
+            //==================================================================
+            ));
+
+    params.add
+        //======================================================================
+        (std::make_unique<juce::AudioProcessorParameterGroup>("sceneGroupID", "2", "seperator2",
+            //==================================================================
+            std::make_unique<juce::AudioParameterFloat>("morphID", "Morph", mixRange, 0.00f, percentage, genParam),
+            std::make_unique<juce::AudioParameterChoice>("sceneAID", "Scene A", scString, 0),
+            std::make_unique<juce::AudioParameterChoice>("sceneBID", "Scene B", scString, 1),
+            std::make_unique<juce::AudioParameterBool>("scenesID", "Scenes", false)
+            //==================================================================
+            ));
+
+    params.add
+        //======================================================================
+        (std::make_unique<juce::AudioProcessorParameterGroup>("channelsID", "3", "seperator3",
+            //==================================================================
+            std::make_unique<juce::AudioParameterFloat>("hp2FrequencyID", "HP 2", freqRange, 632.455f, frequency, genParam),
+            std::make_unique<juce::AudioParameterFloat>("ls2FrequencyID", "LS 2", freqRange, 20.00f, frequency, genParam),
+            std::make_unique<juce::AudioParameterFloat>("ls2GainID", "dB 2", gainRange, 0.0f, decibels, genParam),
+            std::make_unique<juce::AudioParameterFloat>("hs2FrequencyID", "HS 2", freqRange, 20000.00f, frequency, genParam),
+            std::make_unique<juce::AudioParameterFloat>("hs2GainID", "dB 2", gainRange, 0.0f, decibels, genParam),
+            std::make_unique<juce::AudioParameterFloat>("lp2FrequencyID", "LP 2", freqRange, 632.455f, frequency, genParam),
+            std::make_unique<juce::AudioParameterChoice>("channelModeID", "Channels", cmString, 0),
+            std::make_unique<juce::AudioParameterBool>("linkID", "Link", true)
+            //==================================================================
+            ));
+
+    //==========================================================================
+    /** Peak bands, spaced an octave apart from 100 Hz by default. */
+    auto peaks = std::make_unique<juce::AudioProcessorParameterGroup>("peaksGroupID", "4", "seperator4");
+
+    for (int i = 1; i <= 8; ++i)
+    {
+        const auto prefix = "peak" + juce::String(i);
+        const auto name = "P" + juce::String(i);
+
+        peaks->addChild(std::make_unique<juce::AudioParameterFloat>(prefix + "FrequencyID", name, freqRange, 50.00f * static_cast<float>(1 << i), frequency, genParam));
+        peaks->addChild(std::make_unique<juce::AudioParameterFloat>(prefix + "GainID", name + " dB", gainRange, 0.0f, decibels, genParam));
+        peaks->addChild(std::make_unique<juce::AudioParameterFloat>(prefix + "QID", name + " Q", qRange, 0.7071f, juce::String(), genParam));
+    }
+
+    peaks->addChild(std::make_unique<juce::AudioParameterChoice>("peaksID", "Peaks", pkString, 0));
+
+    params.add(std::move(peaks));
+
+    params.add
+        //======================================================================
+        (std::make_unique<juce::AudioProcessorParameterGroup>("dynamicsID", "5", "seperator5",
+            //==================================================================
+            std::make_unique<juce::AudioParameterFloat>("lsThresholdID", "LS Thresh", thresholdRange, -24.00f, decibels, genParam),
+            std::make_unique<juce::AudioParameterFloat>("lsRangeID", "LS Range", rangeRange, -6.00f, decibels, genParam),
+            std::make_unique<juce::AudioParameterFloat>("hsThresholdID", "HS Thresh", thresholdRange, -24.00f, decibels, genParam),
+            std::make_unique<juce::AudioParameterFloat>("hsRangeID", "HS Range", rangeRange, -6.00f, decibels, genParam),
+            std::make_unique<juce::AudioParameterFloat>("dynamicRatioID", "Ratio", ratioRange, 2.00f, ratio, genParam),
+            std::make_unique<juce::AudioParameterFloat>("dynamicAttackID", "Attack", attackRange, 10.00f, milliseconds, genParam),
+            std::make_unique<juce::AudioParameterFloat>("dynamicReleaseID", "Release", releaseRange, 150.00f, milliseconds, genParam),
+            std::make_unique<juce::AudioParameterChoice>("dynamicSourceID", "Detector", dsString, 0),
+            std::make_unique<juce::AudioParameterChoice>("dynamicRateID", "Control Rate", drString, 2),
+            std::make_unique<juce::AudioParameterChoice>("dynamicInterpolationID", "Interpolation", diString, 1),
+            std::make_unique<juce::AudioParameterBool>("lsDynamicID", "LS Dynamic", false),
+            std::make_unique<juce::AudioParameterBool>("hsDynamicID", "HS Dynamic", false)
             //==================================================================
             ));
 }
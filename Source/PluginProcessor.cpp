@@ -12,16 +12,23 @@
 //==============================================================================
 BiLinearEQAudioProcessor::BiLinearEQAudioProcessor() :
     AudioProcessor(BusesProperties().withInput("Input",     juce::AudioChannelSet::stereo(), true)
-                                    .withOutput("Output",   juce::AudioChannelSet::stereo(), true)),
+                                    .withOutput("Output",   juce::AudioChannelSet::stereo(), true)
+                                    .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)),
     apvts ( *this, &undoManager, "Parameters", createParameterLayout() ),
     parameters ( *this, getAPVTS() ),
-    processorFloat ( *this, getAPVTS(), getSpec() ),
-    processorDouble ( *this, getAPVTS(), getSpec() )
+    parameterSnapshot ( getAPVTS() )
 {
+    bypassPtr = dynamic_cast <juce::AudioParameterBool*> (apvts.getParameter("bypassID"));
+    jassert(bypassPtr != nullptr);
+
+    // Every scene starts out as the default settings.
+    for (int i = 0; i < SceneBank::numScenes; ++i)
+        storeScene(i);
 }
 
 BiLinearEQAudioProcessor::~BiLinearEQAudioProcessor()
 {
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -40,10 +47,8 @@ void BiLinearEQAudioProcessor::setBypassParameter(juce::AudioParameterBool* newB
     if (bypassPtr != newBypass)
     {
         bypassPtr = newBypass;
-        releaseResources();
         reset();
     }
-
 }
 
 bool BiLinearEQAudioProcessor::supportsDoublePrecisionProcessing() const
@@ -51,30 +56,6 @@ bool BiLinearEQAudioProcessor::supportsDoublePrecisionProcessing() const
     return true;
 }
 
-juce::AudioProcessor::ProcessingPrecision BiLinearEQAudioProcessor::getProcessingPrecision() const noexcept
-{
-    return processingPrecision;
-}
-
-bool BiLinearEQAudioProcessor::isUsingDoublePrecision() const noexcept
-{
-    return processingPrecision == doublePrecision;
-}
-
-void BiLinearEQAudioProcessor::setProcessingPrecision(ProcessingPrecision newPrecision) noexcept
-{
-    // If you hit this assertion then you're trying to use double precision
-    // processing on a processor which does not support it!
-    jassert(newPrecision != doublePrecision || supportsDoublePrecisionProcessing());
-
-    if (processingPrecision != newPrecision)
-    {
-        processingPrecision = newPrecision;
-        releaseResources();
-        reset();
-    }
-}
-
 //==============================================================================
 const juce::String BiLinearEQAudioProcessor::getName() const
 {
@@ -98,47 +79,65 @@ bool BiLinearEQAudioProcessor::isMidiEffect() const
 
 double BiLinearEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return tailLengthSeconds.load(std::memory_order_relaxed);
 }
 
 int BiLinearEQAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return SceneBank::numScenes;
 }
 
 int BiLinearEQAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return parameterSnapshot.getValues().sceneA;
 }
 
 void BiLinearEQAudioProcessor::setCurrentProgram (int index)
 {
-    juce::ignoreUnused(index);
+    if (! juce::isPositiveAndBelow(index, SceneBank::numScenes))
+        return;
+
+    // A program is a scene recalled on its own: scene A, no morph. The
+    // audio thread glides there, so switching is click-free. Scene mode
+    // itself is left to the user, as hosts select program 0 on load.
+    auto setParameter = [this](const juce::String& paramID, float value)
+    {
+        if (auto* param = apvts.getParameter(paramID))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    };
+
+    parameterSnapshot.beginBatch();
+
+    setParameter("sceneAID", static_cast<float>(index));
+    setParameter("morphID", 0.0f);
+
+    parameterSnapshot.endBatch();
 }
 
 const juce::String BiLinearEQAudioProcessor::getProgramName (int index)
 {
-    juce::ignoreUnused(index);
-    return {};
+    return sceneBank.getName(index);
 }
 
 void BiLinearEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
-    juce::ignoreUnused(index);
-    juce::ignoreUnused(newName);
+    sceneBank.setName(index, newName);
+}
+
+void BiLinearEQAudioProcessor::storeScene(int index)
+{
+    sceneBank.store(index, parameterSnapshot.getValues());
 }
 
 //==============================================================================
 void BiLinearEQAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     // Use this method as the place to do any pre-playback
-    // initialisation that you need..    
+    // initialisation that you need..
 
-    getProcessingPrecision();
+    juce::ignoreUnused(sampleRate, samplesPerBlock);
 
-    processorFloat.prepare(spec);
-    processorDouble.prepare(spec);
+    prepareProcessor();
 }
 
 void BiLinearEQAudioProcessor::releaseResources()
@@ -146,111 +145,176 @@ void BiLinearEQAudioProcessor::releaseResources()
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
 
-    processorFloat.reset();
-    processorDouble.reset();
+    reset();
 }
 
 void BiLinearEQAudioProcessor::reset()
 {
-    processorFloat.reset();
-    processorDouble.reset();
+    if (processorFloat != nullptr)
+        processorFloat->reset();
+
+    if (processorDouble != nullptr)
+        processorDouble->reset();
+}
+
+void BiLinearEQAudioProcessor::processorLayoutsChanged()
+{
+    // This follows numChannelsChanged() and numBusesChanged() on every
+    // layout change, and hosts often re-prepare straight after anyway, so
+    // only a layout the wrapper hasn't been prepared for is prepared here.
+    if (getBusesLayout() != preparedLayout)
+        prepareProcessor();
+}
+
+void BiLinearEQAudioProcessor::prepareProcessor()
+{
+    // Nothing to prepare until the host has given us a sample rate.
+    if (getSampleRate() <= 0.0)
+        return;
+
+    loadMeter.prepare(getSampleRate());
+    analyser.prepare(getSampleRate());
+
+    // The host sets the precision before calling prepareToPlay(), so this is
+    // the only place the wrappers are created or released. A new wrapper
+    // reads every parameter straight from the APVTS when it is prepared, so
+    // nothing else needs handing over; the filter state is cleared by
+    // prepare() either way.
+    if (isUsingDoublePrecision())
+    {
+        processorFloat.reset();
+
+        if (processorDouble == nullptr)
+            processorDouble = std::make_unique<ProcessWrapper<double>>(*this, getAPVTS(), getSpec());
+
+        processorDouble->prepare(spec);
+        pendingLatency = processorDouble->getLatencySamples();
+    }
+
+    else
+    {
+        processorDouble.reset();
+
+        if (processorFloat == nullptr)
+            processorFloat = std::make_unique<ProcessWrapper<float>>(*this, getAPVTS(), getSpec());
+
+        processorFloat->prepare(spec);
+        pendingLatency = processorFloat->getLatencySamples();
+    }
+
+    preparedLayout = getBusesLayout();
+
+    // Called from the host's preparing thread, so the latency can be
+    // reported right away; anything already queued is now out of date.
+    cancelPendingUpdate();
+    setLatencySamples(pendingLatency);
 }
 
-void BiLinearEQAudioProcessor::numChannelsChanged()
+template <typename SampleType>
+void BiLinearEQAudioProcessor::checkLatency(const ProcessWrapper<SampleType>& wrapper) noexcept
 {
-    processorFloat.reset();
-    processorDouble.reset();
-    processorFloat.prepare(spec);
-    processorDouble.prepare(spec);
+    const auto latency = wrapper.getLatencySamples();
+
+    if (pendingLatency.exchange(latency) != latency || wrapper.needsDesignerUpdate())
+        triggerAsyncUpdate();
 }
 
-void BiLinearEQAudioProcessor::numBusesChanged()
+void BiLinearEQAudioProcessor::handleAsyncUpdate()
 {
-    processorFloat.reset();
-    processorDouble.reset();
-    processorFloat.prepare(spec);
-    processorDouble.prepare(spec);
+    setLatencySamples(pendingLatency);
+
+    if (processorFloat != nullptr)
+        processorFloat->updateDesigner();
+
+    if (processorDouble != nullptr)
+        processorDouble->updateDesigner();
 }
 
-void BiLinearEQAudioProcessor::processorLayoutsChanged()
+void BiLinearEQAudioProcessor::handlePendingUpdates()
 {
-    processorFloat.reset();
-    processorDouble.reset();
-    processorFloat.prepare(spec);
-    processorDouble.prepare(spec);
+    handleUpdateNowIfNeeded();
 }
 
 bool BiLinearEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every channel runs through the same filters, so any layout is fine
+    // as long as there is at least one channel.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
 
+    // The sidechain is only listened to, so it can be off, mono or stereo.
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto sidechain = layouts.getChannelSet(true, 1);
+
+        if (! sidechain.isDisabled() && sidechain != juce::AudioChannelSet::mono() && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     return true;
 }
 
 //==============================================================================
 void BiLinearEQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    getProcessingPrecision();
+    // If you hit this assertion then the host is processing at a precision
+    // other than the one it prepared us for.
+    jassert(processorFloat != nullptr);
 
-    if (bypassPtr->get() == false)
-    {
-        juce::ScopedNoDenormals noDenormals;
+    if (processorFloat == nullptr)
+        return;
 
-        processorFloat.process(buffer, midiMessages);
-    }
+    // The bypass parameter is applied by the wrapper, which mixes the EQ
+    // out at the latency it reports.
+    juce::ScopedNoDenormals noDenormals;
 
-    else
-    {
-        processBlockBypassed(buffer, midiMessages);
-    }
+    processorFloat->process(buffer, midiMessages);
+    checkLatency(*processorFloat);
 }
 
 void BiLinearEQAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
 {
-    getProcessingPrecision();
+    // If you hit this assertion then the host is processing at a precision
+    // other than the one it prepared us for.
+    jassert(processorDouble != nullptr);
 
-    if (bypassPtr->get() == false)
-    {
-        juce::ScopedNoDenormals noDenormals;
+    if (processorDouble == nullptr)
+        return;
 
-        processorDouble.process(buffer, midiMessages);
-    }
-
-    else
-    {
-        processBlockBypassed(buffer, midiMessages);
-    }
-    
-    // If you hit this assertion then either the caller called the double
-    // precision version of processBlock on a processor which does not support it
-    // (i.e. supportsDoublePrecisionProcessing() returns false), or the implementation
-    // of the AudioProcessor forgot to override the double precision version of this method
-    jassertfalse;
+    // The bypass parameter is applied by the wrapper, which mixes the EQ
+    // out at the latency it reports.
+    juce::ScopedNoDenormals noDenormals;
 
+    processorDouble->process(buffer, midiMessages);
+    checkLatency(*processorDouble);
 }
 
 void BiLinearEQAudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    getProcessingPrecision();
+    // Passing the input straight through would jump by the latency the
+    // host compensates; the wrapper keeps running, bypassed, instead.
+    if (processorFloat == nullptr)
+        return;
 
-    juce::ignoreUnused(buffer, midiMessages);
+    juce::ScopedNoDenormals noDenormals;
+
+    processorFloat->process(buffer, midiMessages, true);
+    checkLatency(*processorFloat);
 }
 
 void BiLinearEQAudioProcessor::processBlockBypassed(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
 {
-    getProcessingPrecision();
+    if (processorDouble == nullptr)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;
 
-    juce::ignoreUnused(buffer, midiMessages);
+    processorDouble->process(buffer, midiMessages, true);
+    checkLatency(*processorDouble);
 }
 
 //==============================================================================
@@ -280,16 +344,12 @@ void BiLinearEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
 
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    StateFormat::write(apvts, sceneBank, destData);
 }
 
 void BiLinearEQAudioProcessor::getCurrentProgramStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    StateFormat::write(apvts, sceneBank, destData);
 }
 
 void BiLinearEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -297,20 +357,36 @@ void BiLinearEQAudioProcessor::setStateInformation (const void* data, int sizeIn
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
 
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState.get() != nullptr)
-        if (xmlState->hasTagName(apvts.state.getType()))
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+    restoreState(data, sizeInBytes);
 }
 
 void BiLinearEQAudioProcessor::setCurrentProgramStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+    restoreState(data, sizeInBytes);
+}
+
+void BiLinearEQAudioProcessor::restoreState(const void* data, int sizeInBytes)
+{
+    // Every parameter changes at once, so the audio thread is handed one
+    // snapshot at the end instead of one per parameter.
+    parameterSnapshot.beginBatch();
+
+    if (StateFormat::isBinaryState(data, sizeInBytes))
+    {
+        StateFormat::read(apvts, sceneBank, data, sizeInBytes);
+    }
+
+    // Sessions saved before the binary format hold the tree as XML.
+    else
+    {
+        std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+
+        if (xmlState.get() != nullptr)
+            if (xmlState->hasTagName(apvts.state.getType()))
+                apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+    }
 
-    if (xmlState.get() != nullptr)
-        if (xmlState->hasTagName(apvts.state.getType()))
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+    parameterSnapshot.endBatch();
 }
 
 //==============================================================================
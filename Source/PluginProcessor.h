@@ -8,18 +8,23 @@
 
 #pragma once
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 #include "PluginParameters.h"
 #include "PluginWrapper.h"
+#include "ProcessLoadMeter.h"
+#include "SpectrumAnalyser.h"
+#include "ParameterSnapshot.h"
+#include "StateFormat.h"
+#include "SceneBank.h"
 
 //==============================================================================
 /**
 */
-class BiLinearEQAudioProcessor  : public juce::AudioProcessor
+class BiLinearEQAudioProcessor  : public juce::AudioProcessor,
+                                  private juce::AsyncUpdater
 {
 public:
     using APVTS = juce::AudioProcessorValueTreeState;
-    using precisionType = ProcessingPrecision;
     //==========================================================================
     BiLinearEQAudioProcessor();
     ~BiLinearEQAudioProcessor() override;
@@ -31,17 +36,12 @@ public:
 
     //==========================================================================
     bool supportsDoublePrecisionProcessing() const override;
-    ProcessingPrecision getProcessingPrecision() const noexcept;
-    bool isUsingDoublePrecision() const noexcept;
-    void setProcessingPrecision(ProcessingPrecision newPrecision) noexcept;
 
     //==========================================================================
     void prepareToPlay(double currentSampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void reset() override;
     
-    void numChannelsChanged() override;
-    void numBusesChanged() override;
     void processorLayoutsChanged() override;
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
@@ -87,6 +87,34 @@ public:
     juce::dsp::ProcessSpec spec;
     juce::dsp::ProcessSpec& getSpec() { return spec; };
 
+    /** Parameter values for the audio thread; see ParameterSnapshot. */
+    ParameterSnapshot& getParameterSnapshot() noexcept { return parameterSnapshot; };
+
+    /** Stored scenes, recalled as programs or morphed between. */
+    SceneBank& getSceneBank() noexcept { return sceneBank; };
+
+    /** Message thread only. Stores the current controls in a scene. */
+    void storeScene(int index);
+
+    /** DSP load statistics, measured only while metering is enabled. */
+    ProcessLoadMeter& getLoadMeter() noexcept { return loadMeter; };
+
+    /** Spectrum of the output, fed only while the analyser is enabled. */
+    SpectrumAnalyser& getAnalyser() noexcept { return analyser; };
+
+    /** Called by the wrapper with the tail of the current settings. Safe to
+    call from the audio thread; getTailLengthSeconds() reports it. */
+    void setTailLengthSeconds(double newTailLengthSeconds) noexcept { tailLengthSeconds.store(newTailLengthSeconds, std::memory_order_relaxed); };
+
+    /** Sets how many samples may pass between parameter updates within a
+    block; 0 or less updates once per block. Default = 32 */
+    void setParameterUpdateInterval(int numSamples) noexcept { parameterUpdateInterval.store(numSamples, std::memory_order_relaxed); };
+    int getParameterUpdateInterval() const noexcept { return parameterUpdateInterval.load(std::memory_order_relaxed); };
+
+    /** Message thread only. Handles what the audio thread has left for the
+    message thread straight away, for callers that run no message loop. */
+    void handlePendingUpdates();
+
 private:
     //==========================================================================
     /** Audio processor members. */
@@ -95,17 +123,40 @@ private:
     ProcessWrapper<double> processorDouble { *this, getAPVTS(), getSpec() };*/
 
     Parameters parameters;
-    ProcessWrapper<float> processorFloat;
-    ProcessWrapper<double> processorDouble;
+    ParameterSnapshot parameterSnapshot;
+    SceneBank sceneBank;
+    ProcessLoadMeter loadMeter;
+    SpectrumAnalyser analyser;
+    std::atomic<double> tailLengthSeconds { 0.0 };
+    std::atomic<int> parameterUpdateInterval { 32 };
+
+    /** Only the wrapper for the precision the host prepared us for exists;
+    the other one is released until the host switches precision. */
+    std::unique_ptr<ProcessWrapper<float>> processorFloat;
+    std::unique_ptr<ProcessWrapper<double>> processorDouble;
+
+    /** Restores the parameters from binary or, for older sessions, XML state. */
+    void restoreState(const void* data, int sizeInBytes);
+
+    /** Creates and prepares the wrapper for the current processing precision
+    and releases the other one. */
+    void prepareProcessor();
+
+    /** The layout the wrapper was last prepared for. */
+    BusesLayout preparedLayout;
+
+    /** Latency changes found on the audio thread are reported to the host
+    from the message thread, where linear phase is also prepared and its
+    designer started or stopped. */
+    template <typename SampleType>
+    void checkLatency(const ProcessWrapper<SampleType>& wrapper) noexcept;
+    void handleAsyncUpdate() override;
+    std::atomic<int> pendingLatency { 0 };
 
     //==========================================================================
-    /** Parameter pointers. */
-    juce::AudioParameterChoice* precisionPtr { nullptr };
+    /** Parameter pointers. Precision is read through the ParameterSnapshot
+    like the other parameters. */
     juce::AudioParameterBool* bypassPtr { nullptr };
 
-    //==========================================================================
-    /** Init variables. */
-    precisionType processingPrecision = precisionType::singlePrecision;
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BiLinearEQAudioProcessor)
 };
@@ -16,30 +16,13 @@ ProcessWrapper<SampleType>::ProcessWrapper(BiLinearEQAudioProcessor& p, APVTS& a
 {
     setup.sampleRate = audioProcessor.getSampleRate();
     setup.maximumBlockSize = audioProcessor.getBlockSize();
-    setup.numChannels = audioProcessor.getTotalNumInputChannels();
-
-    bypassPtr = dynamic_cast <juce::AudioParameterBool*> (state.getParameter("bypassID"));
-    precisionPtr = dynamic_cast <juce::AudioParameterChoice*> (state.getParameter("precisionID"));
-    outputPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("outputID"));
-    drywetPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("mixID"));
-    hpFreqPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("hpFrequencyID"));
-    lsFreqPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("lsFrequencyID"));
-    lsGainPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("lsGainID"));
-    hsFreqPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("hsFrequencyID"));
-    hsGainPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("hsGainID"));
-    lpFreqPtr = dynamic_cast <juce::AudioParameterFloat*> (state.getParameter("lpFrequencyID"));
-
-    jassert(bypassPtr != nullptr);
-    jassert(precisionPtr != nullptr);
-    jassert(outputPtr != nullptr);
-    jassert(drywetPtr != nullptr);
-    jassert(hpFreqPtr != nullptr);
-    jassert(lsFreqPtr != nullptr);
-    jassert(lsGainPtr != nullptr);
-    jassert(hsFreqPtr != nullptr);
-    jassert(hsGainPtr != nullptr);
-    jassert(lpFreqPtr != nullptr);
+    setup.numChannels = audioProcessor.getMainBusNumInputChannels();
+}
 
+template <typename SampleType>
+template <typename StateType>
+ProcessWrapper<SampleType>::FirstOrderChain<StateType>::FirstOrderChain()
+{
     hpFilter.setFilterType(FilterType::highPass);
     lsFilter.setFilterType(FilterType::lowShelf);
     hsFilter.setFilterType(FilterType::highShelf);
@@ -49,6 +32,234 @@ ProcessWrapper<SampleType>::ProcessWrapper(BiLinearEQAudioProcessor& p, APVTS& a
     lsFilter.setTransformType(TransformationType::directFormIItransposed);
     hsFilter.setTransformType(TransformationType::directFormIItransposed);
     lpFilter.setTransformType(TransformationType::directFormIItransposed);
+    cascade.setTransformType(TransformationType::directFormIItransposed);
+}
+
+template <typename SampleType>
+template <typename StateType>
+void ProcessWrapper<SampleType>::FirstOrderChain<StateType>::prepare(juce::dsp::ProcessSpec& spec)
+{
+    hpFilter.prepare(spec);
+    lsFilter.prepare(spec);
+    hsFilter.prepare(spec);
+    lpFilter.prepare(spec);
+
+    cascade.prepare(spec);
+}
+
+template <typename SampleType>
+template <typename StateType>
+void ProcessWrapper<SampleType>::FirstOrderChain<StateType>::setSampleRate(double newSampleRate) noexcept
+{
+    hpFilter.setSampleRate(newSampleRate);
+    lsFilter.setSampleRate(newSampleRate);
+    hsFilter.setSampleRate(newSampleRate);
+    lpFilter.setSampleRate(newSampleRate);
+
+    cascade.setSampleRate(newSampleRate);
+}
+
+template <typename SampleType>
+template <typename StateType>
+void ProcessWrapper<SampleType>::FirstOrderChain<StateType>::reset()
+{
+    hpFilter.reset(static_cast<StateType>(0.0));
+    lsFilter.reset(static_cast<StateType>(0.0));
+    hsFilter.reset(static_cast<StateType>(0.0));
+    lpFilter.reset(static_cast<StateType>(0.0));
+    cascade.reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+ProcessWrapper<SampleType>::ChannelGroup::ChannelGroup()
+{
+    hpBand.setFilterType(BiquadType::highPass2);
+    lsBand.setFilterType(BiquadType::lowShelf2);
+    hsBand.setFilterType(BiquadType::highShelf2);
+    lpBand.setFilterType(BiquadType::lowPass2);
+
+    lsFollower.setFilterType(FilterType::lowPass);
+    hsFollower.setFilterType(FilterType::highPass);
+
+    staticRampSeconds = firstOrder.lsFilter.getRampDurationSeconds();
+}
+
+//==============================================================================
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::prepare(juce::dsp::ProcessSpec& spec)
+{
+    firstOrder.prepare(spec);
+    mixedOrder.prepare(spec);
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+        band->prepare(spec);
+
+    peaks.prepare(spec);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::setSampleRate(double newSampleRate) noexcept
+{
+    firstOrder.setSampleRate(newSampleRate);
+    mixedOrder.setSampleRate(newSampleRate);
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+        band->setSampleRate(newSampleRate);
+
+    peaks.setSampleRate(newSampleRate);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::reset()
+{
+    // Back to the static gains first, so the filters start on them.
+    lsOffset = hsOffset = 0.0f;
+    applyShelfGains(false);
+
+    lsFollower.reset();
+    hsFollower.reset();
+
+    firstOrder.reset();
+    mixedOrder.reset();
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+        band->reset();
+
+    peaks.reset();
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::skip(int numSamples) noexcept
+{
+    // Only the chain that runs moves on; the other is reset before it is
+    // next used.
+    if (isMixed)
+        mixedOrder.cascade.skip(numSamples);
+    else
+        firstOrder.cascade.skip(numSamples);
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+        band->skip(numSamples);
+
+    peaks.skip(numSamples);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::snapToZero() noexcept
+{
+    if (isMixed)
+        mixedOrder.cascade.snapToZero();
+    else
+        firstOrder.cascade.snapToZero();
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+        band->snapToZero();
+
+    peaks.snapToZero();
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::ChannelGroup::hasDecayed() const noexcept
+{
+    const auto cascadeHasDecayed = isMixed ? mixedOrder.cascade.hasDecayed() : firstOrder.cascade.hasDecayed();
+
+    return cascadeHasDecayed && hpBand.hasDecayed() && lsBand.hasDecayed() && hsBand.hasDecayed() && lpBand.hasDecayed() && peaks.hasDecayed();
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::ChannelGroup::hasActiveBands() const noexcept
+{
+    return hpBand.isActive() || lsBand.isActive() || hsBand.isActive() || lpBand.isActive() || peaks.isActive();
+}
+
+template <typename SampleType>
+double ProcessWrapper<SampleType>::ChannelGroup::getTailSamples() const noexcept
+{
+    auto tailSamples = isMixed ? mixedOrder.cascade.getTailSamples() : firstOrder.cascade.getTailSamples();
+
+    for (auto* band : { &hpBand, &lsBand, &hsBand, &lpBand })
+        tailSamples += band->getTailSamples(static_cast<SampleType>(1.0e-6));
+
+    return tailSamples + peaks.getTailSamples();
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::prepareDetectors(juce::dsp::ProcessSpec& spec)
+{
+    lsFollower.prepare(spec);
+    hsFollower.prepare(spec);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::skipDetectors(int numSamples) noexcept
+{
+    if (lsDynamic)
+        lsFollower.skip(numSamples);
+
+    if (hsDynamic)
+        hsFollower.skip(numSamples);
+}
+
+template <typename SampleType>
+int ProcessWrapper<SampleType>::ChannelGroup::getSamplesToNextTick() const noexcept
+{
+    auto samples = std::numeric_limits<int>::max();
+
+    if (lsDynamic)
+        samples = juce::jmin(samples, lsFollower.getSamplesToNextTick());
+
+    if (hsDynamic)
+        samples = juce::jmin(samples, hsFollower.getSamplesToNextTick());
+
+    return samples;
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::detect(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    auto moved = false;
+
+    if (lsDynamic && lsFollower.process(block))
+    {
+        lsOffset = getDynamicOffset(static_cast<float>(lsFollower.getLevelDecibels()), lsThreshold, lsRange);
+        moved = true;
+    }
+
+    if (hsDynamic && hsFollower.process(block))
+    {
+        hsOffset = getDynamicOffset(static_cast<float>(hsFollower.getLevelDecibels()), hsThreshold, hsRange);
+        moved = true;
+    }
+
+    if (moved)
+        applyShelfGains(false);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::ChannelGroup::applyShelfGains(bool force)
+{
+    if (hasChanged(lsGain + lsOffset, lsApplied, force))
+    {
+        forEachChain([this](auto& chain) { chain.lsFilter.setGain(lsApplied); });
+        lsBand.setGain(lsApplied);
+    }
+
+    if (hasChanged(hsGain + hsOffset, hsApplied, force))
+    {
+        forEachChain([this](auto& chain) { chain.hsFilter.setGain(hsApplied); });
+        hsBand.setGain(hsApplied);
+    }
+}
+
+template <typename SampleType>
+float ProcessWrapper<SampleType>::ChannelGroup::getDynamicOffset(float levelDecibels, float threshold, float range) const noexcept
+{
+    // Every dB over the threshold moves the gain by 1 - 1 / ratio dB, in
+    // the direction of the range and no further than it.
+    const auto amount = juce::jmax(0.0f, levelDecibels - threshold) * (1.0f - (1.0f / ratio));
+
+    return range < 0.0f ? juce::jmax(range, -amount) : juce::jmin(range, amount);
 }
 
 //==============================================================================
@@ -57,77 +268,794 @@ void ProcessWrapper<SampleType>::prepare(juce::dsp::ProcessSpec& spec)
 {
     spec.sampleRate = audioProcessor.getSampleRate();
     spec.maximumBlockSize = audioProcessor.getBlockSize();
-    spec.numChannels = audioProcessor.getTotalNumInputChannels();
+    spec.numChannels = audioProcessor.getMainBusNumInputChannels();
 
-    mixer.prepare(spec);
+    for (size_t i = 0; i < numOversamplers; ++i)
+    {
+        oversamplers[i] = std::make_unique<juce::dsp::Oversampling<SampleType>>(spec.numChannels, i + 1, juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR, true, true);
+        oversamplers[i]->initProcessing(static_cast<size_t>(spec.maximumBlockSize));
+    }
 
-    hpFilter.prepare(spec);
-    lsFilter.prepare(spec);
-    hsFilter.prepare(spec);
-    lpFilter.prepare(spec);
+    // Prepare once at the highest rate, so that every later switch of the
+    // oversampling factor fits in the buffers allocated here and only has
+    // to move the rate.
+    const auto maxIndex = getMaxOversamplingIndex();
+    auto maxSpec = spec;
+    maxSpec.sampleRate = spec.sampleRate * static_cast<double>(1 << maxIndex);
+    maxSpec.maximumBlockSize = spec.maximumBlockSize << maxIndex;
+
+    for (auto& group : groups)
+        group.prepare(maxSpec);
+
+    // The followers run at the host rate, on the main channels or on the
+    // sidechain, which may have more.
+    const auto sidechainChannels = audioProcessor.getBusCount(true) > 1 ? audioProcessor.getChannelCountOfBus(true, 1) : 0;
+    auto detectorSpec = spec;
+    detectorSpec.numChannels = static_cast<juce::uint32>(juce::jmax(static_cast<int>(spec.numChannels), sidechainChannels));
+
+    for (auto& group : groups)
+        group.prepareDetectors(detectorSpec);
+
+    dryBuffer.setSize(static_cast<int>(maxSpec.numChannels), static_cast<int>(maxSpec.maximumBlockSize));
+
+    switchFade.reset(spec.sampleRate, switchFadeSeconds);
+    switchFade.setCurrentAndTargetValue(static_cast<SampleType>(1.0));
+
+    oversamplingIndex = -1;
+    setOversampling(audioProcessor.getParameterSnapshot().read().oversampling);
+
+    // Linear phase is only prepared for, at about 1.5 MB, once it is first
+    // selected; until then a kernel would never be heard. It is dropped
+    // here when it isn't, so the next time it is prepared for this layout.
+    designer.stopDesigning();
+    linearPhaseWanted = audioProcessor.getParameterSnapshot().read().phase > 0;
+    designerIsReady = false;
 
-    output.prepare(spec);
+    if (linearPhaseWanted)
+        prepareLinearPhase(audioProcessor.getParameterSnapshot().read());
 
+    // Apply the parameters before resetting, so every ramp and crossfade
+    // starts at its target rather than moving there in the first blocks.
+    forceUpdate = true;
+    isSplit = false, isMidSide = false;
+    spreadTo = audioProcessor.getParameterSnapshot().read();
+    spreadVersion = spreadTo.version;
+    isSpreading = false, spreadProportion = 1.0f;
+    isRestartPending = false, isRestartDue = false;
+    audioProcessor.getSceneBank().prepare(spec.sampleRate);
+    update(0);
     reset();
-    update();
+
+    if (linearPhaseWanted)
+        designer.startDesigning();
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::prepareLinearPhase(const ParameterSnapshot::Values& values)
+{
+    // The designer stops its thread first, as it writes to the convolver.
+    designer.prepare(maxKernelLength);
+    convolver.prepare(static_cast<int>(setup.numChannels), maxKernelLength, minPartitionSize, maxPartitionSize);
+
+    // The convolver always has a kernel to start from, with the right
+    // latency, before the audio thread switches to it.
+    typename LinearPhaseDesigner<SampleType>::Request request;
+    fillRequest(request, values);
+    designer.design(request);
+
+    designerIsReady.store(true, std::memory_order_release);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::updateDesigner()
+{
+    if (! linearPhaseWanted.load(std::memory_order_relaxed))
+    {
+        designer.stopDesigning();
+        return;
+    }
+
+    // The audio thread publishes the values it is running as soon as it
+    // switches over, so this first kernel is only a starting point.
+    if (! designerIsReady.load(std::memory_order_acquire))
+        prepareLinearPhase(audioProcessor.getParameterSnapshot().getValues());
+
+    designer.startDesigning();
 }
 
 template <typename SampleType>
 void ProcessWrapper<SampleType>::reset()
 {
-    mixer.reset();
-    hpFilter.reset(static_cast<SampleType>(0.0));
-    lsFilter.reset(static_cast<SampleType>(0.0));
-    hsFilter.reset(static_cast<SampleType>(0.0));
-    lpFilter.reset(static_cast<SampleType>(0.0));
-    output.reset();
+    for (auto& group : groups)
+        group.reset();
+
+    for (auto& os : oversamplers)
+        if (os != nullptr)
+            os->reset();
+
+    // Until it is ready the message thread may be preparing it.
+    if (designerIsReady.load(std::memory_order_acquire))
+        convolver.reset();
+
+    isSleeping = false;
+}
+
+template <typename SampleType>
+int ProcessWrapper<SampleType>::getMaxOversamplingIndex() const noexcept
+{
+    return ParameterSnapshot::Values::limitOversampling(static_cast<int>(numOversamplers), setup.sampleRate);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::requestOversampling(int newIndex)
+{
+    pendingOversamplingIndex = juce::jlimit(0, getMaxOversamplingIndex(), newIndex);
+
+    // Nothing is heard through the oversampler in these cases, so there is
+    // nothing to fade for it; a restart may still be fading out.
+    if (forceUpdate || isLinearPhase || isSleeping)
+    {
+        setOversampling(pendingOversamplingIndex);
+
+        if (! isRestartPending)
+            switchFade.setCurrentAndTargetValue(static_cast<SampleType>(1.0));
+        else
+            switchFade.setTargetValue(static_cast<SampleType>(0.0));
+
+        return;
+    }
+
+    const auto isSwitching = pendingOversamplingIndex != oversamplingIndex || isRestartPending;
+    switchFade.setTargetValue(static_cast<SampleType>(isSwitching ? 0.0 : 1.0));
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::setOversampling(int newIndex)
+{
+    newIndex = juce::jlimit(0, getMaxOversamplingIndex(), newIndex);
+    pendingOversamplingIndex = newIndex;
+
+    if (newIndex == oversamplingIndex)
+        return;
+
+    oversamplingIndex = newIndex;
+    oversampler = newIndex > 0 ? oversamplers[static_cast<size_t>(newIndex - 1)].get() : nullptr;
+
+    for (auto& group : groups)
+        group.setSampleRate(setup.sampleRate * static_cast<double>(1 << newIndex));
+
+    if (oversampler != nullptr)
+        oversampler->reset();
+
+    latencySamples = oversampler != nullptr ? juce::roundToInt(oversampler->getLatencyInSamples()) : 0;
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::fadeSwitch(juce::dsp::AudioBlock<SampleType>& block)
+{
+    const auto numSamples = block.getNumSamples();
+    const auto startGain = switchFade.getCurrentValue();
+    const auto endGain = switchFade.skip(static_cast<int>(numSamples));
+    const auto increment = (endGain - startGain) / static_cast<SampleType>(numSamples);
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        auto* samples = block.getChannelPointer(channel);
+        auto gain = startGain;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            samples[i] *= gain;
+            gain += increment;
+        }
+    }
+
+    // Silent from here, so the switch can't be heard; fade back in from it.
+    if (endGain == static_cast<SampleType>(0.0) && (pendingOversamplingIndex != oversamplingIndex || isRestartPending))
+    {
+        setOversampling(pendingOversamplingIndex);
+
+        if (isRestartPending)
+        {
+            isRestartDue = true;
+            update(0);
+        }
+
+        switchFade.setTargetValue(static_cast<SampleType>(1.0));
+    }
 }
 
 //==============================================================================
 template <typename SampleType>
-void ProcessWrapper<SampleType>::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
+void ProcessWrapper<SampleType>::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages, bool hostBypassed)
 {
+    auto& loadMeter = audioProcessor.getLoadMeter();
+    const auto isMetering = loadMeter.isEnabled();
+
+    if (isMetering)
+        loadMeter.beginBlock();
+
     midiMessages.clear();
 
-    update();
+    isHostBypassed = hostBypassed;
 
+    // Only the main bus is processed; the sidechain, when there is one, is
+    // only listened to by the dynamic shelves. Blocks point into the host's
+    // own channel array, where a bus AudioBuffer would copy it, and allocate
+    // to do so past 32 channels, every block.
+    const auto sidechainChannels = audioProcessor.getBusCount(true) > 1 ? audioProcessor.getChannelCountOfBus(true, 1) : 0;
     juce::dsp::AudioBlock<SampleType> block(buffer);
+    auto mainBlock = block.getSubsetChannelBlock(0, static_cast<size_t>(audioProcessor.getMainBusNumOutputChannels()));
+    auto sidechainBlock = sidechainChannels > 0 ? block.getSubsetChannelBlock(static_cast<size_t>(audioProcessor.getChannelIndexInProcessBlockBuffer(true, 1, 0)), static_cast<size_t>(sidechainChannels))
+                                                : juce::dsp::AudioBlock<SampleType>();
+
+    // Parameters are applied at every update interval rather than once per
+    // block. The host has already applied every change in the block by now,
+    // so a change is spread across the intervals from the values the last
+    // block ended on, and large blocks don't quantise automation to their
+    // size.
+    const auto numSamples = buffer.getNumSamples();
+    const auto interval = audioProcessor.getParameterUpdateInterval();
+    const auto subBlockSize = interval > 0 ? juce::jmin(interval, numSamples) : numSamples;
+    const auto numSubBlocks = subBlockSize > 0 ? (numSamples + subBlockSize - 1) / subBlockSize : 0;
+    const auto& live = audioProcessor.getParameterSnapshot().read();
+
+    if (live.version != spreadVersion)
+    {
+        spreadFrom = spreadTo;
+        spreadTo = live;
+        spreadVersion = live.version;
+        isSpreading = numSubBlocks > 1;
+    }
+
+    for (int start = 0, subBlockIndex = 1; start < numSamples; start += subBlockSize, ++subBlockIndex)
+    {
+        const auto length = juce::jmin(subBlockSize, numSamples - start);
+
+        auto subBlock = mainBlock.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(length));
+        auto subSidechain = sidechainChannels > 0 ? sidechainBlock.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(length)) : sidechainBlock;
+
+        spreadProportion = static_cast<float>(subBlockIndex) / static_cast<float>(numSubBlocks);
+
+        update(length);
+
+        if (isMetering)
+            loadMeter.endSection(ProcessLoadMeter::parameterSection);
+
+        processSubBlock(subBlock, subSidechain);
+
+        if (isMetering)
+            loadMeter.endSection(ProcessLoadMeter::filterSection);
+    }
+
+    isSpreading = false, spreadProportion = 1.0f;
+
+    if (isLinearPhase)
+    {
+        const auto firSamples = static_cast<double>(convolver.getPartitionSize() + convolver.getKernelLength());
+
+        audioProcessor.setTailLengthSeconds(firSamples / setup.sampleRate);
+    }
 
-    mixer.pushDrySamples(block);
+    else
+    {
+        const auto filterRate = setup.sampleRate * static_cast<double>(1 << oversamplingIndex);
+        const auto latency = oversampler != nullptr ? static_cast<double>(oversampler->getLatencyInSamples()) : 0.0;
 
-    auto context = juce::dsp::ProcessContextReplacing(block);
+        auto tailSamples = groups[0].getTailSamples();
 
-    context.isBypassed = bypassPtr->get();
+        if (isSplit)
+            tailSamples = juce::jmax(tailSamples, groups[1].getTailSamples());
 
-    hpFilter.process(context);
-    lsFilter.process(context);
-    hsFilter.process(context);
-    lpFilter.process(context);
-    output.process(context);
+        audioProcessor.setTailLengthSeconds((tailSamples / filterRate) + (latency / setup.sampleRate));
+    }
 
-    mixer.mixWetSamples(block);
+    auto& analyser = audioProcessor.getAnalyser();
+
+    if (analyser.isEnabled())
+        analyser.push(mainBlock);
+
+    if (isMetering)
+        loadMeter.endBlock(numSamples);
 }
 
 template <typename SampleType>
-void ProcessWrapper<SampleType>::update()
+void ProcessWrapper<SampleType>::processSubBlock(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& sidechainBlock)
 {
-    setup.sampleRate = audioProcessor.getSampleRate();
-    setup.maximumBlockSize = audioProcessor.getBlockSize();
-    setup.numChannels = audioProcessor.getTotalNumInputChannels();
+    // A restart at the end of a switch fade may change the channel mode
+    // part way through, so the block is decoded the way it was encoded.
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    const auto codesMidSide = isMidSide;
+    const auto inputIsSilent = codesMidSide ? encodeMidSide(block) : isSilent(block);
+
+    // Once silent input has left nothing in the filters, the output stays
+    // silent until the input changes, so only the ramps and the followers
+    // need to move on.
+    if (inputIsSilent && isSleeping)
+    {
+        if (pendingOversamplingIndex != oversamplingIndex || isRestartPending)
+        {
+            setOversampling(pendingOversamplingIndex);
+
+            if (isRestartPending)
+            {
+                isRestartDue = true;
+                update(0);
+            }
+
+            switchFade.setCurrentAndTargetValue(static_cast<SampleType>(1.0));
+        }
+
+        groups[0].skip(numSamples << oversamplingIndex);
+        groups[0].skipDetectors(numSamples);
+
+        if (isSplit)
+        {
+            groups[1].skip(numSamples << oversamplingIndex);
+            groups[1].skipDetectors(numSamples);
+        }
+
+        block.clear();
+    }
+
+    else
+    {
+        isSleeping = false;
+
+        processFilters(block, sidechainBlock);
+
+        if (switchFade.isSmoothing() || pendingOversamplingIndex != oversamplingIndex || isRestartPending)
+            fadeSwitch(block);
+
+        // Decoding has to visit every sample anyway, so it measures the
+        // output on the way.
+        const auto outputIsSilent = codesMidSide ? decodeMidSide(block) : (inputIsSilent && isSilent(block));
+        const auto groupsHaveDecayed = groups[0].hasDecayed() && (! isSplit || groups[1].hasDecayed());
+        const auto chainHasDecayed = isLinearPhase ? convolver.hasDecayed() : groupsHaveDecayed;
+
+        if (inputIsSilent && outputIsSilent && chainHasDecayed)
+        {
+            isSleeping = true;
+
+            for (auto& group : groups)
+                group.snapToZero();
+
+            if (oversampler != nullptr)
+                oversampler->reset();
+        }
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::processFilters(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& sidechainBlock)
+{
+    // The kernel already carries the bypass, mix and output gain. Bypassed,
+    // it is a bare delay of its own latency, and the convolver crossfades
+    // to it like any other kernel; its input never stops, so nothing stale
+    // is left in it when the EQ comes back.
+    if (isLinearPhase)
+    {
+        convolver.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+        return;
+    }
+
+    if (oversampler != nullptr)
+    {
+        auto oversampledBlock = oversampler->processSamplesUp(block);
+
+        processChain(oversampledBlock, block, sidechainBlock);
+
+        oversampler->processSamplesDown(block);
+    }
+
+    else
+    {
+        processChain(block, block, sidechainBlock);
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::processChain(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& hostBlock, const juce::dsp::AudioBlock<SampleType>& sidechainBlock)
+{
+    // The sidechain is detected across all its channels, so split groups
+    // both follow it as a whole.
+    const auto listensToSidechain = useSidechain && sidechainBlock.getNumChannels() > 0;
+
+    if (! isSplit)
+    {
+        processGroup(groups[0], block, 0, listensToSidechain ? sidechainBlock : hostBlock);
+        return;
+    }
+
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+        auto channelBlock = block.getSubsetChannelBlock(i, 1);
+        processGroup(groups[i], channelBlock, i, listensToSidechain ? sidechainBlock : hostBlock.getSubsetChannelBlock(i, 1));
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::processGroup(ChannelGroup& group, juce::dsp::AudioBlock<SampleType>& block, size_t firstChannel, const juce::dsp::AudioBlock<SampleType>& detectorBlock)
+{
+    if (! group.isDynamic())
+    {
+        processBands(group, block, firstChannel);
+        return;
+    }
+
+    // Each span ends on a tick, so a new shelf gain starts on the sample
+    // after the period it was detected over, whatever the block size. The
+    // detector reads each span before it is processed, which in place at 1x
+    // is the same memory.
+    const auto numSamples = detectorBlock.getNumSamples();
+
+    jassert(block.getNumSamples() == numSamples << oversamplingIndex);
+
+    for (size_t start = 0; start < numSamples;)
+    {
+        const auto span = juce::jmin(static_cast<size_t>(group.getSamplesToNextTick()), numSamples - start);
+
+        group.detect(detectorBlock.getSubBlock(start, span));
+
+        auto spanBlock = block.getSubBlock(start << oversamplingIndex, span << oversamplingIndex);
+        processBands(group, spanBlock, firstChannel);
 
-    audioProcessor.setBypassParameter(bypassPtr);
+        start += span;
+    }
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::processBands(ChannelGroup& group, juce::dsp::AudioBlock<SampleType>& block, size_t firstChannel)
+{
+    auto context = juce::dsp::ProcessContextReplacing<SampleType>(block);
+
+    if (! group.hasActiveBands())
+    {
+        if (group.isMixed)
+            group.mixedOrder.cascade.process(context);
+        else
+            group.firstOrder.cascade.process(context);
+
+        return;
+    }
+
+    auto dryBlock = juce::dsp::AudioBlock<SampleType>(dryBuffer).getSubsetChannelBlock(firstChannel, block.getNumChannels()).getSubBlock(0, block.getNumSamples());
+
+    dryBlock.copyFrom(block);
+
+    for (auto* band : { &group.hpBand, &group.lsBand, &group.hsBand, &group.lpBand })
+        band->process(context);
+
+    group.peaks.process(context);
+
+    if (group.isMixed)
+        group.mixedOrder.cascade.process(context, dryBlock);
+    else
+        group.firstOrder.cascade.process(context, dryBlock);
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::isSilent(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    // Anything below the level snapToZero() flushes counts as silence.
+    const auto range = block.findMinAndMax();
+
+    return juce::jmax(-range.getStart(), range.getEnd()) <= static_cast<SampleType>(1.0e-8);
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::encodeMidSide(juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    jassert(block.getNumChannels() == 2);
 
-    mixer.setWetMixProportion(drywetPtr->get() * 0.01f);
+    auto* left = block.getChannelPointer(0);
+    auto* right = block.getChannelPointer(1);
+    const auto half = static_cast<SampleType>(0.5);
+    auto magnitude = static_cast<SampleType>(0.0);
 
-    hpFilter.setFrequency(hpFreqPtr->get());
-    lsFilter.setFrequency(lsFreqPtr->get());
-    hsFilter.setFrequency(hsFreqPtr->get());
-    lpFilter.setFrequency(lpFreqPtr->get());
+    for (size_t i = 0; i < block.getNumSamples(); ++i)
+    {
+        const auto l = left[i], r = right[i];
 
-    lsFilter.setGain(lsGainPtr->get());
-    hsFilter.setGain(hsGainPtr->get());
+        magnitude = juce::jmax(magnitude, std::abs(l), std::abs(r));
+        left[i] = (l + r) * half;
+        right[i] = (l - r) * half;
+    }
+
+    return magnitude <= static_cast<SampleType>(1.0e-8);
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::decodeMidSide(juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    jassert(block.getNumChannels() == 2);
+
+    auto* mid = block.getChannelPointer(0);
+    auto* side = block.getChannelPointer(1);
+    auto magnitude = static_cast<SampleType>(0.0);
+
+    for (size_t i = 0; i < block.getNumSamples(); ++i)
+    {
+        const auto l = mid[i] + side[i], r = mid[i] - side[i];
+
+        magnitude = juce::jmax(magnitude, std::abs(l), std::abs(r));
+        mid[i] = l;
+        side[i] = r;
+    }
+
+    return magnitude <= static_cast<SampleType>(1.0e-8);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::update(int numSamples)
+{
+    const auto& live = audioProcessor.getParameterSnapshot().read();
+    auto& sceneBank = audioProcessor.getSceneBank();
+    const auto sceneVersion = sceneBank.getVersion();
+    const auto isGliding = live.scenes && sceneBank.isGliding();
+
+    // Linear phase is switched to once the message thread has prepared it,
+    // which no parameter change announces.
+    const auto designerArrived = linearPhaseWanted.load(std::memory_order_relaxed) && ! isLinearPhase
+                                 && designerIsReady.load(std::memory_order_acquire);
+
+    const auto bypassMoved = (live.bypass || isHostBypassed) != isBypassed;
+
+    if (live.version == appliedVersion && sceneVersion == appliedSceneVersion && ! isGliding && ! isSpreading
+        && ! designerArrived && ! isRestartDue && ! bypassMoved && ! forceUpdate)
+        return;
+
+    appliedVersion = live.version;
+    appliedSceneVersion = sceneVersion;
+
+    // With scenes enabled the bank decides where the EQ is, gliding there
+    // over the coming samples; otherwise the controls do.
+    if (! live.scenes)
+        sceneBank.stopGliding();
+
+    const auto& values = live.scenes ? sceneBank.morph(live, numSamples) : (isSpreading ? getSpreadValues() : live);
+
+    isBypassed = values.bypass || isHostBypassed;
+
+    linearPhaseWanted.store(values.phase > 0, std::memory_order_relaxed);
+
+    // Linked, or with anything other than a stereo pair, every channel gets
+    // the same filters, and mid/side coding would cancel out around them.
+    // The same goes for a pair whose second set matches the first, unless
+    // each shelf listens to its own channel; group 0 then designs once for
+    // both.
+    const auto wantsLinearPhase = values.phase > 0 && designerIsReady.load(std::memory_order_acquire);
+    const auto detectsOwnChannel = (values.lsDynamic || values.hsDynamic) && values.dynamicSource == 0;
+    const auto wantsSplit = values.channelMode > 0 && ! values.link && ! wantsLinearPhase && setup.numChannels == 2
+                            && (detectsOwnChannel || ! hasMatchingSets(values));
+    const auto wantsMidSide = wantsSplit && values.channelMode == 1;
+    const auto wantsMixed = values.precision > 0 && std::is_same<SampleType, float>::value;
+
+    // Switching phase mode changes the latency, switching channel mode
+    // what the filter state stands for, and switching precision which
+    // chain holds it, so each path starts again from silence rather than
+    // resuming from stale state. While anything is heard the output fades
+    // out first, the old layout running on until it is silent.
+    const auto needsRestart = wantsLinearPhase != isLinearPhase || wantsSplit != isSplit
+                              || wantsMidSide != isMidSide || wantsMixed != isMixed;
+    const auto restartsNow = needsRestart && (forceUpdate || isSleeping || isRestartDue);
+
+    if (! needsRestart || restartsNow)
+    {
+        isLinearPhase = wantsLinearPhase;
+        isSplit = wantsSplit, isMidSide = wantsMidSide;
+        isMixed = wantsMixed;
+    }
+
+    isRestartPending = needsRestart && ! restartsNow;
+    isRestartDue = false;
+
+    requestOversampling(values.oversampling);
+
+    useSidechain = values.dynamicSource == 1;
+
+    updateGroup(groups[0], values, false);
+
+    if (isSplit)
+        updateGroup(groups[1], values, true);
+    else
+        groups[1].isStale = true;
+
+    if (isLinearPhase)
+    {
+        auto& request = designer.getRequest();
+
+        fillRequest(request, values);
+        request.values.bypass = isBypassed;
+        designer.publishRequest();
+    }
+
+    if (restartsNow && ! forceUpdate)
+        reset();
+
+    forceUpdate = false;
+}
+
+template <typename SampleType>
+const ParameterSnapshot::Values& ProcessWrapper<SampleType>::getSpreadValues() noexcept
+{
+    const auto t = spreadProportion;
+    const auto log = [t](float a, float b) { return a > 0.0f && b > 0.0f ? a * std::pow(b / a, t) : a + ((b - a) * t); };
+    const auto linear = [t](float a, float b) { return a + ((b - a) * t); };
+
+    spreadValues = SceneBank::interpolate(spreadTo, spreadFrom, spreadTo, t);
+
+    spreadValues.hp2Frequency = log(spreadFrom.hp2Frequency, spreadTo.hp2Frequency);
+    spreadValues.ls2Frequency = log(spreadFrom.ls2Frequency, spreadTo.ls2Frequency);
+    spreadValues.ls2Gain = linear(spreadFrom.ls2Gain, spreadTo.ls2Gain);
+    spreadValues.hs2Frequency = log(spreadFrom.hs2Frequency, spreadTo.hs2Frequency);
+    spreadValues.hs2Gain = linear(spreadFrom.hs2Gain, spreadTo.hs2Gain);
+    spreadValues.lp2Frequency = log(spreadFrom.lp2Frequency, spreadTo.lp2Frequency);
+
+    return spreadValues;
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::hasMatchingSets(const ParameterSnapshot::Values& values) noexcept
+{
+    return values.hp2Frequency == values.hpFrequency && values.lp2Frequency == values.lpFrequency
+        && values.ls2Frequency == values.lsFrequency && values.ls2Gain == values.lsGain
+        && values.hs2Frequency == values.hsFrequency && values.hs2Gain == values.hsGain;
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::updateGroup(ChannelGroup& group, const ParameterSnapshot::Values& values, bool useSecondSet)
+{
+    const auto force = forceUpdate || group.isStale;
+    group.isStale = false;
+    group.isMixed = isMixed;
+
+    if (values.design != group.design || force)
+    {
+        group.design = values.design;
+
+        group.forEachChain([&group](auto& chain)
+        {
+            for (auto* filter : { &chain.hpFilter, &chain.lsFilter, &chain.hsFilter, &chain.lpFilter })
+                filter->setDesignType(static_cast<DesignType>(group.design));
+        });
+    }
+
+    // A band set to second order fades its first-order stage out while its
+    // SecondOrderBand fades in, and the other way round.
+    const auto hpSecondOrder = values.hpOrder > 0, lsSecondOrder = values.lsOrder > 0;
+    const auto hsSecondOrder = values.hsOrder > 0, lpSecondOrder = values.lpOrder > 0;
+
+    group.forEachChain([&values, hpSecondOrder, lsSecondOrder, hsSecondOrder, lpSecondOrder](auto& chain)
+    {
+        chain.cascade.setStageBypassed(0, values.hpBypass || hpSecondOrder);
+        chain.cascade.setStageBypassed(1, values.lsBypass || lsSecondOrder);
+        chain.cascade.setStageBypassed(2, values.hsBypass || hsSecondOrder);
+        chain.cascade.setStageBypassed(3, values.lpBypass || lpSecondOrder);
+    });
+
+    // Bypass mixes the wet signal out, so the bands keep running through
+    // it: the output stays at the latency reported, and neither switch
+    // clicks or replays filter state from before it.
+    if (hasChanged(isBypassed ? 0.0f : values.mix, group.drywet, force))
+        group.forEachChain([&group](auto& chain) { chain.cascade.setWetMixProportion(group.drywet); });
+
+    if (hasChanged(useSecondSet ? values.hp2Frequency : values.hpFrequency, group.hpFreq, force))
+    {
+        group.forEachChain([&group](auto& chain) { chain.hpFilter.setFrequency(group.hpFreq); });
+        group.hpBand.setFrequency(group.hpFreq);
+    }
+
+    if (hasChanged(useSecondSet ? values.ls2Frequency : values.lsFrequency, group.lsFreq, force))
+    {
+        group.forEachChain([&group](auto& chain) { chain.lsFilter.setFrequency(group.lsFreq); });
+        group.lsBand.setFrequency(group.lsFreq);
+        group.lsFollower.setFrequency(static_cast<SampleType>(group.lsFreq));
+    }
+
+    if (hasChanged(useSecondSet ? values.hs2Frequency : values.hsFrequency, group.hsFreq, force))
+    {
+        group.forEachChain([&group](auto& chain) { chain.hsFilter.setFrequency(group.hsFreq); });
+        group.hsBand.setFrequency(group.hsFreq);
+        group.hsFollower.setFrequency(static_cast<SampleType>(group.hsFreq));
+    }
+
+    if (hasChanged(useSecondSet ? values.lp2Frequency : values.lpFrequency, group.lpFreq, force))
+    {
+        group.forEachChain([&group](auto& chain) { chain.lpFilter.setFrequency(group.lpFreq); });
+        group.lpBand.setFrequency(group.lpFreq);
+    }
+
+    // The dynamic settings are shared by both halves of a split pair; each
+    // group detects on its own channel. A shelf turning dynamic starts its
+    // follower from silence, and one turning static drops its offset.
+    const auto lsDynamic = values.lsDynamic && ! values.lsBypass;
+    const auto hsDynamic = values.hsDynamic && ! values.hsBypass;
+
+    if (lsDynamic != group.lsDynamic || force)
+    {
+        group.lsFollower.reset();
+        group.lsOffset = 0.0f;
+    }
+
+    if (hsDynamic != group.hsDynamic || force)
+    {
+        group.hsFollower.reset();
+        group.hsOffset = 0.0f;
+    }
+
+    group.lsDynamic = lsDynamic, group.hsDynamic = hsDynamic;
+    group.lsThreshold = values.lsThreshold, group.lsRange = values.lsRange;
+    group.hsThreshold = values.hsThreshold, group.hsRange = values.hsRange;
+    group.ratio = values.dynamicRatio;
+
+    for (auto* follower : { &group.lsFollower, &group.hsFollower })
+    {
+        follower->setAttack(static_cast<SampleType>(values.dynamicAttack));
+        follower->setRelease(static_cast<SampleType>(values.dynamicRelease));
+        follower->setInterval(values.dynamicInterval);
+    }
+
+    // A dynamic shelf's gain moves once per control period, either ramping
+    // linearly over the next period or held until it ends. Kept in the
+    // chain, its stage then never has to fade in from 0 dB.
+    const auto dynamicRampSeconds = values.dynamicInterpolation > 0 ? static_cast<double>(values.dynamicInterval) / setup.sampleRate : 0.0;
+
+    group.forEachChain([&group, lsDynamic, hsDynamic, dynamicRampSeconds](auto& chain)
+    {
+        chain.lsFilter.setRampDurationSeconds(lsDynamic ? dynamicRampSeconds : group.staticRampSeconds);
+        chain.hsFilter.setRampDurationSeconds(hsDynamic ? dynamicRampSeconds : group.staticRampSeconds);
+        chain.cascade.setStageModulated(1, lsDynamic);
+        chain.cascade.setStageModulated(2, hsDynamic);
+    });
+
+    group.lsGain = useSecondSet ? values.ls2Gain : values.lsGain;
+    group.hsGain = useSecondSet ? values.hs2Gain : values.hsGain;
+    group.applyShelfGains(force);
+
+    if (hasChanged(values.outputGain, group.output, force))
+        group.forEachChain([&group](auto& chain) { chain.cascade.setOutputGain(group.output); });
+
+    // Peaks are shared by both halves of a split pair.
+    static_assert(ParameterSnapshot::Values::maxPeaks == static_cast<int>(PeakCascade<SampleType>::maxBands), "Every peak band needs its values");
+
+    for (size_t i = 0; i < group.peakFreq.size(); ++i)
+    {
+        const auto frequencyChanged = hasChanged(values.peakFrequency[i], group.peakFreq[i], force);
+        const auto gainChanged = hasChanged(values.peakGain[i], group.peakGain[i], force);
+        const auto qChanged = hasChanged(values.peakQ[i], group.peakQ[i], force);
+
+        if (frequencyChanged || gainChanged || qChanged)
+            group.peaks.setBand(i, static_cast<SampleType>(group.peakFreq[i]), static_cast<SampleType>(group.peakGain[i]), static_cast<SampleType>(group.peakQ[i]));
+    }
+
+    group.peaks.setNumBands(static_cast<size_t>(values.numPeaks));
+
+    // Enabled last, so a band switched in starts on this update's values.
+    group.hpBand.setEnabled(hpSecondOrder && ! values.hpBypass);
+    group.lsBand.setEnabled(lsSecondOrder && ! values.lsBypass);
+    group.hsBand.setEnabled(hsSecondOrder && ! values.hsBypass);
+    group.lpBand.setEnabled(lpSecondOrder && ! values.lpBypass);
+}
+
+template <typename SampleType>
+void ProcessWrapper<SampleType>::fillRequest(typename LinearPhaseDesigner<SampleType>::Request& request, const ParameterSnapshot::Values& values) const noexcept
+{
+    request.values = values;
+    request.sampleRate = setup.sampleRate;
+    request.filterRate = setup.sampleRate * static_cast<double>(1 << oversamplingIndex);
+    request.length = values.firLength;
+    request.partitionSize = values.firPartition;
+}
+
+template <typename SampleType>
+bool ProcessWrapper<SampleType>::hasChanged(float value, float& lastValue, bool force) noexcept
+{
+    if (value == lastValue && ! force)
+        return false;
 
-    output.setGainLinear(juce::Decibels::decibelsToGain(outputPtr->get()));
+    lastValue = value;
+    return true;
 }
 
 //==============================================================================
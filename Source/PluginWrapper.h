@@ -13,8 +13,14 @@
 #ifndef PLUGINWRAPPER_H_INCLUDED
 #define PLUGINWRAPPER_H_INCLUDED
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 #include "Modules/BiLinearFilters.h"
+#include "Modules/BiLinearCascade.h"
+#include "Modules/SecondOrderBand.h"
+#include "Modules/PeakCascade.h"
+#include "Modules/EnvelopeFollower.h"
+#include "Modules/PartitionedConvolver.h"
+#include "LinearPhaseDesigner.h"
 
 class BiLinearEQAudioProcessor;
 
@@ -35,11 +41,28 @@ public:
     void reset();
 
     //==========================================================================
-    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+    /** Processes the main bus of the buffer; a sidechain bus, if enabled,
+    is only listened to. hostBypassed bypasses the EQ as its own bypass
+    parameter does, for hosts that bypass without it. */
+    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages, bool hostBypassed = false);
 
     //==========================================================================
-    /** Updates the internal state variables of the processor. */
-    void update();
+    /** Updates the internal state variables of the processor for the next
+    numSamples samples. */
+    void update(int numSamples);
+
+    /** Returns the latency of the current oversampling factor, or of the FIR
+    in linear-phase mode, in samples. */
+    int getLatencySamples() const noexcept { return isLinearPhase ? convolver.getLatencySamples() : latencySamples; };
+
+    /** Returns true when linear phase has been selected or deselected and
+    updateDesigner() has yet to follow. Safe to call from the audio thread. */
+    bool needsDesignerUpdate() const noexcept { return linearPhaseWanted.load(std::memory_order_relaxed) != designer.isDesigning(); };
+
+    /** Message thread only. Allocates the convolver and designer the first
+    time linear phase is selected, and runs the designer's thread only while
+    it is. The audio thread stays on minimum phase until this is done. */
+    void updateDesigner();
 
     /*juce::dsp::ProcessSpec spec;
     juce::dsp::ProcessSpec& getSpec() { return spec; };*/
@@ -53,23 +76,244 @@ private:
     juce::dsp::ProcessSpec& setup;
 
     //==========================================================================
-    /** Instantiate objects. */
-    juce::dsp::DryWetMixer<SampleType> mixer;
-    BiLinearFilters<SampleType> hpFilter, lsFilter, hsFilter, lpFilter;
-    juce::dsp::Gain<SampleType> output;
+    /** The first-order stages and the cascade that runs them, designed and
+    run in StateType whatever precision the buffers are in. */
+    template <typename StateType>
+    struct FirstOrderChain
+    {
+        FirstOrderChain();
+
+        void prepare(juce::dsp::ProcessSpec& spec);
+        void setSampleRate(double newSampleRate) noexcept;
+        void reset();
+
+        BiLinearFilters<StateType> hpFilter, lsFilter, hsFilter, lpFilter;
+        BiLinearCascade<StateType> cascade { { &hpFilter, &lsFilter, &hsFilter, &lpFilter } };
+    };
+
+    /** One set of bands with the cascade that runs them, designed from one
+    set of parameter values, and the values it last applied. */
+    struct ChannelGroup
+    {
+        ChannelGroup();
+
+        void prepare(juce::dsp::ProcessSpec& spec);
+        void reset();
+        void skip(int numSamples) noexcept;
+
+        /** Moves every band to a new filter rate, keeping its state, fades
+        and ramps; prepare() must have covered the rate's block size. */
+        void setSampleRate(double newSampleRate) noexcept;
+
+        void snapToZero() noexcept;
+        bool hasDecayed() const noexcept;
+        bool hasActiveBands() const noexcept;
+        double getTailSamples() const noexcept;
+
+        /** Prepares the envelope followers, which run at the host rate on
+        the band's own channels or the sidechain. */
+        void prepareDetectors(juce::dsp::ProcessSpec& spec);
+        void skipDetectors(int numSamples) noexcept;
+
+        /** Returns true while either shelf is dynamic. */
+        bool isDynamic() const noexcept { return lsDynamic || hsDynamic; }
+
+        /** Returns how many host-rate samples remain until a dynamic shelf's
+        follower next updates its level. */
+        int getSamplesToNextTick() const noexcept;
+
+        /** Feeds the dynamic shelves' followers and, on a tick, moves the
+        shelf gains to follow. */
+        void detect(const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+        /** Sets each shelf to its static gain plus its dynamic offset, if
+        that has moved since it was last set or force is set. */
+        void applyShelfGains(bool force);
+
+        /** Returns the dynamic gain change in dB for a detected level. */
+        float getDynamicOffset(float levelDecibels, float threshold, float range) const noexcept;
+
+        /** Passes each first-order chain to function in turn, so both
+        follow every parameter. */
+        template <typename Function>
+        void forEachChain(Function&& function)
+        {
+            function(firstOrder);
+            function(mixedOrder);
+        }
+
+        /** The first-order bands in the buffers' precision and in double;
+        with isMixed, the double chain runs instead, on the same buffers. */
+        FirstOrderChain<SampleType> firstOrder;
+        FirstOrderChain<double> mixedOrder;
+        bool isMixed { false };
+
+        /** Second-order replacements for each band, run ahead of the cascade
+        on the wet path while selected. */
+        SecondOrderBand<SampleType> hpBand, lsBand, hsBand, lpBand;
+
+        /** Peak bands, run on the wet path after the second-order bands. */
+        PeakCascade<SampleType> peaks;
+        std::array<float, PeakCascade<SampleType>::maxBands> peakFreq {}, peakGain {}, peakQ {};
+
+        float output { 0.0f }, drywet { 0.0f }, hpFreq { 0.0f }, lsFreq { 0.0f }, lsGain { 0.0f }, hsFreq { 0.0f }, hsGain { 0.0f }, lpFreq { 0.0f };
+        int design { 0 };
+
+        /** Dynamic shelves: followers, settings, the offset each adds to
+        its shelf's static gain, and the total gain last set. */
+        EnvelopeFollower<SampleType> lsFollower, hsFollower;
+        bool lsDynamic { false }, hsDynamic { false };
+        float lsThreshold { 0.0f }, lsRange { 0.0f }, hsThreshold { 0.0f }, hsRange { 0.0f }, ratio { 1.0f };
+        float lsOffset { 0.0f }, hsOffset { 0.0f }, lsApplied { 0.0f }, hsApplied { 0.0f };
+
+        /** The shelf stages' own ramp, used while they aren't dynamic. */
+        double staticRampSeconds { 0.0 };
+
+        /** Set while the group sits idle, so it takes every value afresh
+        when it is next used. */
+        bool isStale { true };
+    };
+
+    /** Group 0 runs every channel in stereo, or mid/left when split; group
+    1 runs side/right, and only then. Linked, both would design the same
+    coefficients, so group 0 runs alone and the math is done once. */
+    std::array<ChannelGroup, 2> groups;
+
+    /** A copy of the input kept for the dry mix while second-order bands run. */
+    juce::AudioBuffer<SampleType> dryBuffer;
+
+    /** Set while each group runs one channel of a stereo pair; with
+    isMidSide, that pair is mid and side rather than left and right. */
+    bool isSplit { false }, isMidSide { false };
+
+    /** Returns true if the second set of band values is the same as the
+    first, so a split pair would run two copies of the same filters. */
+    static bool hasMatchingSets(const ParameterSnapshot::Values& values) noexcept;
+
+    /** A change of phase, channel or precision mode restarts the chain.
+    isRestartPending is set while the output fades out for it under
+    switchFade, and isRestartDue once it is silent. */
+    bool isRestartPending { false }, isRestartDue { false };
+
+    /** Set while dynamic shelves listen to the sidechain bus rather than to
+    their own channels. */
+    bool useSidechain { false };
+
+    /** Set while float buffers run through the double first-order chains;
+    double buffers always run in double throughout. */
+    bool isMixed { false };
+
+    /** Applies values to a group; the second set of band values when
+    useSecondSet is true. */
+    void updateGroup(ChannelGroup& group, const ParameterSnapshot::Values& values, bool useSecondSet);
+
+    /** Linear-phase mode: an FIR with the magnitude of the whole chain above,
+    designed in the background and run at the host rate in place of the
+    oversampler and filters. The designer is declared last, so its thread
+    stops before the convolver goes away. */
+    static constexpr int maxKernelLength = 32768, minPartitionSize = 256, maxPartitionSize = 4096;
+    PartitionedConvolver<SampleType> convolver;
+    LinearPhaseDesigner<SampleType> designer { convolver };
+    bool isLinearPhase { false };
+
+    /** Set by the audio thread while linear phase is selected, and by the
+    message thread once the convolver and designer are prepared for it. */
+    std::atomic<bool> linearPhaseWanted { false }, designerIsReady { false };
+
+    /** Prepares the convolver and designer and designs a first kernel for
+    the values. Never on the audio thread. */
+    void prepareLinearPhase(const ParameterSnapshot::Values& values);
+
+    /** Fills in a kernel request for the given values at the current rates. */
+    void fillRequest(typename LinearPhaseDesigner<SampleType>::Request& request, const ParameterSnapshot::Values& values) const noexcept;
+
+    //==========================================================================
+    /** Oversamplers for 2x and 4x, created and initialised in prepare() so
+    that the factor can change on the audio thread without allocating. */
+    static constexpr size_t numOversamplers = 2;
+    std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, numOversamplers> oversamplers;
+    juce::dsp::Oversampling<SampleType>* oversampler { nullptr };
+    int oversamplingIndex { -1 }, pendingOversamplingIndex { 0 };
+    int latencySamples { 0 };
+
+    /** Returns the highest oversampling choice the host rate allows; see
+    ParameterSnapshot::Values::limitOversampling(). */
+    int getMaxOversamplingIndex() const noexcept;
+
+    /** The output dips through silence over switchFadeSeconds each way
+    while the factor changes, as the latency and the filter rate step, and
+    for a restart. */
+    static constexpr double switchFadeSeconds = 0.01;
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> switchFade;
+
+    /** Asks for the given choice of the oversampling parameter; 0 is off.
+    The switch waits for the output to fade out, unless nothing is heard. */
+    void requestOversampling(int newIndex);
+
+    /** Switches to the given choice straight away, moving the filters to the
+    new rate without clearing them, and reports the new latency. */
+    void setOversampling(int newIndex);
+
+    /** Runs the switch fade over the block, switching the factor or
+    restarting at its silent point. */
+    void fadeSwitch(juce::dsp::AudioBlock<SampleType>& block);
+
+    //==========================================================================
+    /** Processes one update interval, sleeping while the input is silent. */
+    void processSubBlock(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& sidechainBlock);
+
+    /** Runs the filter chain over the block, oversampled if enabled. */
+    void processFilters(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& sidechainBlock);
+
+    /** Runs the second-order bands and the cascade over one block at the
+    filter rate, each group over its own channels. The host-rate blocks feed
+    the dynamic shelves' followers. */
+    void processChain(juce::dsp::AudioBlock<SampleType>& block, const juce::dsp::AudioBlock<SampleType>& hostBlock, const juce::dsp::AudioBlock<SampleType>& sidechainBlock);
+
+    /** Runs one group over a block whose first channel is firstChannel of
+    the whole buffer. With dynamic shelves, the block is split at each of
+    the followers' ticks, fed from detectorBlock at the host rate. */
+    void processGroup(ChannelGroup& group, juce::dsp::AudioBlock<SampleType>& block, size_t firstChannel, const juce::dsp::AudioBlock<SampleType>& detectorBlock);
+
+    /** Runs a group's bands, peaks and cascade over the block. */
+    void processBands(ChannelGroup& group, juce::dsp::AudioBlock<SampleType>& block, size_t firstChannel);
+
+    /** Returns true if every sample in the block is below the denormal level. */
+    static bool isSilent(const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+    /** Turn the first two channels from left/right into mid/side and back,
+    in place. Each returns isSilent() of the samples it read or wrote, so
+    the coding rides on the silence checks rather than adding passes. */
+    static bool encodeMidSide(juce::dsp::AudioBlock<SampleType>& block) noexcept;
+    static bool decodeMidSide(juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+    /** Set once silent input has fully drained the filters; cleared by any
+    block with signal in it. */
+    bool isSleeping { false };
+
+    //==========================================================================
+    /** Returns true, and stores the new value, if the parameter has moved
+    since it was last applied or force is set. */
+    static bool hasChanged(float value, float& lastValue, bool force) noexcept;
 
     //==========================================================================
-    /** Parameter pointers. */
-    juce::AudioParameterBool* bypassPtr { nullptr };
-    juce::AudioParameterChoice* precisionPtr { nullptr };
-    juce::AudioParameterFloat* outputPtr { nullptr };
-    juce::AudioParameterFloat* drywetPtr { nullptr };
-    juce::AudioParameterFloat* hpFreqPtr { nullptr };
-    juce::AudioParameterFloat* lsFreqPtr { nullptr };
-    juce::AudioParameterFloat* lsGainPtr { nullptr };
-    juce::AudioParameterFloat* hsFreqPtr { nullptr };
-    juce::AudioParameterFloat* hsGainPtr { nullptr };
-    juce::AudioParameterFloat* lpFreqPtr { nullptr };
+    /** Last applied versions, used to skip unchanged updates. */
+    juce::uint32 appliedVersion { 0 }, appliedSceneVersion { 0 };
+
+    //==========================================================================
+    /** The host's automation arrives before each block, so a change is
+    spread across the block's update intervals instead: spreadProportion of
+    the way from the values the last block ended on to the new ones. */
+    ParameterSnapshot::Values spreadFrom, spreadTo, spreadValues;
+    juce::uint32 spreadVersion { 0 };
+    float spreadProportion { 1.0f };
+    bool isSpreading { false };
+
+    /** Returns the values spreadProportion of the way through the current
+    block, including the second set of bands, which scenes don't cover. */
+    const ParameterSnapshot::Values& getSpreadValues() noexcept;
+    bool isBypassed { false }, isHostBypassed { false };
+    bool forceUpdate { true };
 
     //==========================================================================
     /** Init variables. */
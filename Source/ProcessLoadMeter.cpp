@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    ProcessLoadMeter.cpp
+    Created: 14 Oct 2026 8:10:52pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "ProcessLoadMeter.h"
+
+namespace
+{
+    /** Time constant of the rolling averages. */
+    constexpr double averagingSeconds = 0.5;
+}
+
+//==============================================================================
+void ProcessLoadMeter::prepare(double newSampleRate) noexcept
+{
+    jassert(newSampleRate > 0.0);
+
+    sampleRate = newSampleRate;
+    ticksToSeconds = 1.0 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+
+    sectionTicks.fill(0);
+    sectionAverages.fill(0.0f);
+    average = 0.0f;
+
+    publishedAverage.store(0.0f);
+    publishedPeak.store(0.0f);
+
+    for (auto& section : publishedSections)
+        section.store(0.0f);
+
+    nearOverrunCount.store(0);
+    overrunCount.store(0);
+}
+
+void ProcessLoadMeter::setEnabled(bool shouldBeEnabled) noexcept
+{
+    enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void ProcessLoadMeter::beginBlock() noexcept
+{
+    blockStart = sectionStart = juce::Time::getHighResolutionTicks();
+    sectionTicks.fill(0);
+}
+
+void ProcessLoadMeter::endSection(Section section) noexcept
+{
+    jassert(juce::isPositiveAndBelow(static_cast<int>(section), static_cast<int>(numSections)));
+
+    const auto now = juce::Time::getHighResolutionTicks();
+
+    sectionTicks[static_cast<size_t>(section)] += now - sectionStart;
+    sectionStart = now;
+}
+
+void ProcessLoadMeter::endBlock(int numSamples) noexcept
+{
+    if (numSamples <= 0 || ticksToSeconds <= 0.0)
+        return;
+
+    const auto elapsed = juce::Time::getHighResolutionTicks() - blockStart;
+    const auto ticksToLoad = ticksToSeconds * sampleRate / static_cast<double>(numSamples);
+    const auto load = static_cast<float>(static_cast<double>(elapsed) * ticksToLoad);
+
+    // One-pole average whose time constant doesn't depend on the block size.
+    const auto blockSeconds = static_cast<double>(numSamples) / sampleRate;
+    const auto coefficient = static_cast<float>(blockSeconds / (blockSeconds + averagingSeconds));
+
+    average += (load - average) * coefficient;
+    publishedAverage.store(average, std::memory_order_relaxed);
+
+    for (size_t section = 0; section < numSections; ++section)
+    {
+        const auto sectionLoad = static_cast<float>(static_cast<double>(sectionTicks[section]) * ticksToLoad);
+
+        sectionAverages[section] += (sectionLoad - sectionAverages[section]) * coefficient;
+        publishedSections[section].store(sectionAverages[section], std::memory_order_relaxed);
+        sectionTicks[section] = 0;
+    }
+
+    auto peak = publishedPeak.load(std::memory_order_relaxed);
+
+    while (load > peak && ! publishedPeak.compare_exchange_weak(peak, load, std::memory_order_relaxed))
+        ;
+
+    if (load > 1.0f)
+        overrunCount.fetch_add(1, std::memory_order_relaxed);
+    else if (load > nearOverrunLoad)
+        nearOverrunCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+ProcessLoadMeter::Statistics ProcessLoadMeter::getStatistics() noexcept
+{
+    Statistics statistics;
+
+    statistics.averageLoad = publishedAverage.load(std::memory_order_relaxed);
+    statistics.peakLoad = publishedPeak.exchange(0.0f, std::memory_order_relaxed);
+
+    for (size_t section = 0; section < numSections; ++section)
+        statistics.sectionLoads[section] = publishedSections[section].load(std::memory_order_relaxed);
+
+    statistics.nearOverruns = nearOverrunCount.load(std::memory_order_relaxed);
+    statistics.overruns = overrunCount.load(std::memory_order_relaxed);
+
+    return statistics;
+}
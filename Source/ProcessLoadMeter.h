@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    ProcessLoadMeter.h
+    Created: 14 Oct 2026 8:10:52pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef PROCESSLOADMETER_H_INCLUDED
+#define PROCESSLOADMETER_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/**
+    Lock-free measurement of how much of the audio callback budget each
+    section of the processing chain uses.
+
+    The audio thread marks the start of a block, the end of each section and
+    the end of the block; the results are published through atomics for the
+    editor to read. Nothing is measured unless metering is enabled, which the
+    editor does only while it is open.
+*/
+
+class ProcessLoadMeter
+{
+public:
+    enum Section
+    {
+        parameterSection = 0,
+        filterSection,
+        numSections
+    };
+
+    /** Loads are a proportion of the block's real-time budget; 1.0 is all of it. */
+    struct Statistics
+    {
+        float averageLoad = 0.0f, peakLoad = 0.0f;
+        std::array<float, numSections> sectionLoads {};
+        juce::uint32 nearOverruns = 0, overruns = 0;
+    };
+
+    //==============================================================================
+    /** Sets the sample rate used to work out each block's budget and clears
+    all statistics. Must not be called while the audio thread is measuring. */
+    void prepare(double newSampleRate) noexcept;
+
+    /** Starts or stops metering. Safe to call from any thread. */
+    void setEnabled(bool shouldBeEnabled) noexcept;
+
+    /** Returns true if the audio thread should be measuring. */
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    /** Audio thread only. Marks the start of a block. */
+    void beginBlock() noexcept;
+
+    /** Audio thread only. Marks the end of a section, which starts where the
+    block or the previous section ended. A section may be marked several times
+    in one block; its times add up. */
+    void endSection(Section section) noexcept;
+
+    /** Audio thread only. Marks the end of a block of numSamples samples and
+    publishes the results. */
+    void endBlock(int numSamples) noexcept;
+
+    //==============================================================================
+    /** Returns the latest statistics. The peak is reset on each call, so it
+    covers the time since the previous call. */
+    Statistics getStatistics() noexcept;
+
+    /** Blocks using more than this proportion of their budget count as near overruns. */
+    static constexpr float nearOverrunLoad = 0.7f;
+
+private:
+    //==============================================================================
+    /** Runs on the audio thread only. */
+    juce::int64 blockStart = 0, sectionStart = 0;
+    std::array<juce::int64, numSections> sectionTicks {};
+    std::array<float, numSections> sectionAverages {};
+    float average = 0.0f;
+
+    //==============================================================================
+    /** Set in prepare(). */
+    double sampleRate = 44100.0, ticksToSeconds = 0.0;
+
+    //==============================================================================
+    /** Published to the editor. */
+    std::atomic<bool> enabled { false };
+    std::atomic<float> publishedAverage { 0.0f }, publishedPeak { 0.0f };
+    std::array<std::atomic<float>, numSections> publishedSections {};
+    std::atomic<juce::uint32> nearOverrunCount { 0 }, overrunCount { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessLoadMeter)
+};
+
+#endif //PROCESSLOADMETER_H_INCLUDED
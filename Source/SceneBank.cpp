@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    SceneBank.cpp
+    Created: 14 Oct 2026 9:52:18pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "SceneBank.h"
+
+namespace
+{
+    /** Interpolates positive values on a log scale, e.g. frequencies. */
+    float interpolateLog(float a, float b, float proportion) noexcept
+    {
+        if (a <= 0.0f || b <= 0.0f)
+            return a + ((b - a) * proportion);
+
+        return a * std::pow(b / a, proportion);
+    }
+
+    float interpolateLinear(float a, float b, float proportion) noexcept
+    {
+        return a + ((b - a) * proportion);
+    }
+
+    /** Returns value snapped into the parameter's range, or the parameter's
+    default if it isn't finite. */
+    float makeLegal(const juce::AudioProcessorValueTreeState& apvts, const juce::String& paramID, float value)
+    {
+        auto* parameter = apvts.getParameter(paramID);
+
+        jassert(parameter != nullptr);
+
+        if (parameter == nullptr)
+            return std::isfinite(value) ? value : 0.0f;
+
+        if (! std::isfinite(value))
+            return parameter->convertFrom0to1(parameter->getDefaultValue());
+
+        return parameter->getNormalisableRange().snapToLegalValue(value);
+    }
+
+    int makeLegal(const juce::AudioProcessorValueTreeState& apvts, const juce::String& paramID, int value)
+    {
+        return juce::roundToInt(makeLegal(apvts, paramID, static_cast<float>(value)));
+    }
+}
+
+//==============================================================================
+SceneBank::SceneBank()
+{
+    for (int i = 0; i < numScenes; ++i)
+        names.add("Scene " + juce::String(i + 1));
+}
+
+//==============================================================================
+void SceneBank::store(int index, const Values& values) noexcept
+{
+    jassert(juce::isPositiveAndBelow(index, numScenes));
+
+    const auto i = static_cast<size_t>(juce::jlimit(0, numScenes - 1, index));
+
+    scenes[i] = values;
+
+    published[i].getWriteSlot() = values;
+    published[i].publish();
+
+    version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+const SceneBank::Values& SceneBank::getScene(int index) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(index, numScenes));
+
+    return scenes[static_cast<size_t>(juce::jlimit(0, numScenes - 1, index))];
+}
+
+void SceneBank::setName(int index, const juce::String& newName)
+{
+    if (juce::isPositiveAndBelow(index, numScenes))
+        names.set(index, newName);
+}
+
+juce::String SceneBank::getName(int index) const
+{
+    return names[index];
+}
+
+SceneBank::Values SceneBank::getMorphed(const Values& live) const noexcept
+{
+    return interpolate(live, getScene(live.sceneA), getScene(live.sceneB), live.morph);
+}
+
+//==============================================================================
+void SceneBank::prepare(double sampleRate) noexcept
+{
+    glide.reset(sampleRate, glideDurationSeconds);
+    glide.setCurrentAndTargetValue(1.0f);
+    isActive = false;
+    shouldJump = true;
+}
+
+const SceneBank::Values& SceneBank::morph(const Values& live, int numSamples) noexcept
+{
+    const auto sceneVersion = getVersion();
+
+    // A new target glides on from wherever the EQ is now, or from the
+    // controls if the scenes were off; after prepare() there is nothing
+    // to glide from, so the first target is taken at once.
+    if (! isActive || live.version != targetVersion || sceneVersion != targetSceneVersion)
+    {
+        const auto a = static_cast<size_t>(juce::jlimit(0, numScenes - 1, live.sceneA));
+        const auto b = static_cast<size_t>(juce::jlimit(0, numScenes - 1, live.sceneB));
+
+        start = isActive ? current : live;
+        target = interpolate(live, published[a].acquire(), published[b].acquire(), live.morph);
+        targetVersion = live.version;
+        targetSceneVersion = sceneVersion;
+        isActive = true;
+
+        glide.setCurrentAndTargetValue(shouldJump ? 1.0f : 0.0f);
+        glide.setTargetValue(1.0f);
+        shouldJump = false;
+    }
+
+    glide.skip(numSamples);
+
+    current = interpolate(live, start, target, glide.getCurrentValue());
+
+    return current;
+}
+
+//==============================================================================
+void SceneBank::writeScene(juce::OutputStream& stream, const Values& values, const juce::String& name)
+{
+    for (auto value : { values.outputGain, values.mix, values.hpFrequency, values.lsFrequency, values.lsGain,
+                        values.hsFrequency, values.hsGain, values.lpFrequency })
+        stream.writeFloat(value);
+
+    for (auto value : { values.design, values.hpOrder, values.lsOrder, values.hsOrder, values.lpOrder })
+        stream.writeCompressedInt(value);
+
+    for (auto value : { values.hpBypass, values.lsBypass, values.hsBypass, values.lpBypass })
+        stream.writeBool(value);
+
+    stream.writeCompressedInt(values.numPeaks);
+
+    for (size_t i = 0; i < values.peakFrequency.size(); ++i)
+        for (auto value : { values.peakFrequency[i], values.peakGain[i], values.peakQ[i] })
+            stream.writeFloat(value);
+
+    stream.writeString(name);
+}
+
+bool SceneBank::readScene(juce::InputStream& stream, const juce::AudioProcessorValueTreeState& apvts, Values& values, juce::String& name, int formatVersion)
+{
+    // Eight floats, five compressed ints of at least a byte and four bools.
+    if (stream.getNumBytesRemaining() < static_cast<juce::int64>((8 * sizeof(float)) + 5 + 4 + 1))
+        return false;
+
+    for (auto* value : { &values.outputGain, &values.mix, &values.hpFrequency, &values.lsFrequency, &values.lsGain,
+                         &values.hsFrequency, &values.hsGain, &values.lpFrequency })
+        *value = stream.readFloat();
+
+    for (auto* value : { &values.design, &values.hpOrder, &values.lsOrder, &values.hsOrder, &values.lpOrder })
+        *value = stream.readCompressedInt();
+
+    for (auto* value : { &values.hpBypass, &values.lsBypass, &values.hsBypass, &values.lpBypass })
+        *value = stream.readBool();
+
+    // Scenes from before the peak bands keep them off.
+    if (formatVersion >= 3)
+    {
+        if (stream.getNumBytesRemaining() < static_cast<juce::int64>(1 + (3 * values.peakFrequency.size() * sizeof(float))))
+            return false;
+
+        values.numPeaks = juce::jlimit(0, Values::maxPeaks, stream.readCompressedInt());
+
+        for (size_t i = 0; i < values.peakFrequency.size(); ++i)
+            for (auto* value : { &values.peakFrequency[i], &values.peakGain[i], &values.peakQ[i] })
+                *value = stream.readFloat();
+    }
+
+    if (stream.isExhausted())
+        return false;
+
+    name = stream.readString();
+
+    // Scenes hold converted values: the output as a linear gain and the mix
+    // as a proportion.
+    const auto output = std::isfinite(values.outputGain) ? juce::Decibels::gainToDecibels(values.outputGain, -1000.0f) : values.outputGain;
+
+    values.outputGain = juce::Decibels::decibelsToGain(makeLegal(apvts, "outputID", output), -1000.0f);
+    values.mix = makeLegal(apvts, "mixID", values.mix * 100.0f) * 0.01f;
+    values.hpFrequency = makeLegal(apvts, "hpFrequencyID", values.hpFrequency);
+    values.lsFrequency = makeLegal(apvts, "lsFrequencyID", values.lsFrequency);
+    values.lsGain = makeLegal(apvts, "lsGainID", values.lsGain);
+    values.hsFrequency = makeLegal(apvts, "hsFrequencyID", values.hsFrequency);
+    values.hsGain = makeLegal(apvts, "hsGainID", values.hsGain);
+    values.lpFrequency = makeLegal(apvts, "lpFrequencyID", values.lpFrequency);
+
+    values.design = makeLegal(apvts, "designID", values.design);
+    values.hpOrder = makeLegal(apvts, "hpOrderID", values.hpOrder);
+    values.lsOrder = makeLegal(apvts, "lsOrderID", values.lsOrder);
+    values.hsOrder = makeLegal(apvts, "hsOrderID", values.hsOrder);
+    values.lpOrder = makeLegal(apvts, "lpOrderID", values.lpOrder);
+
+    for (size_t i = 0; i < values.peakFrequency.size(); ++i)
+    {
+        const auto prefix = "peak" + juce::String(static_cast<int>(i) + 1);
+
+        values.peakFrequency[i] = makeLegal(apvts, prefix + "FrequencyID", values.peakFrequency[i]);
+        values.peakGain[i] = makeLegal(apvts, prefix + "GainID", values.peakGain[i]);
+        values.peakQ[i] = makeLegal(apvts, prefix + "QID", values.peakQ[i]);
+    }
+
+    return true;
+}
+
+SceneBank::Values SceneBank::interpolate(const Values& live, const Values& a, const Values& b, float proportion) noexcept
+{
+    const auto t = juce::jlimit(0.0f, 1.0f, proportion);
+    const auto& nearer = t < 0.5f ? a : b;
+
+    auto values = live;
+
+    values.outputGain = interpolateLog(a.outputGain, b.outputGain, t);
+    values.mix = interpolateLinear(a.mix, b.mix, t);
+    values.hpFrequency = interpolateLog(a.hpFrequency, b.hpFrequency, t);
+    values.lsFrequency = interpolateLog(a.lsFrequency, b.lsFrequency, t);
+    values.lsGain = interpolateLinear(a.lsGain, b.lsGain, t);
+    values.hsFrequency = interpolateLog(a.hsFrequency, b.hsFrequency, t);
+    values.hsGain = interpolateLinear(a.hsGain, b.hsGain, t);
+    values.lpFrequency = interpolateLog(a.lpFrequency, b.lpFrequency, t);
+
+    // A peak only one scene uses morphs from or to 0 dB at the other's
+    // shape, so it fades rather than jumps.
+    values.numPeaks = juce::jmax(a.numPeaks, b.numPeaks);
+
+    for (size_t i = 0; i < values.peakFrequency.size(); ++i)
+    {
+        const auto inA = static_cast<int>(i) < a.numPeaks, inB = static_cast<int>(i) < b.numPeaks;
+        const auto& shapeA = inA ? a : b;
+        const auto& shapeB = inB ? b : a;
+
+        values.peakFrequency[i] = interpolateLog(shapeA.peakFrequency[i], shapeB.peakFrequency[i], t);
+        values.peakGain[i] = interpolateLinear(inA ? a.peakGain[i] : 0.0f, inB ? b.peakGain[i] : 0.0f, t);
+        values.peakQ[i] = interpolateLog(shapeA.peakQ[i], shapeB.peakQ[i], t);
+    }
+
+    values.design = nearer.design;
+    values.hpBypass = nearer.hpBypass, values.lsBypass = nearer.lsBypass;
+    values.hsBypass = nearer.hsBypass, values.lpBypass = nearer.lpBypass;
+    values.hpOrder = nearer.hpOrder, values.lsOrder = nearer.lsOrder;
+    values.hsOrder = nearer.hsOrder, values.lpOrder = nearer.lpOrder;
+
+    return values;
+}
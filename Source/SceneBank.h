@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    SceneBank.h
+    Created: 14 Oct 2026 9:52:18pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SCENEBANK_H_INCLUDED
+#define SCENEBANK_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "ParameterSnapshot.h"
+#include "Modules/TripleBuffer.h"
+
+/**
+    A bank of stored EQ settings that the audio thread can switch or morph
+    between.
+
+    Each scene holds a complete, already converted ParameterSnapshot::Values
+    and is handed to the audio thread through its own triple buffer, so
+    storing a scene never blocks and recalling one never allocates or locks.
+    With scenes enabled the EQ follows a point between scene A and scene B
+    instead of the controls: frequencies and gains are interpolated on a
+    log scale, the mix linearly, and each band's bypass, order and the
+    design come from the nearer scene. A peak band only one scene uses
+    morphs its gain to or from 0 dB at that scene's shape. Oversampling,
+    phase mode, the FIR settings, the channel mode with its second set of
+    bands, the precision and the global bypass always come from the
+    controls, since changing them is never click-free; so do the dynamic shelf settings,
+    which already move the gains on their own.
+
+    Whenever the point moves, be it through the morph control, a different
+    scene or a stored scene changing, the audio thread glides to it over
+    glideDurationSeconds, and the bands' own ramps smooth each step.
+*/
+
+class SceneBank
+{
+public:
+    using Values = ParameterSnapshot::Values;
+
+    static constexpr int numScenes = 8;
+    static constexpr double glideDurationSeconds = 0.1;
+
+    //==============================================================================
+    /** Constructor. */
+    SceneBank();
+
+    //==============================================================================
+    /** Message thread only. Stores values in a scene. */
+    void store(int index, const Values& values) noexcept;
+
+    /** Message thread only. Returns a scene as last stored. */
+    const Values& getScene(int index) const noexcept;
+
+    /** Message thread only. Scene names, for the host's program list. */
+    void setName(int index, const juce::String& newName);
+    juce::String getName(int index) const;
+
+    /** Message thread only. Returns the settled values the audio thread
+    glides to for the given parameter values. */
+    Values getMorphed(const Values& live) const noexcept;
+
+    /** Any thread. Incremented by every store(). */
+    juce::uint32 getVersion() const noexcept { return version.load(std::memory_order_acquire); }
+
+    //==============================================================================
+    /** Audio thread only. Sets the rate the glide is timed at; the next
+    morph() goes straight to its target. */
+    void prepare(double sampleRate) noexcept;
+
+    /** Audio thread only. Returns the values to apply for the next numSamples
+    samples, given the latest parameter values; the reference stays valid
+    until the next call. */
+    const Values& morph(const Values& live, int numSamples) noexcept;
+
+    /** Audio thread only. Returns true while gliding, when morph() must be
+    called again even if nothing else has changed. */
+    bool isGliding() const noexcept { return glide.isSmoothing(); }
+
+    /** Audio thread only. Makes the next morph() start from where it is going
+    rather than glide to it, e.g. after the scenes were disabled. */
+    void stopGliding() noexcept { isActive = false; }
+
+    //==============================================================================
+    /** Writes and reads one scene and its name, for the plugin state. Reading
+    takes the StateFormat version the scene was written in, and returns
+    false if the stream ends part-way through. Every value read is snapped
+    into the range of the parameter it stands for, and a non-finite one
+    replaced with that parameter's default, as StateFormat does for the
+    parameters themselves. */
+    static void writeScene(juce::OutputStream& stream, const Values& values, const juce::String& name);
+    static bool readScene(juce::InputStream& stream, const juce::AudioProcessorValueTreeState& apvts, Values& values, juce::String& name, int formatVersion);
+
+    /** Returns the values a proportion of the way from a to b, with the
+    settings scenes don't cover taken from live. */
+    static Values interpolate(const Values& live, const Values& a, const Values& b, float proportion) noexcept;
+
+private:
+    //==============================================================================
+    /** Message thread. */
+    std::array<Values, numScenes> scenes;
+    juce::StringArray names;
+
+    /** Message thread to audio thread. */
+    std::array<TripleBuffer<Values>, numScenes> published;
+    std::atomic<juce::uint32> version { 0 };
+
+    //==============================================================================
+    /** Audio thread. The glide runs from start, where the EQ was when the
+    target last moved, to target. */
+    Values start, target, current;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> glide;
+    juce::uint32 targetVersion { 0 }, targetSceneVersion { 0 };
+    bool isActive { false }, shouldJump { true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SceneBank)
+};
+
+#endif //SCENEBANK_H_INCLUDED
@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+    SharedCache.cpp
+    Created: 15 Oct 2026 12:10:26am
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "SharedCache.h"
+
+//==============================================================================
+double SharedCache::Grid::getOmega(int k) const noexcept
+{
+    if (numPoints < 2)
+        return first;
+
+    const auto proportion = static_cast<double>(k) / static_cast<double>(numPoints - 1);
+
+    if (isLogarithmic)
+        return first * std::pow(last / first, proportion);
+
+    return first + ((last - first) * proportion);
+}
+
+bool SharedCache::Grid::operator== (const Grid& other) const noexcept
+{
+    return numPoints == other.numPoints && isLogarithmic == other.isLogarithmic
+        && first == other.first && last == other.last;
+}
+
+bool SharedCache::Key::operator== (const Key& other) const noexcept
+{
+    return sampleRate == other.sampleRate && kind == other.kind && type == other.type && design == other.design
+        && frequency == other.frequency && gain == other.gain && q == other.q && grid == other.grid;
+}
+
+size_t SharedCache::Key::getHash() const noexcept
+{
+    auto hash = static_cast<size_t>(14695981039346656037ull);
+
+    auto combine = [&hash](size_t value) { hash = (hash ^ value) * static_cast<size_t>(1099511628211ull); };
+
+    for (auto value : { sampleRate, frequency, gain, q, grid.first, grid.last })
+        combine(std::hash<double>()(value));
+
+    for (auto value : { static_cast<int>(kind), type, design, grid.numPoints, grid.isLogarithmic ? 1 : 0 })
+        combine(std::hash<int>()(value));
+
+    return hash;
+}
+
+//==============================================================================
+SharedCache::Handle::Handle(SharedCache& c, size_t s, const Key& k) noexcept : cache(&c), slot(s), isHeld(true), key(k)
+{
+}
+
+SharedCache::Handle::Handle(const Key& k, Curve&& c) : isHeld(true), key(k), curve(std::move(c))
+{
+}
+
+SharedCache::Handle::Handle(Handle&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+SharedCache::Handle& SharedCache::Handle::operator= (Handle&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+
+        cache = other.cache, slot = other.slot, isHeld = other.isHeld, key = other.key;
+        curve = std::move(other.curve);
+
+        other.cache = nullptr;
+        other.isHeld = false;
+    }
+
+    return *this;
+}
+
+SharedCache::Handle::~Handle()
+{
+    reset();
+}
+
+const SharedCache::Curve& SharedCache::Handle::getCurve() const noexcept
+{
+    jassert(isHeld);
+
+    return cache != nullptr ? cache->slots[slot].curve : curve;
+}
+
+void SharedCache::Handle::reset() noexcept
+{
+    if (cache != nullptr)
+        cache->release(cache->slots[slot]);
+
+    cache = nullptr;
+    isHeld = false;
+    curve = Curve();
+}
+
+//==============================================================================
+SharedCache::SharedCache() : slots(new Slot[numSlots])
+{
+}
+
+SharedCache::~SharedCache()
+{
+    for (size_t i = 0; i < numSlots; ++i)
+        jassert(slots[i].users.load() == 0);
+}
+
+//==============================================================================
+bool SharedCache::find(const Key& key, size_t& slot) noexcept
+{
+    const auto start = key.getHash();
+
+    for (size_t i = 0; i < maxProbes; ++i)
+    {
+        const auto index = (start + i) % numSlots;
+        auto& candidate = slots[index];
+
+        // Pin first, then look: a pinned slot can't be freed or rewritten,
+        // and ready means its key and curve were written before it was
+        // published.
+        if (! pin(candidate))
+            continue;
+
+        if (candidate.state.load(std::memory_order_acquire) == ready && candidate.key == key)
+        {
+            slot = index;
+            return true;
+        }
+
+        release(candidate);
+    }
+
+    return false;
+}
+
+SharedCache::Handle SharedCache::insert(const Key& key, Curve&& curve)
+{
+    const auto start = key.getHash();
+
+    for (size_t i = 0; i < maxProbes; ++i)
+    {
+        const auto index = (start + i) % numSlots;
+        auto& candidate = slots[index];
+        auto expected = static_cast<int>(empty);
+
+        if (! candidate.state.compare_exchange_strong(expected, writing, std::memory_order_acquire, std::memory_order_relaxed))
+            continue;
+
+        // Two holders missing the same key at once may both get here; each
+        // gets its own slot, which costs only the sharing.
+        candidate.key = key;
+        candidate.curve = std::move(curve);
+        candidate.users.store(1, std::memory_order_relaxed);
+        candidate.state.store(ready, std::memory_order_release);
+
+        return Handle(*this, index, key);
+    }
+
+    return Handle(key, std::move(curve));
+}
+
+bool SharedCache::pin(Slot& slot) noexcept
+{
+    auto users = slot.users.load(std::memory_order_relaxed);
+
+    while (users > 0)
+        if (slot.users.compare_exchange_weak(users, users + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return true;
+
+    return false;
+}
+
+void SharedCache::release(Slot& slot) noexcept
+{
+    if (slot.users.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // Nobody can pin a slot without users, so the curve is ours to free
+    // until it is marked empty again.
+    Curve().swap(slot.curve);
+    slot.state.store(empty, std::memory_order_release);
+}
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    SharedCache.h
+    Created: 15 Oct 2026 12:10:26am
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SHAREDCACHE_H_INCLUDED
+#define SHAREDCACHE_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/**
+    Band response curves shared by every instance of the plugin in the
+    process.
+
+    Hold one through a juce::SharedResourcePointer: the cache is created with
+    the first holder and deleted with the last. Each curve is one band's
+    complex response on a frequency grid, keyed by everything it is designed
+    from, so identical bands in any number of editors or linear-phase
+    designers are evaluated once. A curve lives as long as a Handle to it,
+    and its memory goes with the last one.
+
+    The table has a fixed number of slots, claimed and pinned with atomics
+    only, so lookups never wait on another thread. When every slot a key can
+    go in is taken, the curve is still evaluated and handed back, just not
+    shared. Not for the audio thread: a miss evaluates and allocates.
+*/
+
+class SharedCache
+{
+public:
+    //==============================================================================
+    /** numPoints angular frequencies in radians per sample, from first to last
+    inclusive, spaced logarithmically or linearly. */
+    struct Grid
+    {
+        int numPoints = 0;
+        bool isLogarithmic = false;
+        double first = 0.0, last = 0.0;
+
+        /** Returns the k'th angular frequency. */
+        double getOmega(int k) const noexcept;
+
+        bool operator== (const Grid& other) const noexcept;
+    };
+
+    /** Which of the chain's band designs a Key describes. */
+    enum class BandKind
+    {
+        firstOrder,
+        secondOrder,
+        peak
+    };
+
+    /** Everything one band's curve depends on. type is the band's FilterType
+    or BiquadType, and design its DesignType; unused fields stay at zero. */
+    struct Key
+    {
+        double sampleRate = 0.0;
+        BandKind kind = BandKind::firstOrder;
+        int type = 0, design = 0;
+        double frequency = 0.0, gain = 0.0, q = 0.0;
+        Grid grid;
+
+        bool operator== (const Key& other) const noexcept;
+        size_t getHash() const noexcept;
+    };
+
+    using Curve = std::vector<std::complex<float>>;
+
+    //==============================================================================
+    /** Keeps one curve alive, shared or not, and lets it go on destruction. */
+    class Handle
+    {
+    public:
+        Handle() = default;
+        Handle(Handle&& other) noexcept;
+        Handle& operator= (Handle&& other) noexcept;
+        ~Handle();
+
+        /** Returns true if this holds the curve for the key. */
+        bool matches(const Key& other) const noexcept { return isHeld && key == other; }
+
+        /** Returns the curve; only while something is held. */
+        const Curve& getCurve() const noexcept;
+
+        /** Lets go of the curve. */
+        void reset() noexcept;
+
+    private:
+        friend class SharedCache;
+
+        Handle(SharedCache& c, size_t s, const Key& k) noexcept;
+        Handle(const Key& k, Curve&& c);
+
+        SharedCache* cache = nullptr;
+        size_t slot = 0;
+        bool isHeld = false;
+        Key key;
+
+        /** The curve itself, when the table had no room for it. */
+        Curve curve;
+
+        JUCE_DECLARE_NON_COPYABLE(Handle)
+    };
+
+    //==============================================================================
+    /** Constructor. */
+    SharedCache();
+
+    /** Destructor. Every Handle must have gone first. */
+    ~SharedCache();
+
+    //==============================================================================
+    /** Returns the curve for the key, evaluating evaluate(omega) on the key's
+    grid if no other holder has it already. */
+    template <typename Evaluate>
+    Handle getCurve(const Key& key, Evaluate&& evaluate)
+    {
+        jassert(key.grid.numPoints > 0);
+
+        size_t slot = 0;
+
+        if (find(key, slot))
+            return Handle(*this, slot, key);
+
+        Curve curve(static_cast<size_t>(key.grid.numPoints));
+
+        for (int k = 0; k < key.grid.numPoints; ++k)
+            curve[static_cast<size_t>(k)] = std::complex<float>(evaluate(key.grid.getOmega(k)));
+
+        return insert(key, std::move(curve));
+    }
+
+    /** Slots in the table, and how many from a key's hash it may go in. */
+    static constexpr size_t numSlots = 1024, maxProbes = 32;
+
+private:
+    //==============================================================================
+    /** users counts the Handles pinning the slot; key and curve are only
+    written while it is zero and the slot is claimed, and only read while
+    pinned and ready. */
+    enum SlotState : int
+    {
+        empty,
+        writing,
+        ready
+    };
+
+    struct Slot
+    {
+        std::atomic<int> users { 0 }, state { empty };
+        Key key;
+        Curve curve;
+    };
+
+    //==============================================================================
+    /** Pins the slot holding the key, if there is one. */
+    bool find(const Key& key, size_t& slot) noexcept;
+
+    /** Moves the curve into a free slot, or into the Handle if none is free. */
+    Handle insert(const Key& key, Curve&& curve);
+
+    /** Adds a user to a slot already in use; false if it has none. */
+    bool pin(Slot& slot) noexcept;
+
+    /** Drops a user, freeing the curve with the last. */
+    void release(Slot& slot) noexcept;
+
+    //==============================================================================
+    std::unique_ptr<Slot[]> slots;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedCache)
+};
+
+#endif //SHAREDCACHE_H_INCLUDED
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+    Created: 14 Oct 2026 9:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+
+SpectrumAnalyser::SpectrumAnalyser()
+{
+    ring.assign(static_cast<size_t>(fifo.getTotalSize()), 0.0f);
+    history.assign(static_cast<size_t>(fftSize), 0.0f);
+    fftData.assign(static_cast<size_t>(2 * fftSize), 0.0f);
+    levels.assign(static_cast<size_t>(numBins), minimumLevel);
+
+    // A periodic Hann window, scaled so that a full-scale sine centred on a
+    // bin reads 0 dB.
+    window.resize(static_cast<size_t>(fftSize));
+
+    for (int n = 0; n < fftSize; ++n)
+        window[static_cast<size_t>(n)] = (1.0f - std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(n) / static_cast<float>(fftSize))) * 2.0f / static_cast<float>(fftSize);
+}
+
+//==============================================================================
+void SpectrumAnalyser::prepare(double newSampleRate) noexcept
+{
+    sampleRate.store(newSampleRate, std::memory_order_relaxed);
+}
+
+void SpectrumAnalyser::setEnabled(bool shouldBeEnabled) noexcept
+{
+    enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+}
+
+//==============================================================================
+bool SpectrumAnalyser::process() noexcept
+{
+    const auto numReady = fifo.getNumReady();
+
+    if (numReady == 0)
+        return false;
+
+    // Only the newest fftSize samples can matter; the rest are skipped.
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    auto read = [this](int source, int numSamples)
+    {
+        const auto numToKeep = juce::jmin(numSamples, fftSize);
+        const auto first = ring.begin() + source + (numSamples - numToKeep);
+
+        std::copy(history.begin() + numToKeep, history.end(), history.begin());
+        std::copy_n(first, numToKeep, history.end() - numToKeep);
+    };
+
+    read(start1, size1);
+    read(start2, size2);
+
+    fifo.finishedRead(size1 + size2);
+
+    samplesSinceSpectrum += numReady;
+
+    if (samplesSinceSpectrum < hopSize)
+        return false;
+
+    samplesSinceSpectrum = 0;
+
+    std::transform(history.begin(), history.end(), window.begin(), fftData.begin(), std::multiplies<float>());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // Rises are shown at once, falls at a fixed rate. Once everything has
+    // settled at the floor nothing changes, so silence costs no repaints.
+    auto hasChanged = false;
+
+    for (size_t bin = 0; bin < levels.size(); ++bin)
+    {
+        const auto level = juce::Decibels::gainToDecibels(fftData[bin], minimumLevel);
+        const auto newLevel = juce::jmax(level, levels[bin] - releasePerSpectrum, minimumLevel);
+
+        hasChanged = hasChanged || newLevel != levels[bin];
+        levels[bin] = newLevel;
+    }
+
+    return hasChanged;
+}
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 14 Oct 2026 9:05:37pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef SPECTRUMANALYSER_H_INCLUDED
+#define SPECTRUMANALYSER_H_INCLUDED
+
+#include <JuceHeader.h>
+
+/**
+    Spectrum of the processed output, for the editor.
+
+    The audio thread pushes its output, summed to mono, into a lock-free
+    single-producer single-consumer ring; if the ring is full the newest
+    samples are dropped rather than waiting. The message thread drains the
+    ring on its timer and, whenever enough new samples have arrived, takes a
+    Hann-windowed FFT of the latest fftSize samples and folds it into a
+    smoothed level per bin. Nothing is pushed unless the analyser is
+    enabled, which the editor does only while it is open.
+*/
+
+class SpectrumAnalyser
+{
+public:
+    //==============================================================================
+    static constexpr int fftOrder = 11, fftSize = 1 << fftOrder, numBins = (fftSize / 2) + 1;
+
+    /** Lowest level reported, in dB relative to a full-scale sine. */
+    static constexpr float minimumLevel = -100.0f;
+
+    //==============================================================================
+    /** Constructor. */
+    SpectrumAnalyser();
+
+    //==============================================================================
+    /** Sets the sample rate of the pushed samples. Must not be called while the
+    audio thread is pushing. */
+    void prepare(double newSampleRate) noexcept;
+
+    /** Starts or stops pushing. Safe to call from any thread. */
+    void setEnabled(bool shouldBeEnabled) noexcept;
+
+    /** Returns true if the audio thread should be pushing. */
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /** Returns the sample rate of the pushed samples. */
+    double getSampleRate() const noexcept { return sampleRate.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    /** Audio thread only. Pushes the block's channels, summed to mono. */
+    template <typename SampleType>
+    void push(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        const auto numChannels = static_cast<int>(block.getNumChannels());
+
+        if (numChannels == 0)
+            return;
+
+        const auto numToWrite = juce::jmin(static_cast<int>(block.getNumSamples()), fifo.getFreeSpace());
+        const auto scale = 1.0f / static_cast<float>(numChannels);
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numToWrite, start1, size1, start2, size2);
+
+        auto write = [&](int destination, int source, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto sum = 0.0f;
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    sum += static_cast<float>(block.getSample(channel, source + i));
+
+                ring[static_cast<size_t>(destination + i)] = sum * scale;
+            }
+        };
+
+        write(start1, 0, size1);
+        write(start2, size1, size2);
+
+        fifo.finishedWrite(size1 + size2);
+    }
+
+    //==============================================================================
+    /** Message thread only. Drains the ring and, if at least hopSize new
+    samples have arrived, updates the levels. Returns true if they changed. */
+    bool process() noexcept;
+
+    /** Message thread only. Smoothed level of each bin in dB, never below
+    minimumLevel. */
+    const std::vector<float>& getLevels() const noexcept { return levels; }
+
+    /** Returns the frequency of a bin in Hz. */
+    double getBinFrequency(int bin) const noexcept { return static_cast<double>(bin) * getSampleRate() / static_cast<double>(fftSize); }
+
+    /** New samples needed between spectra, and how fast a level falls back
+    once its bin goes quiet, in dB per spectrum. */
+    static constexpr int hopSize = fftSize / 4;
+    static constexpr float releasePerSpectrum = 3.0f;
+
+private:
+    //==============================================================================
+    /** Written by the audio thread ahead of the fifo's write position. */
+    juce::AbstractFifo fifo { 4 * fftSize };
+    std::vector<float> ring;
+
+    //==============================================================================
+    /** Message thread only. */
+    juce::dsp::FFT fft { fftOrder };
+    std::vector<float> history, window, fftData, levels;
+    int samplesSinceSpectrum = 0;
+
+    std::atomic<bool> enabled { false };
+    std::atomic<double> sampleRate { 44100.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyser)
+};
+
+#endif //SPECTRUMANALYSER_H_INCLUDED
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    StateFormat.cpp
+    Created: 14 Oct 2026 9:31:04pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#include "StateFormat.h"
+
+namespace
+{
+    /** The property names APVTS gives each parameter's child of the state
+    tree; the same names appear in the XML form. */
+    const juce::Identifier idProperty { "id" }, valueProperty { "value" };
+
+    /** Smallest possible entry: an empty ID's terminator and a float. */
+    constexpr juce::int64 minimumEntrySize = 1 + sizeof(float);
+}
+
+//==============================================================================
+void StateFormat::write(const APVTS& apvts, const SceneBank& sceneBank, juce::MemoryBlock& destData)
+{
+    juce::Array<juce::RangedAudioParameter*> params;
+
+    for (auto* param : apvts.processor.getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (param))
+            params.add(ranged);
+
+    destData.reset();
+    juce::MemoryOutputStream stream(destData, false);
+
+    stream.writeInt(magic);
+    stream.writeInt(currentVersion);
+    stream.writeCompressedInt(params.size());
+
+    for (auto* param : params)
+    {
+        stream.writeString(param->paramID);
+        stream.writeFloat(param->convertFrom0to1(param->getValue()));
+    }
+
+    stream.writeCompressedInt(SceneBank::numScenes);
+
+    for (int i = 0; i < SceneBank::numScenes; ++i)
+        SceneBank::writeScene(stream, sceneBank.getScene(i), sceneBank.getName(i));
+
+    stream.flush();
+}
+
+bool StateFormat::isBinaryState(const void* data, int sizeInBytes) noexcept
+{
+    return data != nullptr
+        && sizeInBytes >= static_cast<int>(2 * sizeof(int))
+        && juce::ByteOrder::littleEndianInt(data) == static_cast<juce::uint32>(magic);
+}
+
+bool StateFormat::read(APVTS& apvts, SceneBank& sceneBank, const void* data, int sizeInBytes)
+{
+    if (! isBinaryState(data, sizeInBytes))
+        return false;
+
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+
+    stream.readInt();
+
+    const auto version = stream.readInt();
+    const auto numEntries = stream.readCompressedInt();
+
+    if (version < 1 || version > currentVersion || numEntries < 0 || numEntries > stream.getNumBytesRemaining() / minimumEntrySize)
+        return false;
+
+    // Read everything before touching the tree, so a truncated state
+    // changes nothing.
+    std::vector<std::pair<juce::String, float>> entries;
+    entries.reserve(static_cast<size_t>(numEntries));
+
+    for (int i = 0; i < numEntries; ++i)
+    {
+        if (stream.getNumBytesRemaining() < minimumEntrySize)
+            return false;
+
+        auto id = stream.readString();
+
+        if (stream.getNumBytesRemaining() < static_cast<juce::int64>(sizeof(float)))
+            return false;
+
+        entries.emplace_back(std::move(id), stream.readFloat());
+    }
+
+    std::array<SceneBank::Values, SceneBank::numScenes> scenes;
+    std::array<juce::String, SceneBank::numScenes> names;
+    auto numScenes = 0;
+
+    if (version >= 2)
+    {
+        numScenes = stream.readCompressedInt();
+
+        if (numScenes < 0 || numScenes > SceneBank::numScenes)
+            return false;
+
+        for (int i = 0; i < numScenes; ++i)
+            if (! SceneBank::readScene(stream, apvts, scenes[static_cast<size_t>(i)], names[static_cast<size_t>(i)], version))
+                return false;
+    }
+
+    // Setting the tree's properties is exactly what replaceState() ends up
+    // doing for each parameter, without the undo history.
+    for (auto* param : apvts.processor.getParameters())
+    {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (param))
+        {
+            auto value = ranged->convertFrom0to1(ranged->getDefaultValue());
+
+            for (const auto& entry : entries)
+            {
+                if (entry.first == ranged->paramID && std::isfinite(entry.second))
+                {
+                    value = ranged->getNormalisableRange().snapToLegalValue(entry.second);
+                    break;
+                }
+            }
+
+            auto child = apvts.state.getChildWithProperty(idProperty, ranged->paramID);
+
+            if (child.isValid())
+                child.setProperty(valueProperty, value, nullptr);
+            else
+                ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+        }
+    }
+
+    for (int i = 0; i < numScenes; ++i)
+    {
+        sceneBank.store(i, scenes[static_cast<size_t>(i)]);
+        sceneBank.setName(i, names[static_cast<size_t>(i)]);
+    }
+
+    return true;
+}
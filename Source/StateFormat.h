@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    StateFormat.h
+    Created: 14 Oct 2026 9:31:04pm
+    Author:  Nathan J. Hood (StoneyDSP)
+    eMail: nathan@stoneydsp.com
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef STATEFORMAT_H_INCLUDED
+#define STATEFORMAT_H_INCLUDED
+
+#include <JuceHeader.h>
+#include "SceneBank.h"
+
+/**
+    Compact, versioned binary form of the plugin state.
+
+    The state is a header (magic number, format version and parameter count)
+    followed by each parameter's ID and its value in the parameter's own
+    units, written straight from the parameters and read straight back into
+    the state tree, so neither saving nor restoring builds or parses XML.
+    Values are matched by ID, so parameters may be added or reordered in
+    later versions; any parameter missing from the data returns to its
+    default, as with an XML state. From version 2 the scenes of the
+    SceneBank follow the parameters; older states leave them as they are.
+    Version 3 adds the peak bands to each scene.
+*/
+
+class StateFormat
+{
+public:
+    using APVTS = juce::AudioProcessorValueTreeState;
+
+    /** "BLEQ", little-endian. */
+    static constexpr int magic = 0x51454c42;
+
+    /** Incremented whenever the layout changes; older versions must still
+    read. */
+    static constexpr int currentVersion = 3;
+
+    //==============================================================================
+    /** Writes every parameter of the tree's processor and every scene to
+    destData, replacing its contents. */
+    static void write(const APVTS& apvts, const SceneBank& sceneBank, juce::MemoryBlock& destData);
+
+    /** Returns true if the data starts with the magic number, i.e. is in this
+    format rather than XML. */
+    static bool isBinaryState(const void* data, int sizeInBytes) noexcept;
+
+    /** Restores the parameters and scenes from data written by write().
+    Returns false, leaving everything untouched, if the data is not in this
+    format, is truncated or comes from a newer version. */
+    static bool read(APVTS& apvts, SceneBank& sceneBank, const void* data, int sizeInBytes);
+};
+
+#endif //STATEFORMAT_H_INCLUDED